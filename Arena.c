@@ -0,0 +1,77 @@
+/** @file Arena.c
+ * See Arena.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <sys/mman.h>
+#include "Arena.h"
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** All buffers are aligned on this amount of bytes (a cache line size). */
+#define ARENA_ALIGNMENT 64
+
+/** The usual huge page size on x86 and ARM. */
+#define ARENA_HUGE_PAGE_SIZE (2UL * 1024 * 1024)
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int ArenaCreate(TArena *Pointer_Arena, size_t Size)
+{
+	void *Pointer_Mapping = MAP_FAILED;
+	
+	Pointer_Arena->Used_Size = 0;
+	Pointer_Arena->Is_Using_Huge_Pages = 0;
+	
+	if (Size >= ARENA_HUGE_PAGE_SIZE)
+	{
+		// Huge pages mappings must be a whole amount of huge pages
+		Size = (Size + ARENA_HUGE_PAGE_SIZE - 1) & ~(ARENA_HUGE_PAGE_SIZE - 1);
+		
+		// Explicit huge pages are available only if the administrator reserved some
+		#ifdef MAP_HUGETLB
+			Pointer_Mapping = mmap(NULL, Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (Pointer_Mapping != MAP_FAILED) Pointer_Arena->Is_Using_Huge_Pages = 1;
+		#endif
+	}
+	
+	if (Pointer_Mapping == MAP_FAILED)
+	{
+		Pointer_Mapping = mmap(NULL, Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (Pointer_Mapping == MAP_FAILED) return -1;
+		
+		// Ask for transparent huge pages, this is only a hint so errors are ignored
+		#ifdef MADV_HUGEPAGE
+			if (Size >= ARENA_HUGE_PAGE_SIZE) madvise(Pointer_Mapping, Size, MADV_HUGEPAGE);
+		#endif
+	}
+	
+	Pointer_Arena->Pointer_Base = Pointer_Mapping;
+	Pointer_Arena->Size = Size;
+	return 0;
+}
+
+void ArenaDestroy(TArena *Pointer_Arena)
+{
+	if (Pointer_Arena->Pointer_Base != NULL) munmap(Pointer_Arena->Pointer_Base, Pointer_Arena->Size);
+	Pointer_Arena->Pointer_Base = NULL;
+	Pointer_Arena->Size = 0;
+	Pointer_Arena->Used_Size = 0;
+}
+
+void *ArenaAllocate(TArena *Pointer_Arena, size_t Size)
+{
+	size_t Start;
+	
+	Start = (Pointer_Arena->Used_Size + ARENA_ALIGNMENT - 1) & ~((size_t) ARENA_ALIGNMENT - 1);
+	if ((Start > Pointer_Arena->Size) || (Size > Pointer_Arena->Size - Start)) return NULL;
+	
+	Pointer_Arena->Used_Size = Start + Size;
+	return Pointer_Arena->Pointer_Base + Start;
+}
+
+void ArenaReset(TArena *Pointer_Arena, size_t Used_Size)
+{
+	if (Used_Size < Pointer_Arena->Used_Size) Pointer_Arena->Used_Size = Used_Size;
+}
@@ -0,0 +1,52 @@
+/** @file Arena.h
+ * A linear memory allocator : buffers are carved from a single mapping and all released at once, which avoids the heap fragmentation and lets big mappings use huge pages.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_ARENA_H
+#define H_ARENA_H
+
+#include <stddef.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** An arena. */
+typedef struct
+{
+	unsigned char *Pointer_Base; //!< The mapping start address.
+	size_t Size; //!< The mapping size in bytes.
+	size_t Used_Size; //!< How many bytes are allocated.
+	int Is_Using_Huge_Pages; //!< Set to 1 when the mapping is backed by explicit huge pages.
+} TArena;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Map the arena memory. Mappings of at least one huge page size try explicit huge pages first, then fall back to regular pages with transparent huge pages enabled.
+ * @param Pointer_Arena The arena to initialize.
+ * @param Size How many bytes the arena can provide.
+ * @return 0 on success,
+ * @return -1 if the memory could not be mapped.
+ */
+int ArenaCreate(TArena *Pointer_Arena, size_t Size);
+
+/** Unmap the arena memory, all buffers allocated from the arena become invalid.
+ * @param Pointer_Arena The arena.
+ */
+void ArenaDestroy(TArena *Pointer_Arena);
+
+/** Allocate a buffer aligned on a cache line.
+ * @param Pointer_Arena The arena.
+ * @param Size The buffer size in bytes.
+ * @return The buffer address,
+ * @return NULL if there is not enough room left in the arena.
+ */
+void *ArenaAllocate(TArena *Pointer_Arena, size_t Size);
+
+/** Release all buffers allocated after a specific point, so the arena memory can be reused by the next job without faulting new pages.
+ * @param Pointer_Arena The arena.
+ * @param Used_Size The value of the arena Used_Size field at the point to go back to (set 0 to release all buffers).
+ */
+void ArenaReset(TArena *Pointer_Arena, size_t Used_Size);
+
+#endif
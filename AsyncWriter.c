@@ -0,0 +1,626 @@
+/** @file AsyncWriter.c
+ * See AsyncWriter.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "AsyncWriter.h"
+#include "Trace.h"
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** How many written files are synchronized at once. */
+#define ASYNC_WRITER_SYNCHRONIZATION_BATCH_SIZE 32
+
+/** The io_uring submission queue size, it must hold a whole batch of synchronizations. */
+#define ASYNC_WRITER_RING_ENTRIES_COUNT 128
+
+/** How many threads write the files when io_uring is not available. */
+#define ASYNC_WRITER_THREADS_COUNT 4
+
+/** How many io_uring synchronizations can be in progress, the files written when all are in use are synchronized right away. With the buffers writes, this keeps the requests in flight below the completion queue size. */
+#define ASYNC_WRITER_MAXIMUM_PENDING_SYNCHRONIZATIONS_COUNT (ASYNC_WRITER_RING_ENTRIES_COUNT - ASYNC_WRITER_MAXIMUM_BUFFERS_COUNT)
+
+/** Tell that an io_uring completion belongs to a synchronization request (the remaining bits are the synchronization slot index), instead of a buffer write (the user data is the buffer index). */
+#define ASYNC_WRITER_USER_DATA_SYNCHRONIZATION_FLAG (1ULL << 63)
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** The io_uring rings mapped in memory. */
+typedef struct
+{
+	int File_Descriptor; //!< The ring file descriptor.
+	void *Pointer_Submission_Ring; //!< The submission ring mapping.
+	size_t Submission_Ring_Size; //!< The submission ring mapping size.
+	void *Pointer_Completion_Ring; //!< The completion ring mapping (it can be the same as the submission ring).
+	size_t Completion_Ring_Size; //!< The completion ring mapping size.
+	struct io_uring_sqe *Pointer_Submission_Entries; //!< The submission queue entries.
+	size_t Submission_Entries_Size; //!< The submission queue entries mapping size.
+	unsigned int *Pointer_Submission_Head; //!< The first submission entry not consumed by the kernel.
+	unsigned int *Pointer_Submission_Tail; //!< The next free submission entry.
+	unsigned int *Pointer_Submission_Mask; //!< The submission ring index mask.
+	unsigned int *Pointer_Submission_Array; //!< The submission ring, containing entries indexes.
+	unsigned int *Pointer_Completion_Head; //!< The first completion not consumed by the program.
+	unsigned int *Pointer_Completion_Tail; //!< The next completion slot the kernel will write to.
+	unsigned int *Pointer_Completion_Mask; //!< The completion ring index mask.
+	struct io_uring_cqe *Pointer_Completion_Entries; //!< The completion queue entries.
+	unsigned int Pending_Submissions_Count; //!< How many entries were queued but not submitted yet.
+} TAsyncWriterRing;
+
+/** A file write waiting for a thread of the threads pool. */
+typedef struct
+{
+	int File_Descriptor; //!< The file to write to.
+	int Buffer_Index; //!< The buffer to write.
+	size_t Size; //!< How many bytes to write.
+} TAsyncWriterJob;
+
+//-------------------------------------------------------------------------------------------------
+// Private variables
+//-------------------------------------------------------------------------------------------------
+/** Set to 1 when io_uring is used. */
+static int Async_Writer_Is_Using_IO_Uring;
+/** The io_uring state. */
+static TAsyncWriterRing Async_Writer_Ring;
+
+/** All buffers, in a single mapping. */
+static unsigned char *Pointer_Async_Writer_Buffers;
+/** The size of a single buffer. */
+static size_t Async_Writer_Buffer_Size;
+/** How many buffers there are. */
+static unsigned int Async_Writer_Buffers_Count;
+/** The buffers that can be filled. */
+static int Async_Writer_Free_Buffer_Indexes[ASYNC_WRITER_MAXIMUM_BUFFERS_COUNT];
+/** How many buffers can be filled. */
+static unsigned int Async_Writer_Free_Buffers_Count;
+/** The file each buffer is being written to. */
+static int Async_Writer_Buffer_File_Descriptors[ASYNC_WRITER_MAXIMUM_BUFFERS_COUNT];
+/** The expected size of each buffer write. */
+static size_t Async_Writer_Buffer_Write_Sizes[ASYNC_WRITER_MAXIMUM_BUFFERS_COUNT];
+
+/** The written files waiting to be synchronized. */
+static int Async_Writer_Written_File_Descriptors[ASYNC_WRITER_SYNCHRONIZATION_BATCH_SIZE];
+/** How many written files are waiting to be synchronized. */
+static unsigned int Async_Writer_Written_Files_Count;
+/** The files being synchronized by io_uring, a free slot contains -1. */
+static int Async_Writer_Synchronized_File_Descriptors[ASYNC_WRITER_MAXIMUM_PENDING_SYNCHRONIZATIONS_COUNT];
+/** How many synchronizations are in progress. */
+static unsigned int Async_Writer_Pending_Synchronizations_Count;
+
+/** Set to 1 when any operation failed. */
+static int Async_Writer_Is_Error;
+
+/** The threads pool threads. */
+static pthread_t Async_Writer_Threads[ASYNC_WRITER_THREADS_COUNT];
+/** How many threads were started. */
+static int Async_Writer_Threads_Count;
+/** Protect all the threads pool shared variables. */
+static pthread_mutex_t Async_Writer_Mutex = PTHREAD_MUTEX_INITIALIZER;
+/** Signaled when a job is queued or when the pool must stop. */
+static pthread_cond_t Async_Writer_Job_Condition = PTHREAD_COND_INITIALIZER;
+/** Signaled when a buffer is released. */
+static pthread_cond_t Async_Writer_Buffer_Condition = PTHREAD_COND_INITIALIZER;
+/** The jobs queue (there can't be more jobs than buffers). */
+static TAsyncWriterJob Async_Writer_Jobs[ASYNC_WRITER_MAXIMUM_BUFFERS_COUNT];
+/** The next job to process. */
+static unsigned int Async_Writer_Jobs_Head;
+/** How many jobs are queued. */
+static unsigned int Async_Writer_Jobs_Count;
+/** Set to 1 to make the threads exit. */
+static int Async_Writer_Is_Stop_Requested;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Synchronize files to the storage, then close them (used by the threads pool backend, and by io_uring when all synchronization slots are in use).
+ * @param Pointer_File_Descriptors The files to synchronize.
+ * @param Count How many files there are.
+ * @return 0 on success,
+ * @return -1 if a file could not be synchronized or closed.
+ */
+static int AsyncWriterSynchronizeFiles(const int *Pointer_File_Descriptors, unsigned int Count)
+{
+	unsigned int i;
+	int Result = 0;
+	
+	for (i = 0; i < Count; i++)
+	{
+		if (fsync(Pointer_File_Descriptors[i]) != 0) Result = -1;
+		if (close(Pointer_File_Descriptors[i]) != 0) Result = -1;
+	}
+	return Result;
+}
+
+/** A threads pool thread, writing the queued buffers.
+ * @param Pointer_Parameter Unused.
+ * @return Always NULL.
+ */
+static void *AsyncWriterThread(void *Pointer_Parameter)
+{
+	TAsyncWriterJob Job;
+	int File_Descriptors[ASYNC_WRITER_SYNCHRONIZATION_BATCH_SIZE], Is_Error;
+	unsigned int Files_Count;
+	size_t Written_Size;
+	ssize_t Result;
+	unsigned long long Trace_Start_Time;
+	
+	(void) Pointer_Parameter;
+	
+	TraceNameThread("Tables writer");
+	
+	pthread_mutex_lock(&Async_Writer_Mutex);
+	while (1)
+	{
+		// Wait for a job
+		Trace_Start_Time = TraceGetTime();
+		while ((Async_Writer_Jobs_Count == 0) && !Async_Writer_Is_Stop_Requested) pthread_cond_wait(&Async_Writer_Job_Condition, &Async_Writer_Mutex);
+		TraceRecordSpan(TRACE_SPAN_WAIT, Trace_Start_Time);
+		if (Async_Writer_Jobs_Count == 0) break; // Stop only when all jobs are done
+		Job = Async_Writer_Jobs[Async_Writer_Jobs_Head];
+		Async_Writer_Jobs_Head = (Async_Writer_Jobs_Head + 1) % ASYNC_WRITER_MAXIMUM_BUFFERS_COUNT;
+		Async_Writer_Jobs_Count--;
+		pthread_mutex_unlock(&Async_Writer_Mutex);
+		
+		// Write the whole buffer
+		Trace_Start_Time = TraceGetTime();
+		Is_Error = 0;
+		Written_Size = 0;
+		while (Written_Size < Job.Size)
+		{
+			Result = pwrite(Job.File_Descriptor, Pointer_Async_Writer_Buffers + (size_t) Job.Buffer_Index * Async_Writer_Buffer_Size + Written_Size, Job.Size - Written_Size, (off_t) Written_Size);
+			if (Result <= 0)
+			{
+				Is_Error = 1;
+				break;
+			}
+			Written_Size += (size_t) Result;
+		}
+		TraceRecordSpan(TRACE_SPAN_WRITE, Trace_Start_Time);
+		
+		pthread_mutex_lock(&Async_Writer_Mutex);
+		if (Is_Error) Async_Writer_Is_Error = 1;
+		
+		// Recycle the buffer right away
+		Async_Writer_Free_Buffer_Indexes[Async_Writer_Free_Buffers_Count] = Job.Buffer_Index;
+		Async_Writer_Free_Buffers_Count++;
+		pthread_cond_signal(&Async_Writer_Buffer_Condition);
+		
+		// Synchronize the written files when a whole batch is ready
+		Async_Writer_Written_File_Descriptors[Async_Writer_Written_Files_Count] = Job.File_Descriptor;
+		Async_Writer_Written_Files_Count++;
+		if (Async_Writer_Written_Files_Count == ASYNC_WRITER_SYNCHRONIZATION_BATCH_SIZE)
+		{
+			Files_Count = Async_Writer_Written_Files_Count;
+			memcpy(File_Descriptors, Async_Writer_Written_File_Descriptors, Files_Count * sizeof(int));
+			Async_Writer_Written_Files_Count = 0;
+			pthread_mutex_unlock(&Async_Writer_Mutex);
+			
+			Trace_Start_Time = TraceGetTime();
+			Is_Error = AsyncWriterSynchronizeFiles(File_Descriptors, Files_Count);
+			TraceRecordSpan(TRACE_SPAN_WRITE, Trace_Start_Time);
+			
+			pthread_mutex_lock(&Async_Writer_Mutex);
+			if (Is_Error) Async_Writer_Is_Error = 1;
+		}
+	}
+	pthread_mutex_unlock(&Async_Writer_Mutex);
+	
+	return NULL;
+}
+
+/** Create the io_uring instance and map its rings.
+ * @return 0 on success,
+ * @return -1 if io_uring is not available.
+ */
+static int AsyncWriterCreateRing(void)
+{
+	struct io_uring_params Parameters;
+	struct iovec Buffers_Vectors[ASYNC_WRITER_MAXIMUM_BUFFERS_COUNT];
+	TAsyncWriterRing *Pointer_Ring = &Async_Writer_Ring;
+	unsigned char *Pointer_Submission_Ring, *Pointer_Completion_Ring;
+	unsigned int i;
+	long Result;
+	
+	memset(&Parameters, 0, sizeof(Parameters));
+	Result = syscall(__NR_io_uring_setup, ASYNC_WRITER_RING_ENTRIES_COUNT, &Parameters);
+	if (Result < 0) return -1;
+	Pointer_Ring->File_Descriptor = (int) Result;
+	
+	// Map the rings, they share the same mapping on recent kernels
+	Pointer_Ring->Submission_Ring_Size = Parameters.sq_off.array + Parameters.sq_entries * sizeof(unsigned int);
+	Pointer_Ring->Completion_Ring_Size = Parameters.cq_off.cqes + Parameters.cq_entries * sizeof(struct io_uring_cqe);
+	if (Parameters.features & IORING_FEAT_SINGLE_MMAP)
+	{
+		if (Pointer_Ring->Completion_Ring_Size > Pointer_Ring->Submission_Ring_Size) Pointer_Ring->Submission_Ring_Size = Pointer_Ring->Completion_Ring_Size;
+		Pointer_Ring->Completion_Ring_Size = Pointer_Ring->Submission_Ring_Size;
+	}
+	Pointer_Ring->Pointer_Submission_Ring = mmap(NULL, Pointer_Ring->Submission_Ring_Size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, Pointer_Ring->File_Descriptor, IORING_OFF_SQ_RING);
+	if (Pointer_Ring->Pointer_Submission_Ring == MAP_FAILED) goto Exit_Close_Ring;
+	if (Parameters.features & IORING_FEAT_SINGLE_MMAP) Pointer_Ring->Pointer_Completion_Ring = Pointer_Ring->Pointer_Submission_Ring;
+	else
+	{
+		Pointer_Ring->Pointer_Completion_Ring = mmap(NULL, Pointer_Ring->Completion_Ring_Size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, Pointer_Ring->File_Descriptor, IORING_OFF_CQ_RING);
+		if (Pointer_Ring->Pointer_Completion_Ring == MAP_FAILED) goto Exit_Unmap_Submission_Ring;
+	}
+	Pointer_Ring->Submission_Entries_Size = Parameters.sq_entries * sizeof(struct io_uring_sqe);
+	Pointer_Ring->Pointer_Submission_Entries = mmap(NULL, Pointer_Ring->Submission_Entries_Size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, Pointer_Ring->File_Descriptor, IORING_OFF_SQES);
+	if (Pointer_Ring->Pointer_Submission_Entries == MAP_FAILED) goto Exit_Unmap_Completion_Ring;
+	
+	Pointer_Submission_Ring = Pointer_Ring->Pointer_Submission_Ring;
+	Pointer_Ring->Pointer_Submission_Head = (unsigned int *) (Pointer_Submission_Ring + Parameters.sq_off.head);
+	Pointer_Ring->Pointer_Submission_Tail = (unsigned int *) (Pointer_Submission_Ring + Parameters.sq_off.tail);
+	Pointer_Ring->Pointer_Submission_Mask = (unsigned int *) (Pointer_Submission_Ring + Parameters.sq_off.ring_mask);
+	Pointer_Ring->Pointer_Submission_Array = (unsigned int *) (Pointer_Submission_Ring + Parameters.sq_off.array);
+	Pointer_Completion_Ring = Pointer_Ring->Pointer_Completion_Ring;
+	Pointer_Ring->Pointer_Completion_Head = (unsigned int *) (Pointer_Completion_Ring + Parameters.cq_off.head);
+	Pointer_Ring->Pointer_Completion_Tail = (unsigned int *) (Pointer_Completion_Ring + Parameters.cq_off.tail);
+	Pointer_Ring->Pointer_Completion_Mask = (unsigned int *) (Pointer_Completion_Ring + Parameters.cq_off.ring_mask);
+	Pointer_Ring->Pointer_Completion_Entries = (struct io_uring_cqe *) (Pointer_Completion_Ring + Parameters.cq_off.cqes);
+	Pointer_Ring->Pending_Submissions_Count = 0;
+	
+	// Register the buffers, so the kernel does not need to map them for each write
+	for (i = 0; i < Async_Writer_Buffers_Count; i++)
+	{
+		Buffers_Vectors[i].iov_base = Pointer_Async_Writer_Buffers + i * Async_Writer_Buffer_Size;
+		Buffers_Vectors[i].iov_len = Async_Writer_Buffer_Size;
+	}
+	if (syscall(__NR_io_uring_register, Pointer_Ring->File_Descriptor, IORING_REGISTER_BUFFERS, Buffers_Vectors, Async_Writer_Buffers_Count) < 0) goto Exit_Unmap_Submission_Entries;
+	
+	return 0;
+	
+Exit_Unmap_Submission_Entries:
+	munmap(Pointer_Ring->Pointer_Submission_Entries, Pointer_Ring->Submission_Entries_Size);
+Exit_Unmap_Completion_Ring:
+	if (Pointer_Ring->Pointer_Completion_Ring != Pointer_Ring->Pointer_Submission_Ring) munmap(Pointer_Ring->Pointer_Completion_Ring, Pointer_Ring->Completion_Ring_Size);
+Exit_Unmap_Submission_Ring:
+	munmap(Pointer_Ring->Pointer_Submission_Ring, Pointer_Ring->Submission_Ring_Size);
+Exit_Close_Ring:
+	close(Pointer_Ring->File_Descriptor);
+	return -1;
+}
+
+/** Release the io_uring resources. */
+static void AsyncWriterDestroyRing(void)
+{
+	TAsyncWriterRing *Pointer_Ring = &Async_Writer_Ring;
+	
+	munmap(Pointer_Ring->Pointer_Submission_Entries, Pointer_Ring->Submission_Entries_Size);
+	if (Pointer_Ring->Pointer_Completion_Ring != Pointer_Ring->Pointer_Submission_Ring) munmap(Pointer_Ring->Pointer_Completion_Ring, Pointer_Ring->Completion_Ring_Size);
+	munmap(Pointer_Ring->Pointer_Submission_Ring, Pointer_Ring->Submission_Ring_Size);
+	close(Pointer_Ring->File_Descriptor);
+}
+
+/** Get the next free submission queue entry. The submission queue is big enough for all buffers writes and a synchronization batch, so there is always a free entry.
+ * @return The entry, cleared.
+ */
+static struct io_uring_sqe *AsyncWriterGetSubmissionEntry(void)
+{
+	TAsyncWriterRing *Pointer_Ring = &Async_Writer_Ring;
+	unsigned int Tail, Index;
+	struct io_uring_sqe *Pointer_Entry;
+	
+	Tail = *Pointer_Ring->Pointer_Submission_Tail + Pointer_Ring->Pending_Submissions_Count;
+	Index = Tail & *Pointer_Ring->Pointer_Submission_Mask;
+	Pointer_Entry = &Pointer_Ring->Pointer_Submission_Entries[Index];
+	memset(Pointer_Entry, 0, sizeof(*Pointer_Entry));
+	Pointer_Ring->Pointer_Submission_Array[Index] = Index;
+	Pointer_Ring->Pending_Submissions_Count++;
+	
+	return Pointer_Entry;
+}
+
+/** Give the queued entries to the kernel, and optionally wait for completions.
+ * @param Minimum_Completions_Count How many completions to wait for (0 to only submit).
+ * @return 0 on success,
+ * @return -1 if the kernel refused the entries.
+ */
+static int AsyncWriterSubmitEntries(unsigned int Minimum_Completions_Count)
+{
+	TAsyncWriterRing *Pointer_Ring = &Async_Writer_Ring;
+	unsigned int Submissions_Count = Pointer_Ring->Pending_Submissions_Count;
+	long Result;
+	
+	// Publish the entries before the kernel can see the new tail
+	__atomic_store_n(Pointer_Ring->Pointer_Submission_Tail, *Pointer_Ring->Pointer_Submission_Tail + Submissions_Count, __ATOMIC_RELEASE);
+	Pointer_Ring->Pending_Submissions_Count = 0;
+	
+	do
+	{
+		Result = syscall(__NR_io_uring_enter, Pointer_Ring->File_Descriptor, Submissions_Count, Minimum_Completions_Count, Minimum_Completions_Count > 0 ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+	} while ((Result < 0) && (errno == EINTR));
+	
+	return Result < 0 ? -1 : 0;
+}
+
+/** Queue the synchronization of all written files. */
+static void AsyncWriterQueueSynchronizations(void)
+{
+	struct io_uring_sqe *Pointer_Entry;
+	unsigned int i, Slot_Index = 0;
+	
+	for (i = 0; i < Async_Writer_Written_Files_Count; i++)
+	{
+		// Remember the file in a free slot, so it can be closed whatever happens to the request
+		while ((Slot_Index < ASYNC_WRITER_MAXIMUM_PENDING_SYNCHRONIZATIONS_COUNT) && (Async_Writer_Synchronized_File_Descriptors[Slot_Index] >= 0)) Slot_Index++;
+		if (Slot_Index == ASYNC_WRITER_MAXIMUM_PENDING_SYNCHRONIZATIONS_COUNT)
+		{
+			if (AsyncWriterSynchronizeFiles(&Async_Writer_Written_File_Descriptors[i], 1) != 0) Async_Writer_Is_Error = 1;
+			continue;
+		}
+		Async_Writer_Synchronized_File_Descriptors[Slot_Index] = Async_Writer_Written_File_Descriptors[i];
+		
+		Pointer_Entry = AsyncWriterGetSubmissionEntry();
+		Pointer_Entry->opcode = IORING_OP_FSYNC;
+		Pointer_Entry->fd = Async_Writer_Written_File_Descriptors[i];
+		Pointer_Entry->user_data = ASYNC_WRITER_USER_DATA_SYNCHRONIZATION_FLAG | Slot_Index;
+		Async_Writer_Pending_Synchronizations_Count++;
+	}
+	Async_Writer_Written_Files_Count = 0;
+}
+
+/** Close the files of the io_uring requests that did not complete, once the ring is destroyed. */
+static void AsyncWriterCloseRemainingFiles(void)
+{
+	int Is_Buffer_Free[ASYNC_WRITER_MAXIMUM_BUFFERS_COUNT] = { 0 };
+	unsigned int i;
+	
+	// The buffers that are not free are still being written
+	for (i = 0; i < Async_Writer_Free_Buffers_Count; i++) Is_Buffer_Free[Async_Writer_Free_Buffer_Indexes[i]] = 1;
+	for (i = 0; i < Async_Writer_Buffers_Count; i++)
+	{
+		if (!Is_Buffer_Free[i]) close(Async_Writer_Buffer_File_Descriptors[i]);
+	}
+	
+	for (i = 0; i < ASYNC_WRITER_MAXIMUM_PENDING_SYNCHRONIZATIONS_COUNT; i++)
+	{
+		if (Async_Writer_Synchronized_File_Descriptors[i] >= 0) close(Async_Writer_Synchronized_File_Descriptors[i]);
+	}
+	for (i = 0; i < Async_Writer_Written_Files_Count; i++) close(Async_Writer_Written_File_Descriptors[i]);
+}
+
+/** Process all available io_uring completions : recycle the written buffers, queue the synchronization batches and close the synchronized files. */
+static void AsyncWriterProcessCompletions(void)
+{
+	TAsyncWriterRing *Pointer_Ring = &Async_Writer_Ring;
+	unsigned int Head, Tail;
+	struct io_uring_cqe *Pointer_Completion;
+	int Buffer_Index, Slot_Index;
+	
+	Head = *Pointer_Ring->Pointer_Completion_Head;
+	Tail = __atomic_load_n(Pointer_Ring->Pointer_Completion_Tail, __ATOMIC_ACQUIRE);
+	while (Head != Tail)
+	{
+		Pointer_Completion = &Pointer_Ring->Pointer_Completion_Entries[Head & *Pointer_Ring->Pointer_Completion_Mask];
+		
+		// A file is synchronized, it can be closed
+		if (Pointer_Completion->user_data & ASYNC_WRITER_USER_DATA_SYNCHRONIZATION_FLAG)
+		{
+			Slot_Index = (int) (Pointer_Completion->user_data & ~ASYNC_WRITER_USER_DATA_SYNCHRONIZATION_FLAG);
+			if (Pointer_Completion->res < 0) Async_Writer_Is_Error = 1;
+			if (close(Async_Writer_Synchronized_File_Descriptors[Slot_Index]) != 0) Async_Writer_Is_Error = 1;
+			Async_Writer_Synchronized_File_Descriptors[Slot_Index] = -1;
+			Async_Writer_Pending_Synchronizations_Count--;
+		}
+		// A buffer is written, recycle it
+		else
+		{
+			Buffer_Index = (int) Pointer_Completion->user_data;
+			if ((Pointer_Completion->res < 0) || ((size_t) Pointer_Completion->res != Async_Writer_Buffer_Write_Sizes[Buffer_Index])) Async_Writer_Is_Error = 1;
+			Async_Writer_Free_Buffer_Indexes[Async_Writer_Free_Buffers_Count] = Buffer_Index;
+			Async_Writer_Free_Buffers_Count++;
+			
+			Async_Writer_Written_File_Descriptors[Async_Writer_Written_Files_Count] = Async_Writer_Buffer_File_Descriptors[Buffer_Index];
+			Async_Writer_Written_Files_Count++;
+			if (Async_Writer_Written_Files_Count == ASYNC_WRITER_SYNCHRONIZATION_BATCH_SIZE) AsyncWriterQueueSynchronizations();
+		}
+		Head++;
+	}
+	__atomic_store_n(Pointer_Ring->Pointer_Completion_Head, Head, __ATOMIC_RELEASE);
+	
+	// Submit the synchronizations that may have been queued
+	if (Async_Writer_Ring.Pending_Submissions_Count > 0)
+	{
+		if (AsyncWriterSubmitEntries(0) != 0) Async_Writer_Is_Error = 1;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int AsyncWriterInitialize(unsigned int Buffers_Count, size_t Buffer_Size)
+{
+	unsigned int i;
+	
+	if ((Buffers_Count == 0) || (Buffers_Count > ASYNC_WRITER_MAXIMUM_BUFFERS_COUNT) || (Buffer_Size == 0)) return -1;
+	
+	// Keep the buffers page-aligned, which suits direct and registered I/O
+	Pointer_Async_Writer_Buffers = mmap(NULL, Buffers_Count * Buffer_Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (Pointer_Async_Writer_Buffers == MAP_FAILED) return -1;
+	Async_Writer_Buffers_Count = Buffers_Count;
+	Async_Writer_Buffer_Size = Buffer_Size;
+	for (i = 0; i < Buffers_Count; i++) Async_Writer_Free_Buffer_Indexes[i] = (int) i;
+	Async_Writer_Free_Buffers_Count = Buffers_Count;
+	Async_Writer_Written_Files_Count = 0;
+	Async_Writer_Pending_Synchronizations_Count = 0;
+	for (i = 0; i < ASYNC_WRITER_MAXIMUM_PENDING_SYNCHRONIZATIONS_COUNT; i++) Async_Writer_Synchronized_File_Descriptors[i] = -1;
+	Async_Writer_Is_Error = 0;
+	
+	// Prefer io_uring, fall back to the threads pool
+	if (AsyncWriterCreateRing() == 0)
+	{
+		Async_Writer_Is_Using_IO_Uring = 1;
+		return 0;
+	}
+	
+	Async_Writer_Is_Using_IO_Uring = 0;
+	Async_Writer_Jobs_Head = 0;
+	Async_Writer_Jobs_Count = 0;
+	Async_Writer_Is_Stop_Requested = 0;
+	for (Async_Writer_Threads_Count = 0; Async_Writer_Threads_Count < ASYNC_WRITER_THREADS_COUNT; Async_Writer_Threads_Count++)
+	{
+		if (pthread_create(&Async_Writer_Threads[Async_Writer_Threads_Count], NULL, AsyncWriterThread, NULL) != 0) break;
+	}
+	if (Async_Writer_Threads_Count == 0)
+	{
+		munmap(Pointer_Async_Writer_Buffers, Buffers_Count * Buffer_Size);
+		return -1;
+	}
+	return 0;
+}
+
+int AsyncWriterGetBuffer(void)
+{
+	int Buffer_Index;
+	
+	if (Async_Writer_Is_Using_IO_Uring)
+	{
+		// Wait for a write completion if all buffers are in use
+		while (Async_Writer_Free_Buffers_Count == 0)
+		{
+			if (AsyncWriterSubmitEntries(1) != 0) return -1;
+			AsyncWriterProcessCompletions();
+		}
+		if (Async_Writer_Is_Error) return -1;
+		Async_Writer_Free_Buffers_Count--;
+		return Async_Writer_Free_Buffer_Indexes[Async_Writer_Free_Buffers_Count];
+	}
+	
+	pthread_mutex_lock(&Async_Writer_Mutex);
+	while ((Async_Writer_Free_Buffers_Count == 0) && !Async_Writer_Is_Error) pthread_cond_wait(&Async_Writer_Buffer_Condition, &Async_Writer_Mutex);
+	if (Async_Writer_Is_Error) Buffer_Index = -1;
+	else
+	{
+		Async_Writer_Free_Buffers_Count--;
+		Buffer_Index = Async_Writer_Free_Buffer_Indexes[Async_Writer_Free_Buffers_Count];
+	}
+	pthread_mutex_unlock(&Async_Writer_Mutex);
+	
+	return Buffer_Index;
+}
+
+void *AsyncWriterGetBufferAddress(int Buffer_Index)
+{
+	return Pointer_Async_Writer_Buffers + (size_t) Buffer_Index * Async_Writer_Buffer_Size;
+}
+
+int AsyncWriterSubmit(const char *Pointer_String_File_Name, int Buffer_Index, size_t Size)
+{
+	struct io_uring_sqe *Pointer_Entry;
+	int File_Descriptor, Is_Error;
+	
+	File_Descriptor = open(Pointer_String_File_Name, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (File_Descriptor < 0)
+	{
+		// Give the buffer back, so the pending writes can still be waited for
+		pthread_mutex_lock(&Async_Writer_Mutex);
+		Async_Writer_Free_Buffer_Indexes[Async_Writer_Free_Buffers_Count] = Buffer_Index;
+		Async_Writer_Free_Buffers_Count++;
+		pthread_mutex_unlock(&Async_Writer_Mutex);
+		return -1;
+	}
+	
+	if (Async_Writer_Is_Using_IO_Uring)
+	{
+		Async_Writer_Buffer_File_Descriptors[Buffer_Index] = File_Descriptor;
+		Async_Writer_Buffer_Write_Sizes[Buffer_Index] = Size;
+		
+		Pointer_Entry = AsyncWriterGetSubmissionEntry();
+		Pointer_Entry->opcode = IORING_OP_WRITE_FIXED;
+		Pointer_Entry->fd = File_Descriptor;
+		Pointer_Entry->addr = (unsigned long) AsyncWriterGetBufferAddress(Buffer_Index);
+		Pointer_Entry->len = (unsigned int) Size;
+		Pointer_Entry->off = 0;
+		Pointer_Entry->buf_index = (unsigned short) Buffer_Index;
+		Pointer_Entry->user_data = (unsigned long long) Buffer_Index;
+		if (AsyncWriterSubmitEntries(0) != 0) return -1;
+		
+		// Recycle the buffers that are already written without waiting
+		AsyncWriterProcessCompletions();
+		return Async_Writer_Is_Error ? -1 : 0;
+	}
+	
+	pthread_mutex_lock(&Async_Writer_Mutex);
+	Async_Writer_Jobs[(Async_Writer_Jobs_Head + Async_Writer_Jobs_Count) % ASYNC_WRITER_MAXIMUM_BUFFERS_COUNT].File_Descriptor = File_Descriptor;
+	Async_Writer_Jobs[(Async_Writer_Jobs_Head + Async_Writer_Jobs_Count) % ASYNC_WRITER_MAXIMUM_BUFFERS_COUNT].Buffer_Index = Buffer_Index;
+	Async_Writer_Jobs[(Async_Writer_Jobs_Head + Async_Writer_Jobs_Count) % ASYNC_WRITER_MAXIMUM_BUFFERS_COUNT].Size = Size;
+	Async_Writer_Jobs_Count++;
+	pthread_cond_signal(&Async_Writer_Job_Condition);
+	Is_Error = Async_Writer_Is_Error; // The pool threads set it
+	pthread_mutex_unlock(&Async_Writer_Mutex);
+	
+	return Is_Error ? -1 : 0;
+}
+
+int AsyncWriterFinish(void)
+{
+	int i, Is_Ring_Working;
+	
+	if (Async_Writer_Is_Using_IO_Uring)
+	{
+		// Wait for all writes, even after a failed one, so no request is in flight when the buffers are unmapped
+		Is_Ring_Working = 1;
+		while (Async_Writer_Free_Buffers_Count < Async_Writer_Buffers_Count)
+		{
+			if (AsyncWriterSubmitEntries(1) != 0)
+			{
+				Is_Ring_Working = 0;
+				break;
+			}
+			AsyncWriterProcessCompletions();
+		}
+		
+		// Synchronize the last files, then wait for all synchronizations
+		if (Is_Ring_Working && (Async_Writer_Written_Files_Count > 0))
+		{
+			AsyncWriterQueueSynchronizations();
+			if (AsyncWriterSubmitEntries(0) != 0) Is_Ring_Working = 0;
+		}
+		while (Is_Ring_Working && (Async_Writer_Pending_Synchronizations_Count > 0))
+		{
+			if (AsyncWriterSubmitEntries(1) != 0)
+			{
+				Is_Ring_Working = 0;
+				break;
+			}
+			AsyncWriterProcessCompletions();
+		}
+		
+		// The ring destruction cancels the requests that could not be waited for, their files are still open
+		AsyncWriterDestroyRing();
+		if (!Is_Ring_Working)
+		{
+			Async_Writer_Is_Error = 1;
+			AsyncWriterCloseRemainingFiles();
+		}
+	}
+	else
+	{
+		// Let the threads process the remaining jobs, then stop them
+		pthread_mutex_lock(&Async_Writer_Mutex);
+		Async_Writer_Is_Stop_Requested = 1;
+		pthread_cond_broadcast(&Async_Writer_Job_Condition);
+		pthread_mutex_unlock(&Async_Writer_Mutex);
+		for (i = 0; i < Async_Writer_Threads_Count; i++) pthread_join(Async_Writer_Threads[i], NULL);
+		
+		if (AsyncWriterSynchronizeFiles(Async_Writer_Written_File_Descriptors, Async_Writer_Written_Files_Count) != 0) Async_Writer_Is_Error = 1;
+		Async_Writer_Written_Files_Count = 0;
+	}
+	
+	munmap(Pointer_Async_Writer_Buffers, Async_Writer_Buffers_Count * Async_Writer_Buffer_Size);
+	return Async_Writer_Is_Error ? -1 : 0;
+}
+
+int AsyncWriterIsUsingIOUring(void)
+{
+	return Async_Writer_Is_Using_IO_Uring;
+}
@@ -0,0 +1,60 @@
+/** @file AsyncWriter.h
+ * Write many files asynchronously from a pool of recycled buffers. The writes go through io_uring when the kernel provides it, or through a threads pool otherwise.
+ * The written files are synchronized to the storage by batches, then closed.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_ASYNC_WRITER_H
+#define H_ASYNC_WRITER_H
+
+#include <stddef.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** The biggest amount of buffers the writer can use. */
+#define ASYNC_WRITER_MAXIMUM_BUFFERS_COUNT 64
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Allocate the buffers and start the asynchronous writing backend.
+ * @param Buffers_Count How many buffers can be filled while the previous ones are being written (up to ASYNC_WRITER_MAXIMUM_BUFFERS_COUNT).
+ * @param Buffer_Size Each buffer size in bytes, this is the biggest file size that can be written.
+ * @return 0 on success,
+ * @return -1 if an error occurred.
+ */
+int AsyncWriterInitialize(unsigned int Buffers_Count, size_t Buffer_Size);
+
+/** Get a free buffer to fill, wait for a write completion if all buffers are in use.
+ * @return The buffer index, use AsyncWriterGetBufferAddress() to access it,
+ * @return -1 if a previous write failed.
+ */
+int AsyncWriterGetBuffer(void);
+
+/** Get a buffer address.
+ * @param Buffer_Index The buffer index returned by AsyncWriterGetBuffer().
+ * @return The buffer address.
+ */
+void *AsyncWriterGetBufferAddress(int Buffer_Index);
+
+/** Create a file and queue the write of a buffer content to it. The buffer is given back to the free buffers as soon as the write completes.
+ * @param Pointer_String_File_Name The file to create (it is truncated if it already exists).
+ * @param Buffer_Index The buffer to write, it must have been returned by AsyncWriterGetBuffer().
+ * @param Size How many bytes of the buffer to write.
+ * @return 0 on success,
+ * @return -1 if the file could not be created or a previous write failed.
+ */
+int AsyncWriterSubmit(const char *Pointer_String_File_Name, int Buffer_Index, size_t Size);
+
+/** Wait for all writes to complete, synchronize and close all files, then release all resources.
+ * @return 0 if all files were successfully written,
+ * @return -1 if a write or a synchronization failed.
+ */
+int AsyncWriterFinish(void);
+
+/** Tell which backend is used.
+ * @return 1 if io_uring is used, 0 if the threads pool is used.
+ */
+int AsyncWriterIsUsingIOUring(void);
+
+#endif
@@ -0,0 +1,48 @@
+/** @file Cache.c
+ * See Cache.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Cache.h"
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int CacheGetDirectory(char *Pointer_String_Directory, size_t Size, int Is_Creation_Enabled)
+{
+	char *Pointer_String_Variable;
+	struct stat Status;
+	
+	// Follow the XDG base directory specification, and fall back to a per-user directory in the temporary directory
+	Pointer_String_Variable = getenv("XDG_CACHE_HOME");
+	if ((Pointer_String_Variable != NULL) && (Pointer_String_Variable[0] != 0)) snprintf(Pointer_String_Directory, Size, "%s/thermistor-calculator", Pointer_String_Variable);
+	else
+	{
+		Pointer_String_Variable = getenv("HOME");
+		if ((Pointer_String_Variable != NULL) && (Pointer_String_Variable[0] != 0))
+		{
+			snprintf(Pointer_String_Directory, Size, "%s/.cache", Pointer_String_Variable);
+			if (Is_Creation_Enabled) mkdir(Pointer_String_Directory, 0700);
+			snprintf(Pointer_String_Directory, Size, "%s/.cache/thermistor-calculator", Pointer_String_Variable);
+		}
+		else snprintf(Pointer_String_Directory, Size, "/tmp/thermistor-calculator-%u", (unsigned int) getuid());
+	}
+	if (Is_Creation_Enabled) mkdir(Pointer_String_Directory, 0700); // Ignore the error if the directory already exists, it is checked below
+	
+	// Another user could have created the directory first (this is easy in the temporary directory) to plant files
+	if (lstat(Pointer_String_Directory, &Status) != 0) return -1;
+	if (!S_ISDIR(Status.st_mode) || (Status.st_uid != getuid()) || ((Status.st_mode & (S_IWGRP | S_IWOTH)) != 0)) return -1;
+	return 0;
+}
+
+int CacheIsFileTrusted(const char *Pointer_String_File_Name)
+{
+	struct stat Status;
+	
+	if (lstat(Pointer_String_File_Name, &Status) != 0) return 0;
+	if (!S_ISREG(Status.st_mode) || (Status.st_uid != getuid()) || ((Status.st_mode & (S_IWGRP | S_IWOTH)) != 0)) return 0;
+	return 1;
+}
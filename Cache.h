@@ -0,0 +1,30 @@
+/** @file Cache.h
+ * Locate the user cache directory, where the files that speed up the next runs are stored.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_CACHE_H
+#define H_CACHE_H
+
+#include <stddef.h>
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Find the program cache directory, and create it when a file is going to be stored. The XDG base directory specification is followed, falling back to a directory named after the user in the temporary directory.
+ * The cached files are loaded or executed later, so the directory is refused if it is a symbolic link, if it belongs to another user or if other users can write to it.
+ * @param Pointer_String_Directory On output, contain the directory path.
+ * @param Size The output string size.
+ * @param Is_Creation_Enabled Set to 1 to create the directory if it does not exist, or to 0 to only read the cached files (nothing is created then).
+ * @return 0 on success,
+ * @return -1 if the directory does not exist and could not be created, or if it is not private.
+ */
+int CacheGetDirectory(char *Pointer_String_Directory, size_t Size, int Is_Creation_Enabled);
+
+/** Tell whether a file of the cache directory was created by this user and can't be modified by other users.
+ * @param Pointer_String_File_Name The file path.
+ * @return 1 if the file can be trusted,
+ * @return 0 if the file does not exist, is not a regular file, belongs to another user or is writable by other users.
+ */
+int CacheIsFileTrusted(const char *Pointer_String_File_Name);
+
+#endif
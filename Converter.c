@@ -0,0 +1,265 @@
+/** @file Converter.c
+ * See Converter.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Cache.h"
+#include "Converter.h"
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** Change this value each time the generated code changes, so previously cached shared objects are not used anymore. */
+#define CONVERTER_GENERATOR_VERSION 2
+
+/** How many words the CC environment variable can contain (like "ccache gcc"). */
+#define CONVERTER_MAXIMUM_COMPILER_WORDS_COUNT 16
+/** How many flags are given to the compiler. */
+#define CONVERTER_COMPILER_FLAGS_COUNT (sizeof(Converter_Compiler_Flags) / sizeof(Converter_Compiler_Flags[0]))
+
+/** The name of the generated conversion function. */
+#define CONVERTER_FUNCTION_NAME "ConverterConvert"
+
+/** The longest allowed path or compiler command string. */
+#define CONVERTER_MAXIMUM_STRING_LENGTH 4096
+/** The longest allowed cache directory path, keep room for the file names. */
+#define CONVERTER_MAXIMUM_DIRECTORY_LENGTH (CONVERTER_MAXIMUM_STRING_LENGTH - 64)
+
+/** The compiler flags used to build the shared object. */
+static const char *Converter_Compiler_Flags[] = { "-O2", "-march=native", "-shared", "-fPIC" };
+
+/** The /proc/cpuinfo fields that tell which instructions "-march=native" can use (x86 and ARM names). Frequencies and core numbers are not listed because they change between runs. */
+static const char *Converter_Processor_Field_Names[] = { "vendor_id", "cpu family", "model", "model name", "flags", "CPU implementer", "CPU architecture", "CPU variant", "CPU part", "Features" };
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Add some bytes to a FNV-1a hash.
+ * @param Hash The current hash value.
+ * @param Pointer_Data The bytes to add.
+ * @param Size How many bytes to add.
+ * @return The new hash value.
+ */
+static unsigned long long ConverterHash(unsigned long long Hash, const void *Pointer_Data, size_t Size)
+{
+	const unsigned char *Pointer_Bytes = Pointer_Data;
+	size_t i;
+	
+	for (i = 0; i < Size; i++)
+	{
+		Hash ^= Pointer_Bytes[i];
+		Hash *= 0x100000001B3ULL;
+	}
+	return Hash;
+}
+
+/** Add the host processor model and features to a FNV-1a hash, so a shared object built with "-march=native" is never loaded on another processor (like when the home directory is shared by several machines).
+ * @param Hash The current hash value.
+ * @return The new hash value.
+ */
+static unsigned long long ConverterHashProcessor(unsigned long long Hash)
+{
+	FILE *Pointer_File;
+	char String_Line[CONVERTER_MAXIMUM_STRING_LENGTH], *Pointer_String_Separator;
+	size_t Length;
+	unsigned int i;
+	
+	Pointer_File = fopen("/proc/cpuinfo", "r");
+	if (Pointer_File == NULL) return Hash;
+	
+	// The first processor description is enough, it ends with an empty line
+	while ((fgets(String_Line, sizeof(String_Line), Pointer_File) != NULL) && (String_Line[0] != '\n'))
+	{
+		Pointer_String_Separator = strchr(String_Line, ':');
+		if (Pointer_String_Separator == NULL) continue;
+		
+		// The field name is padded with tabulations up to the colon
+		Length = Pointer_String_Separator - String_Line;
+		while ((Length > 0) && ((String_Line[Length - 1] == '\t') || (String_Line[Length - 1] == ' '))) Length--;
+		for (i = 0; i < sizeof(Converter_Processor_Field_Names) / sizeof(Converter_Processor_Field_Names[0]); i++)
+		{
+			if ((strlen(Converter_Processor_Field_Names[i]) == Length) && (strncmp(String_Line, Converter_Processor_Field_Names[i], Length) == 0))
+			{
+				Hash = ConverterHash(Hash, String_Line, strlen(String_Line));
+				break;
+			}
+		}
+	}
+	
+	fclose(Pointer_File);
+	return Hash;
+}
+
+/** Write the specialized conversion function source code.
+ * @param Pointer_String_File_Name The source file to create.
+ * @param Pointer_Temperatures The temperature corresponding to each ADC value (Celsius).
+ * @param Count How many entries are in the table.
+ * @return 0 on success,
+ * @return -1 if the file could not be written.
+ */
+static int ConverterGenerateSource(const char *Pointer_String_File_Name, const double *Pointer_Temperatures, unsigned int Count)
+{
+	FILE *Pointer_File;
+	unsigned int i;
+	int Result;
+	
+	Pointer_File = fopen(Pointer_String_File_Name, "w");
+	if (Pointer_File == NULL) return -1;
+	
+	fprintf(Pointer_File, "#ifdef __AVX2__\n"
+		"#include <immintrin.h>\n"
+		"#endif\n"
+		"\n"
+		"static const double Temperatures[%u] =\n"
+		"{\n", Count);
+	// Use the hexadecimal floating format to keep the exact table values
+	for (i = 0; i < Count; i++) fprintf(Pointer_File, "\t%a,\n", Pointer_Temperatures[i]);
+	fprintf(Pointer_File, "};\n"
+		"\n"
+		"void " CONVERTER_FUNCTION_NAME "(const unsigned int *Pointer_ADC_Values, double *Pointer_Temperatures, unsigned int Count)\n"
+		"{\n"
+		"\tunsigned int i = 0, ADC_Value;\n"
+		"\t\n"
+		"#ifdef __AVX2__\n"
+		"\tconst __m128i Maximum_ADC_Values = _mm_set1_epi32(%u);\n"
+		"\t__m128i ADC_Values;\n"
+		"\t\n"
+		"\t// Clamp and look up 4 values at once\n"
+		"\tfor (; i + 4 <= Count; i += 4)\n"
+		"\t{\n"
+		"\t\tADC_Values = _mm_min_epu32(_mm_loadu_si128((const __m128i *) &Pointer_ADC_Values[i]), Maximum_ADC_Values);\n"
+		"\t\t_mm256_storeu_pd(&Pointer_Temperatures[i], _mm256_i32gather_pd(Temperatures, ADC_Values, 8));\n"
+		"\t}\n"
+		"#endif\n"
+		"\t\n"
+		"\tfor (; i < Count; i++)\n"
+		"\t{\n"
+		"\t\tADC_Value = Pointer_ADC_Values[i];\n"
+		"\t\tif (ADC_Value > %uU) ADC_Value = %uU;\n"
+		"\t\tPointer_Temperatures[i] = Temperatures[ADC_Value];\n"
+		"\t}\n"
+		"}\n", Count - 1, Count - 1, Count - 1);
+	
+	Result = ferror(Pointer_File) ? -1 : 0;
+	if (fclose(Pointer_File) != 0) Result = -1;
+	return Result;
+}
+
+/** Compile the specialized function source code to a shared object. The compiler is run directly without a shell, the CC environment variable is only split on whitespaces, so its content can't run another command.
+ * @param Pointer_String_Compiler The compiler command, it can be followed by options.
+ * @param Pointer_String_Source_File_Name The source file.
+ * @param Pointer_String_Object_File_Name The shared object to create.
+ * @return 0 if the compiler succeeded,
+ * @return -1 if the compiler could not be run or failed.
+ */
+static int ConverterRunCompiler(const char *Pointer_String_Compiler, const char *Pointer_String_Source_File_Name, const char *Pointer_String_Object_File_Name)
+{
+	char String_Compiler[CONVERTER_MAXIMUM_STRING_LENGTH], *Pointer_Strings_Arguments[CONVERTER_MAXIMUM_COMPILER_WORDS_COUNT + CONVERTER_COMPILER_FLAGS_COUNT + 4], *Pointer_String_Word, *Pointer_String_Saved;
+	unsigned int Arguments_Count = 0, i;
+	int File_Descriptor, Status;
+	pid_t Process_ID;
+	
+	// Split the compiler command on whitespaces
+	if (snprintf(String_Compiler, sizeof(String_Compiler), "%s", Pointer_String_Compiler) >= (int) sizeof(String_Compiler)) return -1;
+	for (Pointer_String_Word = strtok_r(String_Compiler, " \t\n", &Pointer_String_Saved); Pointer_String_Word != NULL; Pointer_String_Word = strtok_r(NULL, " \t\n", &Pointer_String_Saved))
+	{
+		if (Arguments_Count >= CONVERTER_MAXIMUM_COMPILER_WORDS_COUNT) return -1;
+		Pointer_Strings_Arguments[Arguments_Count] = Pointer_String_Word;
+		Arguments_Count++;
+	}
+	if (Arguments_Count == 0) return -1;
+	
+	// The arguments array is not modified by execvp(), it is declared without const only because of its prototype
+	for (i = 0; i < CONVERTER_COMPILER_FLAGS_COUNT; i++) Pointer_Strings_Arguments[Arguments_Count++] = (char *) Converter_Compiler_Flags[i];
+	Pointer_Strings_Arguments[Arguments_Count++] = (char *) Pointer_String_Source_File_Name;
+	Pointer_Strings_Arguments[Arguments_Count++] = "-o";
+	Pointer_Strings_Arguments[Arguments_Count++] = (char *) Pointer_String_Object_File_Name;
+	Pointer_Strings_Arguments[Arguments_Count] = NULL;
+	
+	Process_ID = fork();
+	if (Process_ID < 0) return -1;
+	if (Process_ID == 0)
+	{
+		// Do not mix the compiler messages with the converted values
+		File_Descriptor = open("/dev/null", O_WRONLY);
+		if (File_Descriptor >= 0)
+		{
+			dup2(File_Descriptor, STDOUT_FILENO);
+			dup2(File_Descriptor, STDERR_FILENO);
+			if (File_Descriptor > STDERR_FILENO) close(File_Descriptor);
+		}
+		execvp(Pointer_Strings_Arguments[0], Pointer_Strings_Arguments);
+		_exit(127);
+	}
+	
+	while (waitpid(Process_ID, &Status, 0) < 0)
+	{
+		if (errno != EINTR) return -1;
+	}
+	if (!WIFEXITED(Status) || (WEXITSTATUS(Status) != 0)) return -1;
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+TConverterFunction ConverterGetFunction(const double *Pointer_Temperatures, unsigned int Count)
+{
+	char String_Directory[CONVERTER_MAXIMUM_DIRECTORY_LENGTH], String_Object_File_Name[CONVERTER_MAXIMUM_STRING_LENGTH], String_Temporary_File_Name[CONVERTER_MAXIMUM_STRING_LENGTH], String_Source_File_Name[CONVERTER_MAXIMUM_STRING_LENGTH], *Pointer_String_Compiler;
+	unsigned long long Hash = 0xCBF29CE484222325ULL;
+	int Version = CONVERTER_GENERATOR_VERSION, Result;
+	unsigned int i;
+	void *Pointer_Library;
+	
+	if ((Count == 0) || (Count > CONVERTER_MAXIMUM_TABLE_ENTRIES_COUNT)) return NULL;
+	
+	Pointer_String_Compiler = getenv("CC");
+	if ((Pointer_String_Compiler == NULL) || (Pointer_String_Compiler[0] == 0)) Pointer_String_Compiler = "cc";
+	
+	// The cache key covers everything the shared object depends on
+	Hash = ConverterHash(Hash, &Version, sizeof(Version));
+	Hash = ConverterHash(Hash, Pointer_String_Compiler, strlen(Pointer_String_Compiler));
+	for (i = 0; i < CONVERTER_COMPILER_FLAGS_COUNT; i++) Hash = ConverterHash(Hash, Converter_Compiler_Flags[i], strlen(Converter_Compiler_Flags[i]) + 1);
+	Hash = ConverterHashProcessor(Hash);
+	Hash = ConverterHash(Hash, &Count, sizeof(Count));
+	Hash = ConverterHash(Hash, Pointer_Temperatures, Count * sizeof(double));
+	
+	// Do not compile nor load anything if the cache directory is not private, another user could replace the shared object
+	if (CacheGetDirectory(String_Directory, sizeof(String_Directory), 1) != 0) return NULL;
+	snprintf(String_Object_File_Name, sizeof(String_Object_File_Name), "%s/converter-%016llx.so", String_Directory, Hash);
+	
+	// Compile the function if it is not in the cache yet
+	if (access(String_Object_File_Name, F_OK) != 0)
+	{
+		// Build to temporary files, so another instance never sees a partially written shared object
+		snprintf(String_Source_File_Name, sizeof(String_Source_File_Name), "%s/converter-%016llx-%d.c", String_Directory, Hash, (int) getpid());
+		snprintf(String_Temporary_File_Name, sizeof(String_Temporary_File_Name), "%s/converter-%016llx-%d.so", String_Directory, Hash, (int) getpid());
+		if (ConverterGenerateSource(String_Source_File_Name, Pointer_Temperatures, Count) != 0)
+		{
+			unlink(String_Source_File_Name);
+			return NULL;
+		}
+		
+		Result = ConverterRunCompiler(Pointer_String_Compiler, String_Source_File_Name, String_Temporary_File_Name);
+		unlink(String_Source_File_Name);
+		if ((Result != 0) || (chmod(String_Temporary_File_Name, 0700) != 0) || (rename(String_Temporary_File_Name, String_Object_File_Name) != 0))
+		{
+			unlink(String_Temporary_File_Name);
+			return NULL;
+		}
+	}
+	
+	// Load only a shared object built by this user, the library is never closed because the function is used until the program exits
+	if (!CacheIsFileTrusted(String_Object_File_Name)) return NULL;
+	Pointer_Library = dlopen(String_Object_File_Name, RTLD_NOW | RTLD_LOCAL);
+	if (Pointer_Library == NULL) return NULL;
+	return (TConverterFunction) dlsym(Pointer_Library, CONVERTER_FUNCTION_NAME);
+}
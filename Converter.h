@@ -0,0 +1,37 @@
+/** @file Converter.h
+ * Generate a C conversion function specialized for a lookup table, compile it with the system compiler to a shared object and load it.
+ * The compiled shared objects are cached, so the compiler runs only once for a given table.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_CONVERTER_H
+#define H_CONVERTER_H
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** The biggest table that is folded in a compiled function. Bigger tables would make a huge source file that takes the compiler a long time, and they do not fit in the caches anyway, so they use the generic conversion. */
+#define CONVERTER_MAXIMUM_TABLE_ENTRIES_COUNT 16384
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** Convert ADC values to temperatures.
+ * @param Pointer_ADC_Values The ADC values to convert. Values beyond the table end are clamped to the table last entry.
+ * @param Pointer_Temperatures On output, contain the corresponding temperatures (Celsius).
+ * @param Count How many values to convert.
+ */
+typedef void (*TConverterFunction)(const unsigned int *Pointer_ADC_Values, double *Pointer_Temperatures, unsigned int Count);
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Get a compiled conversion function with the lookup table folded in, from the cache or by compiling it.
+ * The compiler is the one set by the CC environment variable, or "cc" if the variable is not set. The variable can contain the compiler options separated by whitespaces, it is not interpreted by a shell.
+ * @param Pointer_Temperatures The temperature corresponding to each ADC value (Celsius).
+ * @param Count How many entries are in the table.
+ * @return The conversion function,
+ * @return NULL if the table has more than CONVERTER_MAXIMUM_TABLE_ENTRIES_COUNT entries or if the function could not be compiled or loaded (the caller should then use a generic conversion path).
+ */
+TConverterFunction ConverterGetFunction(const double *Pointer_Temperatures, unsigned int Count);
+
+#endif
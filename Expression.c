@@ -0,0 +1,425 @@
+/** @file Expression.c
+ * See Expression.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <ctype.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Expression.h"
+
+//-------------------------------------------------------------------------------------------------
+// Private constants and macros
+//-------------------------------------------------------------------------------------------------
+/** The register containing the "code" variable. */
+#define EXPRESSION_REGISTER_CODE 0
+/** The register containing the "voltage" variable. */
+#define EXPRESSION_REGISTER_VOLTAGE 1
+/** The register containing the "resistance" variable. */
+#define EXPRESSION_REGISTER_RESISTANCE 2
+/** How many registers are reserved for the variables. */
+#define EXPRESSION_VARIABLES_COUNT 3
+/** How many parenthesis, function calls, negations and powers can be nested, this bounds the parser recursion (and so its stack usage). */
+#define EXPRESSION_MAXIMUM_NESTING_DEPTH 128
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** All bytecode operations. */
+typedef enum
+{
+	EXPRESSION_OPCODE_LOAD_CONSTANT,
+	EXPRESSION_OPCODE_ADD,
+	EXPRESSION_OPCODE_SUBTRACT,
+	EXPRESSION_OPCODE_MULTIPLY,
+	EXPRESSION_OPCODE_DIVIDE,
+	EXPRESSION_OPCODE_POWER,
+	EXPRESSION_OPCODE_NEGATE,
+	EXPRESSION_OPCODE_LOG,
+	EXPRESSION_OPCODE_LOG10,
+	EXPRESSION_OPCODE_EXP,
+	EXPRESSION_OPCODE_SQRT,
+	EXPRESSION_OPCODE_ABS
+} TExpressionOpcode;
+
+/** A function that can be called from an expression. */
+typedef struct
+{
+	const char *Pointer_String_Name; //!< The function name.
+	TExpressionOpcode Opcode; //!< The corresponding operation.
+} TExpressionFunction;
+
+/** The parser state. */
+typedef struct
+{
+	const char *Pointer_String_Expression; //!< The whole expression.
+	int Index; //!< The next character to parse.
+	int Nesting_Depth; //!< How many negations or powers are being parsed, including the ones of enclosing parenthesis.
+	uint64_t Used_Registers_Mask; //!< A bit is set for each register holding a value that has not been consumed yet (the variables registers are always set).
+	TExpressionProgram *Pointer_Program; //!< The program being built.
+} TExpressionParser;
+
+//-------------------------------------------------------------------------------------------------
+// Private variables
+//-------------------------------------------------------------------------------------------------
+/** All supported functions. */
+static const TExpressionFunction Expression_Functions[] =
+{
+	{ "log", EXPRESSION_OPCODE_LOG },
+	{ "log10", EXPRESSION_OPCODE_LOG10 },
+	{ "exp", EXPRESSION_OPCODE_EXP },
+	{ "sqrt", EXPRESSION_OPCODE_SQRT },
+	{ "abs", EXPRESSION_OPCODE_ABS }
+};
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Skip the whitespaces preceding the next token.
+ * @param Pointer_Parser The parser state.
+ * @return The next token first character.
+ */
+static char ExpressionPeekCharacter(TExpressionParser *Pointer_Parser)
+{
+	while (isspace((unsigned char) Pointer_Parser->Pointer_String_Expression[Pointer_Parser->Index])) Pointer_Parser->Index++;
+	return Pointer_Parser->Pointer_String_Expression[Pointer_Parser->Index];
+}
+
+/** Release a register whose value has been consumed by an instruction, so a next instruction can reuse it. The variables registers are never released.
+ * @param Pointer_Parser The parser state.
+ * @param Register The register to release.
+ */
+static void ExpressionReleaseRegister(TExpressionParser *Pointer_Parser, int Register)
+{
+	if (Register >= EXPRESSION_VARIABLES_COUNT) Pointer_Parser->Used_Registers_Mask &= ~((uint64_t) 1 << Register);
+}
+
+/** Append an instruction writing to a free register. The result register is taken before the operands registers are released, so it never aliases them (the evaluation loops rely on that).
+ * @param Pointer_Parser The parser state.
+ * @param Opcode The operation to do.
+ * @param First_Source_Register The first operand register.
+ * @param Second_Source_Register The second operand register.
+ * @param Constant The constant to load (used only by the constant loading operation).
+ * @return The register receiving the result,
+ * @return -1 if the program is too big.
+ */
+static int ExpressionEmitInstruction(TExpressionParser *Pointer_Parser, TExpressionOpcode Opcode, int First_Source_Register, int Second_Source_Register, double Constant)
+{
+	TExpressionProgram *Pointer_Program = Pointer_Parser->Pointer_Program;
+	TExpressionInstruction *Pointer_Instruction;
+	int Register;
+	
+	if (Pointer_Program->Instructions_Count >= EXPRESSION_MAXIMUM_INSTRUCTIONS_COUNT) return -1;
+	
+	// Take the lowest free register
+	if (Pointer_Parser->Used_Registers_Mask == UINT64_MAX) return -1;
+	Register = __builtin_ctzll(~Pointer_Parser->Used_Registers_Mask);
+	if (Register >= EXPRESSION_MAXIMUM_REGISTERS_COUNT) return -1;
+	Pointer_Parser->Used_Registers_Mask |= (uint64_t) 1 << Register;
+	if (Register >= Pointer_Program->Registers_Count) Pointer_Program->Registers_Count = Register + 1;
+	
+	// The constant loading operation has no operands
+	if (Opcode != EXPRESSION_OPCODE_LOAD_CONSTANT)
+	{
+		ExpressionReleaseRegister(Pointer_Parser, First_Source_Register);
+		ExpressionReleaseRegister(Pointer_Parser, Second_Source_Register);
+	}
+	
+	Pointer_Instruction = &Pointer_Program->Instructions[Pointer_Program->Instructions_Count];
+	Pointer_Instruction->Opcode = (unsigned char) Opcode;
+	Pointer_Instruction->Destination_Register = (unsigned char) Register;
+	Pointer_Instruction->Source_Registers[0] = (unsigned char) First_Source_Register;
+	Pointer_Instruction->Source_Registers[1] = (unsigned char) Second_Source_Register;
+	Pointer_Instruction->Constant = Constant;
+	Pointer_Program->Instructions_Count++;
+	
+	return Register;
+}
+
+static int ExpressionParseSum(TExpressionParser *Pointer_Parser);
+
+/** Parse a number, a variable, a function call or a parenthesized expression.
+ * @param Pointer_Parser The parser state.
+ * @return The register containing the parsed value,
+ * @return -1 if an error occurred.
+ */
+static int ExpressionParsePrimary(TExpressionParser *Pointer_Parser)
+{
+	const char *Pointer_String_Start;
+	char *Pointer_String_End, Character;
+	int Length, Register;
+	unsigned int i;
+	double Number;
+	
+	Character = ExpressionPeekCharacter(Pointer_Parser);
+	Pointer_String_Start = &Pointer_Parser->Pointer_String_Expression[Pointer_Parser->Index];
+	
+	// Parenthesized expression
+	if (Character == '(')
+	{
+		Pointer_Parser->Index++;
+		Register = ExpressionParseSum(Pointer_Parser);
+		if (Register < 0) return -1;
+		if (ExpressionPeekCharacter(Pointer_Parser) != ')') return -1;
+		Pointer_Parser->Index++;
+		return Register;
+	}
+	
+	// Number
+	if (isdigit((unsigned char) Character) || (Character == '.'))
+	{
+		Number = strtod(Pointer_String_Start, &Pointer_String_End);
+		if (Pointer_String_End == Pointer_String_Start) return -1;
+		Pointer_Parser->Index += Pointer_String_End - Pointer_String_Start;
+		return ExpressionEmitInstruction(Pointer_Parser, EXPRESSION_OPCODE_LOAD_CONSTANT, 0, 0, Number);
+	}
+	
+	// Identifier
+	if (!isalpha((unsigned char) Character)) return -1;
+	Length = 0;
+	while (isalnum((unsigned char) Pointer_String_Start[Length]) || (Pointer_String_Start[Length] == '_')) Length++;
+	Pointer_Parser->Index += Length;
+	
+	// Variables are always stored in the same registers
+	if ((Length == 4) && (strncmp(Pointer_String_Start, "code", 4) == 0)) return EXPRESSION_REGISTER_CODE;
+	if ((Length == 7) && (strncmp(Pointer_String_Start, "voltage", 7) == 0)) return EXPRESSION_REGISTER_VOLTAGE;
+	if ((Length == 10) && (strncmp(Pointer_String_Start, "resistance", 10) == 0)) return EXPRESSION_REGISTER_RESISTANCE;
+	
+	// Function call
+	for (i = 0; i < sizeof(Expression_Functions) / sizeof(Expression_Functions[0]); i++)
+	{
+		if (((int) strlen(Expression_Functions[i].Pointer_String_Name) == Length) && (strncmp(Pointer_String_Start, Expression_Functions[i].Pointer_String_Name, Length) == 0))
+		{
+			if (ExpressionPeekCharacter(Pointer_Parser) != '(') return -1;
+			Pointer_Parser->Index++;
+			Register = ExpressionParseSum(Pointer_Parser);
+			if (Register < 0) return -1;
+			if (ExpressionPeekCharacter(Pointer_Parser) != ')') return -1;
+			Pointer_Parser->Index++;
+			return ExpressionEmitInstruction(Pointer_Parser, Expression_Functions[i].Opcode, Register, 0, 0);
+		}
+	}
+	
+	// Unknown identifier, point to its beginning
+	Pointer_Parser->Index -= Length;
+	return -1;
+}
+
+/** Parse a negation or a power (the power operator is right-associative and has priority over negation, so -2^2 is -4).
+ * @param Pointer_Parser The parser state.
+ * @return The register containing the parsed value,
+ * @return -1 if an error occurred.
+ */
+static int ExpressionParseUnary(TExpressionParser *Pointer_Parser)
+{
+	int Register, Exponent_Register;
+	
+	// All recursive rules go through this one, stop before the stack overflows (the error index points to the too deeply nested operand)
+	if (Pointer_Parser->Nesting_Depth >= EXPRESSION_MAXIMUM_NESTING_DEPTH)
+	{
+		ExpressionPeekCharacter(Pointer_Parser);
+		return -1;
+	}
+	Pointer_Parser->Nesting_Depth++;
+	
+	if (ExpressionPeekCharacter(Pointer_Parser) == '-')
+	{
+		Pointer_Parser->Index++;
+		Register = ExpressionParseUnary(Pointer_Parser);
+		if (Register >= 0) Register = ExpressionEmitInstruction(Pointer_Parser, EXPRESSION_OPCODE_NEGATE, Register, 0, 0);
+	}
+	else
+	{
+		Register = ExpressionParsePrimary(Pointer_Parser);
+		if ((Register >= 0) && (ExpressionPeekCharacter(Pointer_Parser) == '^'))
+		{
+			Pointer_Parser->Index++;
+			Exponent_Register = ExpressionParseUnary(Pointer_Parser);
+			if (Exponent_Register < 0) Register = -1;
+			else Register = ExpressionEmitInstruction(Pointer_Parser, EXPRESSION_OPCODE_POWER, Register, Exponent_Register, 0);
+		}
+	}
+	
+	Pointer_Parser->Nesting_Depth--;
+	return Register;
+}
+
+/** Parse a sequence of multiplications and divisions.
+ * @param Pointer_Parser The parser state.
+ * @return The register containing the parsed value,
+ * @return -1 if an error occurred.
+ */
+static int ExpressionParseProduct(TExpressionParser *Pointer_Parser)
+{
+	int Register, Operand_Register;
+	char Operator;
+	
+	Register = ExpressionParseUnary(Pointer_Parser);
+	if (Register < 0) return -1;
+	
+	while (1)
+	{
+		Operator = ExpressionPeekCharacter(Pointer_Parser);
+		if ((Operator != '*') && (Operator != '/')) return Register;
+		Pointer_Parser->Index++;
+		
+		Operand_Register = ExpressionParseUnary(Pointer_Parser);
+		if (Operand_Register < 0) return -1;
+		Register = ExpressionEmitInstruction(Pointer_Parser, Operator == '*' ? EXPRESSION_OPCODE_MULTIPLY : EXPRESSION_OPCODE_DIVIDE, Register, Operand_Register, 0);
+		if (Register < 0) return -1;
+	}
+}
+
+/** Parse a sequence of additions and subtractions.
+ * @param Pointer_Parser The parser state.
+ * @return The register containing the parsed value,
+ * @return -1 if an error occurred.
+ */
+static int ExpressionParseSum(TExpressionParser *Pointer_Parser)
+{
+	int Register, Operand_Register;
+	char Operator;
+	
+	Register = ExpressionParseProduct(Pointer_Parser);
+	if (Register < 0) return -1;
+	
+	while (1)
+	{
+		Operator = ExpressionPeekCharacter(Pointer_Parser);
+		if ((Operator != '+') && (Operator != '-')) return Register;
+		Pointer_Parser->Index++;
+		
+		Operand_Register = ExpressionParseProduct(Pointer_Parser);
+		if (Operand_Register < 0) return -1;
+		Register = ExpressionEmitInstruction(Pointer_Parser, Operator == '+' ? EXPRESSION_OPCODE_ADD : EXPRESSION_OPCODE_SUBTRACT, Register, Operand_Register, 0);
+		if (Register < 0) return -1;
+	}
+}
+
+/** Apply an operation to a whole register block. The registers are function parameters so that the compiler trusts their restrict qualifiers, this lets the arithmetic loops be vectorized even with the cheap vectorizer cost model of -O2.
+ * @param Opcode The operation to do.
+ * @param Pointer_Destination The result register, it must not be one of the operands registers.
+ * @param Pointer_First_Source The first operand register.
+ * @param Pointer_Second_Source The second operand register.
+ * @param Constant The constant to load (used only by the constant loading operation).
+ */
+static void ExpressionExecuteInstruction(TExpressionOpcode Opcode, double * restrict Pointer_Destination, const double * restrict Pointer_First_Source, const double * restrict Pointer_Second_Source, double Constant)
+{
+	unsigned int i;
+	
+	switch (Opcode)
+	{
+		case EXPRESSION_OPCODE_LOAD_CONSTANT:
+			for (i = 0; i < EXPRESSION_BLOCK_SIZE; i++) Pointer_Destination[i] = Constant;
+			break;
+			
+		case EXPRESSION_OPCODE_ADD:
+			for (i = 0; i < EXPRESSION_BLOCK_SIZE; i++) Pointer_Destination[i] = Pointer_First_Source[i] + Pointer_Second_Source[i];
+			break;
+			
+		case EXPRESSION_OPCODE_SUBTRACT:
+			for (i = 0; i < EXPRESSION_BLOCK_SIZE; i++) Pointer_Destination[i] = Pointer_First_Source[i] - Pointer_Second_Source[i];
+			break;
+			
+		case EXPRESSION_OPCODE_MULTIPLY:
+			for (i = 0; i < EXPRESSION_BLOCK_SIZE; i++) Pointer_Destination[i] = Pointer_First_Source[i] * Pointer_Second_Source[i];
+			break;
+			
+		case EXPRESSION_OPCODE_DIVIDE:
+			for (i = 0; i < EXPRESSION_BLOCK_SIZE; i++) Pointer_Destination[i] = Pointer_First_Source[i] / Pointer_Second_Source[i];
+			break;
+			
+		case EXPRESSION_OPCODE_POWER:
+			for (i = 0; i < EXPRESSION_BLOCK_SIZE; i++) Pointer_Destination[i] = pow(Pointer_First_Source[i], Pointer_Second_Source[i]);
+			break;
+			
+		case EXPRESSION_OPCODE_NEGATE:
+			for (i = 0; i < EXPRESSION_BLOCK_SIZE; i++) Pointer_Destination[i] = -Pointer_First_Source[i];
+			break;
+			
+		case EXPRESSION_OPCODE_LOG:
+			for (i = 0; i < EXPRESSION_BLOCK_SIZE; i++) Pointer_Destination[i] = log(Pointer_First_Source[i]);
+			break;
+			
+		case EXPRESSION_OPCODE_LOG10:
+			for (i = 0; i < EXPRESSION_BLOCK_SIZE; i++) Pointer_Destination[i] = log10(Pointer_First_Source[i]);
+			break;
+			
+		case EXPRESSION_OPCODE_EXP:
+			for (i = 0; i < EXPRESSION_BLOCK_SIZE; i++) Pointer_Destination[i] = exp(Pointer_First_Source[i]);
+			break;
+			
+		case EXPRESSION_OPCODE_SQRT:
+			for (i = 0; i < EXPRESSION_BLOCK_SIZE; i++) Pointer_Destination[i] = sqrt(Pointer_First_Source[i]);
+			break;
+			
+		case EXPRESSION_OPCODE_ABS:
+			for (i = 0; i < EXPRESSION_BLOCK_SIZE; i++) Pointer_Destination[i] = fabs(Pointer_First_Source[i]);
+			break;
+			
+		default:
+			break;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int ExpressionCompile(const char *Pointer_String_Expression, TExpressionProgram *Pointer_Program, int *Pointer_Error_Index)
+{
+	TExpressionParser Parser;
+	
+	Parser.Pointer_String_Expression = Pointer_String_Expression;
+	Parser.Index = 0;
+	Parser.Nesting_Depth = 0;
+	Parser.Used_Registers_Mask = ((uint64_t) 1 << EXPRESSION_VARIABLES_COUNT) - 1;
+	Parser.Pointer_Program = Pointer_Program;
+	Pointer_Program->Instructions_Count = 0;
+	Pointer_Program->Registers_Count = EXPRESSION_VARIABLES_COUNT;
+	
+	Pointer_Program->Result_Register = ExpressionParseSum(&Parser);
+	if ((Pointer_Program->Result_Register < 0) || (ExpressionPeekCharacter(&Parser) != 0))
+	{
+		*Pointer_Error_Index = Parser.Index;
+		return -1;
+	}
+	return 0;
+}
+
+void ExpressionEvaluate(const TExpressionProgram *Pointer_Program, const double *Pointer_Codes, const double *Pointer_Voltages, const double *Pointer_Resistances, double *Pointer_Results, unsigned int Count)
+{
+	double Registers[EXPRESSION_MAXIMUM_REGISTERS_COUNT][EXPRESSION_BLOCK_SIZE]; // Keep the registers on the stack so several threads can evaluate expressions at the same time
+	const TExpressionInstruction *Pointer_Instruction;
+	unsigned int Block_Size;
+	int j;
+	
+	while (Count > 0)
+	{
+		Block_Size = Count < EXPRESSION_BLOCK_SIZE ? Count : EXPRESSION_BLOCK_SIZE;
+		
+		// Load the variables, and zero the end of a partial block so the operations always process whole blocks
+		memcpy(Registers[EXPRESSION_REGISTER_CODE], Pointer_Codes, Block_Size * sizeof(double));
+		memcpy(Registers[EXPRESSION_REGISTER_VOLTAGE], Pointer_Voltages, Block_Size * sizeof(double));
+		memcpy(Registers[EXPRESSION_REGISTER_RESISTANCE], Pointer_Resistances, Block_Size * sizeof(double));
+		if (Block_Size < EXPRESSION_BLOCK_SIZE)
+		{
+			for (j = 0; j < EXPRESSION_VARIABLES_COUNT; j++) memset(&Registers[j][Block_Size], 0, (EXPRESSION_BLOCK_SIZE - Block_Size) * sizeof(double));
+		}
+		
+		// Run the program on the whole block, an instruction result register never aliases its operands registers
+		for (j = 0; j < Pointer_Program->Instructions_Count; j++)
+		{
+			Pointer_Instruction = &Pointer_Program->Instructions[j];
+			ExpressionExecuteInstruction((TExpressionOpcode) Pointer_Instruction->Opcode, Registers[Pointer_Instruction->Destination_Register], Registers[Pointer_Instruction->Source_Registers[0]], Registers[Pointer_Instruction->Source_Registers[1]], Pointer_Instruction->Constant);
+		}
+		
+		memcpy(Pointer_Results, Registers[Pointer_Program->Result_Register], Block_Size * sizeof(double));
+		
+		Pointer_Codes += Block_Size;
+		Pointer_Voltages += Block_Size;
+		Pointer_Resistances += Block_Size;
+		Pointer_Results += Block_Size;
+		Count -= Block_Size;
+	}
+}
@@ -0,0 +1,64 @@
+/** @file Expression.h
+ * Compile a mathematical expression to a register bytecode once, then evaluate it over blocks of values.
+ * The expression can use the "code", "voltage" and "resistance" variables, numbers, the + - * / ^ operators, parenthesis and the log(), log10(), exp(), sqrt() and abs() functions.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_EXPRESSION_H
+#define H_EXPRESSION_H
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** How many values are evaluated at the same time. Each instruction processes a whole block, so the instruction decoding cost is shared by the block values. */
+#define EXPRESSION_BLOCK_SIZE 64
+
+/** The biggest amount of instructions a program can contain. */
+#define EXPRESSION_MAXIMUM_INSTRUCTIONS_COUNT 128
+/** The biggest amount of registers a program can use (the first registers hold the variables, and it must not exceed 64). The registers are reused once their value is consumed, so this only bounds how many intermediate values are alive at the same time, like the operands pending in a deeply right-nested expression. */
+#define EXPRESSION_MAXIMUM_REGISTERS_COUNT 64
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A single bytecode instruction, operating on whole register blocks. */
+typedef struct
+{
+	unsigned char Opcode; //!< The operation to do.
+	unsigned char Destination_Register; //!< The register receiving the result.
+	unsigned char Source_Registers[2]; //!< The operands registers (unused operands are ignored).
+	double Constant; //!< The value to load when the instruction loads a constant.
+} TExpressionInstruction;
+
+/** A compiled expression. */
+typedef struct
+{
+	int Instructions_Count; //!< How many instructions are used.
+	int Registers_Count; //!< How many registers are used.
+	int Result_Register; //!< The register containing the expression value after the last instruction.
+	TExpressionInstruction Instructions[EXPRESSION_MAXIMUM_INSTRUCTIONS_COUNT]; //!< The program instructions.
+} TExpressionProgram;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Parse an expression and convert it to bytecode.
+ * @param Pointer_String_Expression The expression to compile.
+ * @param Pointer_Program On output, contain the compiled program.
+ * @param Pointer_Error_Index On output, contain the index of the expression character that could not be parsed. This value is valid only if the function failed.
+ * @return 0 if the expression was successfully compiled,
+ * @return -1 if the expression is malformed or too complex.
+ */
+int ExpressionCompile(const char *Pointer_String_Expression, TExpressionProgram *Pointer_Program, int *Pointer_Error_Index);
+
+/** Evaluate a compiled expression for many variables values.
+ * @param Pointer_Program The compiled program.
+ * @param Pointer_Codes The "code" variable values.
+ * @param Pointer_Voltages The "voltage" variable values.
+ * @param Pointer_Resistances The "resistance" variable values.
+ * @param Pointer_Results On output, contain the expression values.
+ * @param Count How many values to evaluate.
+ * @note This function is thread-safe.
+ */
+void ExpressionEvaluate(const TExpressionProgram *Pointer_Program, const double *Pointer_Codes, const double *Pointer_Voltages, const double *Pointer_Resistances, double *Pointer_Results, unsigned int Count);
+
+#endif
@@ -0,0 +1,116 @@
+/** @file ThermistorTable.c
+ * See ThermistorTable.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include "ThermistorTable.h"
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** How many fractional bits the logarithms have. */
+#define THERMISTOR_TABLE_LOGARITHM_FRACTIONAL_BITS 16
+
+/** The natural logarithm of 2, in Q30 fixed-point format. */
+#define THERMISTOR_TABLE_LOGARITHM_OF_2_Q30 744261118LL
+
+/** The thermistor reference temperature (25 Celsius degrees), in centikelvins. */
+#define THERMISTOR_TABLE_REFERENCE_TEMPERATURE_CENTIKELVINS 29815LL
+
+/** The Kelvin temperature corresponding to 0 Celsius degree, in centikelvins. */
+#define THERMISTOR_TABLE_KELVIN_OFFSET_CENTIKELVINS 27315LL
+
+/** The temperature reported for the ADC values that do not correspond to a thermistor resistance or a positive Kelvin temperature (the thermistor calculator reports the absolute zero for the first ones). */
+#define THERMISTOR_TABLE_INVALID_TEMPERATURE -273
+
+/** The highest temperature that fits in a table entry (centi-Celsius). */
+#define THERMISTOR_TABLE_MAXIMUM_TEMPERATURE 3276700LL
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Compute the base 2 logarithm of an integer with the repeated squaring recurrence : squaring the normalized mantissa doubles its logarithm, so each squaring gives one fractional bit.
+ * @param Value The value to compute logarithm of, it must not be zero.
+ * @return The logarithm in Q16 fixed-point format.
+ */
+static int32_t ThermistorTableComputeLogarithm2(uint64_t Value)
+{
+	int32_t Result;
+	int Most_Significant_Bit = 0, i;
+	uint64_t Mantissa;
+	
+	// The integer part is the most significant bit position
+	while ((Value >> Most_Significant_Bit) > 1) Most_Significant_Bit++;
+	Result = (int32_t) Most_Significant_Bit << THERMISTOR_TABLE_LOGARITHM_FRACTIONAL_BITS;
+	
+	// Normalize the mantissa to Q30 format in range [1; 2[
+	if (Most_Significant_Bit > 30) Mantissa = Value >> (Most_Significant_Bit - 30);
+	else Mantissa = Value << (30 - Most_Significant_Bit);
+	
+	for (i = THERMISTOR_TABLE_LOGARITHM_FRACTIONAL_BITS - 1; i >= 0; i--)
+	{
+		Mantissa = (Mantissa * Mantissa) >> 30;
+		if (Mantissa >= (2ULL << 30))
+		{
+			Mantissa >>= 1;
+			Result |= (int32_t) 1 << i;
+		}
+	}
+	
+	return Result;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int ThermistorTableGenerate(uint8_t Circuit_Variant, uint16_t Thermistor_Beta_Coefficient, uint32_t Thermistor_Reference_Resistance, uint32_t Voltage_Divider_Resistor, uint32_t ADC_Resolution, int16_t *Pointer_Table)
+{
+	uint32_t ADC_Value, Maximum_ADC_Value;
+	uint64_t Numerator, Denominator;
+	int64_t Logarithm, Temperature_Numerator, Temperature_Denominator, Temperature;
+	
+	if ((Circuit_Variant < 1) || (Circuit_Variant > 2) || (Thermistor_Beta_Coefficient == 0) || (Thermistor_Reference_Resistance == 0) || (Voltage_Divider_Resistor == 0) || (ADC_Resolution < 2) || (ADC_Resolution > THERMISTOR_TABLE_MAXIMUM_ADC_RESOLUTION)) return -1;
+	Maximum_ADC_Value = ADC_Resolution - 1;
+	
+	// The Vcc voltage cancels out, Rt / R25 = (Numerator / Denominator) is computed with integers only
+	for (ADC_Value = 0; ADC_Value < ADC_Resolution; ADC_Value++)
+	{
+		// Rt = resistor * code / (maximum code - code) when the thermistor is the bottom resistor
+		if (Circuit_Variant == 1)
+		{
+			Numerator = (uint64_t) ADC_Value * Voltage_Divider_Resistor;
+			Denominator = (uint64_t) (Maximum_ADC_Value - ADC_Value) * Thermistor_Reference_Resistance;
+		}
+		// Rt = resistor * (maximum code - code) / code when the thermistor is the top resistor
+		else
+		{
+			Numerator = (uint64_t) (Maximum_ADC_Value - ADC_Value) * Voltage_Divider_Resistor;
+			Denominator = (uint64_t) ADC_Value * Thermistor_Reference_Resistance;
+		}
+		if ((Numerator == 0) || (Denominator == 0))
+		{
+			Pointer_Table[ADC_Value] = THERMISTOR_TABLE_INVALID_TEMPERATURE;
+			continue;
+		}
+		
+		// ln(Rt / R25) in Q16 format
+		Logarithm = (int64_t) ThermistorTableComputeLogarithm2(Numerator) - ThermistorTableComputeLogarithm2(Denominator);
+		Logarithm = (Logarithm * THERMISTOR_TABLE_LOGARITHM_OF_2_Q30) >> 30;
+		
+		// T = Beta * T25 / (Beta + ln(Rt / R25) * T25), computed in centikelvins
+		Temperature_Numerator = (int64_t) Thermistor_Beta_Coefficient * THERMISTOR_TABLE_REFERENCE_TEMPERATURE_CENTIKELVINS * 100 << THERMISTOR_TABLE_LOGARITHM_FRACTIONAL_BITS;
+		Temperature_Denominator = Logarithm * THERMISTOR_TABLE_REFERENCE_TEMPERATURE_CENTIKELVINS + ((int64_t) Thermistor_Beta_Coefficient * 100 << THERMISTOR_TABLE_LOGARITHM_FRACTIONAL_BITS);
+		if (Temperature_Denominator <= 0)
+		{
+			Pointer_Table[ADC_Value] = THERMISTOR_TABLE_INVALID_TEMPERATURE;
+			continue;
+		}
+		Temperature = Temperature_Numerator / Temperature_Denominator - THERMISTOR_TABLE_KELVIN_OFFSET_CENTIKELVINS;
+		if (Temperature > THERMISTOR_TABLE_MAXIMUM_TEMPERATURE) Temperature = THERMISTOR_TABLE_MAXIMUM_TEMPERATURE;
+		
+		// Round to the nearest Celsius degree
+		if (Temperature >= 0) Pointer_Table[ADC_Value] = (int16_t) ((Temperature + 50) / 100);
+		else Pointer_Table[ADC_Value] = (int16_t) -((-Temperature + 50) / 100);
+	}
+	
+	return 0;
+}
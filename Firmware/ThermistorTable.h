@@ -0,0 +1,32 @@
+/** @file ThermistorTable.h
+ * Generate the thermistor ADC lookup table on the target itself, without floating point computations, logarithm library function nor memory allocation.
+ * The generated table is the same as the thermistor calculator "ADC lookup table" output, within one Celsius degree. The only exceptions are the extreme ADC values for which the Beta model gives a temperature below the absolute zero (they are set to -273) or too high to fit in 16 bits (they are saturated).
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_THERMISTOR_TABLE_H
+#define H_THERMISTOR_TABLE_H
+
+#include <stdint.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** The biggest supported ADC resolution. */
+#define THERMISTOR_TABLE_MAXIMUM_ADC_RESOLUTION 65536UL
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Fill the ADC lookup table. Each entry costs a bounded amount of integer operations (two fixed-point logarithms and a 64-bit division), whatever the parameters are.
+ * @param Circuit_Variant The voltage divider circuit variant (1 or 2, see the thermistor calculator help).
+ * @param Thermistor_Beta_Coefficient Beta coefficient value (kelvin).
+ * @param Thermistor_Reference_Resistance Thermistor R25 resistor value (ohms).
+ * @param Voltage_Divider_Resistor The bridge resistor value (ohms).
+ * @param ADC_Resolution The ADC resolution (corresponding to the amount of ADC steps), in range [2; THERMISTOR_TABLE_MAXIMUM_ADC_RESOLUTION].
+ * @param Pointer_Table On output, contain the rounded temperature corresponding to each ADC value (Celsius). This array must have room for ADC_Resolution values.
+ * @return 0 on success,
+ * @return -1 if a parameter is invalid.
+ */
+int ThermistorTableGenerate(uint8_t Circuit_Variant, uint16_t Thermistor_Beta_Coefficient, uint32_t Thermistor_Reference_Resistance, uint32_t Voltage_Divider_Resistor, uint32_t ADC_Resolution, int16_t *Pointer_Table);
+
+#endif
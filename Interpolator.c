@@ -0,0 +1,88 @@
+/** @file Interpolator.c
+ * See Interpolator.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include "Interpolator.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+	#include <immintrin.h>
+	#define INTERPOLATOR_IS_SIMD_KERNEL_AVAILABLE 1
+#else
+	#define INTERPOLATOR_IS_SIMD_KERNEL_AVAILABLE 0
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** The portable kernel, see InterpolatorConvert() for the parameters. */
+static void InterpolatorConvertScalar(const double *Pointer_Table, unsigned int Stride, unsigned int Fraction_Bits, const unsigned int *Pointer_Fixed_Point_Values, double *Pointer_Temperatures, unsigned int Count)
+{
+	unsigned int i, Index, Fraction_Mask = (1U << Fraction_Bits) - 1;
+	double Scale = 1. / (1U << Fraction_Bits), Fraction, Low_Temperature;
+	
+	for (i = 0; i < Count; i++)
+	{
+		Index = Pointer_Fixed_Point_Values[i] >> Fraction_Bits;
+		Fraction = (Pointer_Fixed_Point_Values[i] & Fraction_Mask) * Scale;
+		Low_Temperature = Pointer_Table[(size_t) Index * Stride];
+		
+		// Do not read the next entry of integer values, it does not exist after the table last entry and it could be infinite
+		if (Fraction == 0) Pointer_Temperatures[i] = Low_Temperature;
+		else Pointer_Temperatures[i] = Low_Temperature + Fraction * (Pointer_Table[(size_t) (Index + 1) * Stride] - Low_Temperature);
+	}
+}
+
+#if INTERPOLATOR_IS_SIMD_KERNEL_AVAILABLE
+/** The AVX2 kernel, gathering the two surrounding table entries of 4 values per iteration, see InterpolatorConvert() for the parameters. */
+static __attribute__((target("avx2"))) void InterpolatorConvertAVX2(const double *Pointer_Table, unsigned int Stride, unsigned int Table_Size, unsigned int Fraction_Bits, const unsigned int *Pointer_Fixed_Point_Values, double *Pointer_Temperatures, unsigned int Count)
+{
+	unsigned int i;
+	__m128i Values, Indexes, Next_Indexes, Fraction_Mask, Last_Index, Strides, Ones, Shift;
+	__m256d Scale, Fractions, Low_Temperatures, High_Temperatures, Temperatures;
+	
+	Fraction_Mask = _mm_set1_epi32((int) ((1U << Fraction_Bits) - 1));
+	Last_Index = _mm_set1_epi32((int) (Table_Size - 1));
+	Strides = _mm_set1_epi32((int) Stride);
+	Ones = _mm_set1_epi32(1);
+	Shift = _mm_cvtsi32_si128((int) Fraction_Bits);
+	Scale = _mm256_set1_pd(1. / (1U << Fraction_Bits));
+	
+	for (i = 0; i + 4 <= Count; i += 4)
+	{
+		Values = _mm_loadu_si128((const __m128i *) &Pointer_Fixed_Point_Values[i]);
+		Indexes = _mm_srl_epi32(Values, Shift);
+		Fractions = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm_and_si128(Values, Fraction_Mask)), Scale);
+		
+		// The next entry of the table last entry is the last entry itself, its fractional part is always zero
+		Next_Indexes = _mm_min_epu32(_mm_add_epi32(Indexes, Ones), Last_Index);
+		Low_Temperatures = _mm256_i32gather_pd(Pointer_Table, _mm_mullo_epi32(Indexes, Strides), 8);
+		High_Temperatures = _mm256_i32gather_pd(Pointer_Table, _mm_mullo_epi32(Next_Indexes, Strides), 8);
+		
+		// Keep the table entry of integer values, like the scalar kernel does
+		Temperatures = _mm256_add_pd(Low_Temperatures, _mm256_mul_pd(Fractions, _mm256_sub_pd(High_Temperatures, Low_Temperatures)));
+		Temperatures = _mm256_blendv_pd(Temperatures, Low_Temperatures, _mm256_cmp_pd(Fractions, _mm256_setzero_pd(), _CMP_EQ_OQ));
+		_mm256_storeu_pd(&Pointer_Temperatures[i], Temperatures);
+	}
+	
+	// Convert the remaining values
+	InterpolatorConvertScalar(Pointer_Table, Stride, Fraction_Bits, &Pointer_Fixed_Point_Values[i], &Pointer_Temperatures[i], Count - i);
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+void InterpolatorConvert(const double *Pointer_Table, unsigned int Stride, unsigned int Table_Size, unsigned int Fraction_Bits, const unsigned int *Pointer_Fixed_Point_Values, double *Pointer_Temperatures, unsigned int Count)
+{
+	#if INTERPOLATOR_IS_SIMD_KERNEL_AVAILABLE
+		// The gather indexes are signed 32-bit integers
+		if (__builtin_cpu_supports("avx2") && ((unsigned long long) Table_Size * Stride <= 0x7FFFFFFFULL))
+		{
+			InterpolatorConvertAVX2(Pointer_Table, Stride, Table_Size, Fraction_Bits, Pointer_Fixed_Point_Values, Pointer_Temperatures, Count);
+			return;
+		}
+	#else
+		(void) Table_Size; // Only the SIMD kernel needs the table size
+	#endif
+	InterpolatorConvertScalar(Pointer_Table, Stride, Fraction_Bits, Pointer_Fixed_Point_Values, Pointer_Temperatures, Count);
+}
@@ -0,0 +1,22 @@
+/** @file Interpolator.h
+ * Convert fixed-point fractional ADC values to temperatures by linear interpolation between adjacent lookup table entries, with a gather-based SIMD kernel when the processor supports it.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_INTERPOLATOR_H
+#define H_INTERPOLATOR_H
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Interpolate the temperatures corresponding to fixed-point ADC values. A value whose fractional part is zero gives exactly the table entry.
+ * @param Pointer_Table The temperature corresponding to each integer ADC value (Celsius). The entries don't need to be contiguous, see Stride.
+ * @param Stride How many doubles are between two consecutive table entries (1 for a plain array).
+ * @param Table_Size How many entries are in the table.
+ * @param Fraction_Bits How many low bits of the fixed-point values are the fractional part.
+ * @param Pointer_Fixed_Point_Values The values to convert, they must not be greater than (Table_Size - 1) << Fraction_Bits.
+ * @param Pointer_Temperatures On output, contain the interpolated temperatures (Celsius).
+ * @param Count How many values to convert.
+ */
+void InterpolatorConvert(const double *Pointer_Table, unsigned int Stride, unsigned int Table_Size, unsigned int Fraction_Bits, const unsigned int *Pointer_Fixed_Point_Values, double *Pointer_Temperatures, unsigned int Count);
+
+#endif
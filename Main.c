@@ -2,19 +2,169 @@
  * Compute the ADC lookup table (containing Celsius temperatures) corresponding to a specific thermistor voltage, taking into account the voltage divider the thermistor is connected to.
  * @author Adrien RICCIARDI
  */
+#define _GNU_SOURCE // Needed by the thread affinity functions
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
 #include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/uio.h>
+#include <time.h>
 #include <unistd.h>
+#include "Arena.h"
+#include "AsyncWriter.h"
+#include "Converter.h"
+#include "Expression.h"
+#include "Interpolator.h"
+#include "Packer.h"
+#include "Profile.h"
+#include "Thermistor.h"
+#include "Thermocouple.h"
+#include "Trace.h"
 
 //-------------------------------------------------------------------------------------------------
 // Private constants
 //-------------------------------------------------------------------------------------------------
+/** Minimum allowed amount of ADC steps, the voltage computations divide by the resolution minus one. */
+#define MAIN_MINIMUM_ADC_RESOLUTION 2
 /** Maximum allowed amount of ADC steps. */
 #define MAIN_MAXIMUM_ADC_RESOLUTION 65536 // 16-bit ADC
+/** Maximum allowed amount of forward table temperatures, as many as the biggest DAC lookup table entries. */
+#define MAIN_MAXIMUM_FORWARD_TEMPERATURES_COUNT MAIN_MAXIMUM_ADC_RESOLUTION
 
 /** How many columns in the printed lookup table. */
 #define MAIN_LOOKUP_TABLE_COLUMNS_COUNT 16
+/** How many doubles are between the same column of two consecutive Values array entries. */
+#define MAIN_VALUES_STRIDE (sizeof(TMainComputedValues) / sizeof(double))
+
+/** How many values are processed at the same time by the streaming modes (this allows the compiler to vectorize the computation loops). */
+#define MAIN_STREAM_BLOCK_SIZE 256
+/** The streaming modes input and output buffers size in bytes. */
+#define MAIN_STREAM_BUFFER_SIZE (256 * 1024)
+/** The longest allowed number in a streaming mode input. */
+#define MAIN_STREAM_MAXIMUM_NUMBER_LENGTH 64
+/** The longest string printf() "%lf" can write for a double followed by a separator (the biggest doubles have 309 integer digits). */
+#define MAIN_STREAM_MAXIMUM_PRINTF_NUMBER_LENGTH 330
+
+/** The biggest amount of interleaved channels the conversion mode can process. */
+#define MAIN_CONVERSION_MAXIMUM_CHANNELS_COUNT 4096
+/** The smallest amount of significant digits tried when writing a JSON number (all numbers with this precision are read back unchanged). */
+#define MAIN_JSON_MINIMUM_PRECISION 15
+/** The biggest integer that is exactly represented by a double (2^53). */
+#define MAIN_JSON_MAXIMUM_EXACT_INTEGER 9007199254740992LL
+/** The biggest median filter window size. */
+#define MAIN_CONVERSION_MAXIMUM_MEDIAN_WINDOW_SIZE 15
+/** The biggest amount of fractional bits of the conversion mode fixed-point ADC values. */
+#define MAIN_CONVERSION_MAXIMUM_FRACTION_BITS 16
+/** How many fixed-point ADC values the fractional conversion functions are timed with. */
+#define MAIN_CONVERSION_BENCHMARK_VALUES_COUNT 65536
+/** How many times the fractional conversion functions are timed, the fastest time is kept. */
+#define MAIN_CONVERSION_BENCHMARK_REPETITIONS_COUNT 5
+
+/** The generator first channel temperature period (seconds). */
+#define MAIN_GENERATOR_BASE_PERIOD 60.
+/** How longer each next generator channel temperature period is (seconds), so the channels do not stay in phase. */
+#define MAIN_GENERATOR_PERIOD_STEP 6.
+/** The generator pseudo-random numbers sequence seed, it is fixed so the same parameters always give the same data. */
+#define MAIN_GENERATOR_RANDOM_SEED 0x9E3779B97F4A7C15ULL
+/** How many values a generator block contains at most, a block always contains whole samples. */
+#define MAIN_GENERATOR_BLOCK_VALUES_COUNT 65536
+/** The longest generated value text (the biggest ADC value digits and a separator). */
+#define MAIN_GENERATOR_MAXIMUM_VALUE_LENGTH 9
+/** The generator channels are processed by groups of this many lanes, the channels count is rounded up to a whole number of groups. The constant inner loops trip count lets the compiler vectorize them with the cheap cost model of -O2. */
+#define MAIN_GENERATOR_LANES_COUNT 8
+/** How many per-channel arrays the generator state contains. */
+#define MAIN_GENERATOR_STATE_ARRAYS_COUNT 6
+
+/** The biggest amount of configurations the multi-table emitter can process. */
+#define MAIN_EMITTER_MAXIMUM_CONFIGURATIONS_COUNT 4096
+
+/** How many tables can be computed while the previous ones are being written to their files. */
+#define MAIN_WRITER_BUFFERS_COUNT 16
+/** The longest table file path. */
+#define MAIN_WRITER_MAXIMUM_PATH_LENGTH 4096
+
+/** The biggest amount of threads computing the values. */
+#define MAIN_MAXIMUM_WORKERS_COUNT 256
+/** Each worker computes at least this amount of values, so small tables do not pay for the threads creation. This is the default value, the tuning profile can change it. */
+#define MAIN_WORKER_MINIMUM_VALUES_COUNT 16384
+/** The biggest amount of NUMA nodes the workers can be spread on. */
+#define MAIN_MAXIMUM_NUMA_NODES_COUNT 64
+
+/** How many detail table rows a formatter thread renders at once. This is the default value, the tuning profile can change it. */
+#define MAIN_FORMATTER_ROWS_COUNT 2048
+/** The biggest formatter rows count a tuning profile can set, so the formatter buffer size computation can't overflow. */
+#define MAIN_MAXIMUM_FORMATTER_ROWS_COUNT 1048576
+/** The longest detail table row (the three numbers can be as long as the biggest double). */
+#define MAIN_FORMATTER_MAXIMUM_ROW_LENGTH 1024
+/** A formatter buffer size, it fits typical rows and a row of the longest size. */
+#define MAIN_FORMATTER_BUFFER_SIZE(Rows_Count) ((Rows_Count) * 64 + MAIN_FORMATTER_MAXIMUM_ROW_LENGTH)
+/** The detail table row format. */
+#define MAIN_DETAIL_TABLE_ROW_FORMAT "%d\t\t%lf\t\t%lf\t\t\t%lf\n"
+
+/** The estimated memory used by the program itself (code, libraries, standard streams and static buffers), whatever the job is. */
+#define MAIN_MEMORY_PLANNER_BASE_SIZE (4 * 1024 * 1024)
+/** The estimated memory used by each worker thread (touched stack and thread-local data). */
+#define MAIN_MEMORY_PLANNER_WORKER_SIZE (256 * 1024)
+/** The smallest amount of values computed at once when streaming, below this the budget is considered too small. */
+#define MAIN_MEMORY_PLANNER_MINIMUM_CHUNK_VALUES_COUNT 1024
+/** The biggest amount of values computed at once when the output is always streamed (JSON formats). */
+#define MAIN_MEMORY_PLANNER_STREAMING_CHUNK_VALUES_COUNT 65536
+
+/** How many temperatures are evaluated in a range to find the worst-case ADC step. */
+#define MAIN_PLANNER_RANGE_SAMPLES_COUNT 33
+/** The smallest ADC bit depth tried by the planner. */
+#define MAIN_PLANNER_MINIMUM_ADC_BITS 4
+/** The biggest ADC bit depth tried by the planner (it must fit in MAIN_MAXIMUM_ADC_RESOLUTION). */
+#define MAIN_PLANNER_MAXIMUM_ADC_BITS 16
+/** The smallest voltage divider resistor decade tried by the planner (ohms). */
+#define MAIN_PLANNER_MINIMUM_RESISTOR_DECADE 10.
+/** The biggest voltage divider resistor decade tried by the planner (ohms). */
+#define MAIN_PLANNER_MAXIMUM_RESISTOR_DECADE 100000.
+
+/** The smallest voltage divider resistor value the optimizer can choose (ohms). */
+#define MAIN_OPTIMIZER_MINIMUM_RESISTOR 10.
+/** The biggest voltage divider resistor value the optimizer can choose (ohms). */
+#define MAIN_OPTIMIZER_MAXIMUM_RESISTOR 10000000.
+/** The optimizer stops when the searched interval is smaller than this value (the search is done on the resistor natural logarithm, so this is a relative precision). */
+#define MAIN_OPTIMIZER_TOLERANCE 1e-5
+
+/** How many circuit parameters vary in the yield estimation (the thermistor Beta and R25, and the voltage divider resistor). */
+#define MAIN_YIELD_PARAMETERS_COUNT 3
+/** How many worst-case corners the parameters space has. */
+#define MAIN_YIELD_CORNERS_COUNT (1 << MAIN_YIELD_PARAMETERS_COUNT)
+/** The failure boundary is searched up to this distance from the nominal parameters, in standard deviations. */
+#define MAIN_YIELD_MAXIMUM_DISTANCE 8.
+/** The failure boundary distance precision, in standard deviations. */
+#define MAIN_YIELD_DISTANCE_PRECISION 1e-4
+/** The share of the samples drawn from the nominal parameters distribution, so the failures far from all corners keep a bounded weight (defensive importance sampling). */
+#define MAIN_YIELD_NOMINAL_SAMPLES_SHARE 0.1
+/** How many cross-entropy iterations move each sampling distribution toward the most likely failures. */
+#define MAIN_YIELD_ADAPTATION_ITERATIONS_COUNT 4
+/** How many samples each cross-entropy iteration draws. */
+#define MAIN_YIELD_ADAPTATION_SAMPLES_COUNT 2000
+/** How many samples the failure probability is estimated with. */
+#define MAIN_YIELD_SAMPLES_COUNT 20000
+/** The yield estimation random sequence seed, so the same parameters always give the same estimation. */
+#define MAIN_YIELD_RANDOM_SEED 0x2545F4914F6CDD1DULL
+/** The smallest ADC resolution the yield estimation accepts, the lowest and highest ADC values are not converted so at least one value must remain. */
+#define MAIN_YIELD_MINIMUM_ADC_RESOLUTION 3
+
+/** The autotuner benchmark table size, big enough for all the threads to have work. */
+#define MAIN_TUNER_ADC_RESOLUTION 1048576
+/** How many times each autotuner setting is timed, the fastest time is kept. */
+#define MAIN_TUNER_REPETITIONS_COUNT 3
+/** How many values of each setting the autotuner tries. */
+#define MAIN_TUNER_SETTING_VALUES_COUNT 3
+/** The biggest amount of workers counts the autotuner can try (the powers of two up to the online CPUs count, and the online CPUs count). */
+#define MAIN_TUNER_MAXIMUM_WORKERS_COUNTS 16
 
 //-------------------------------------------------------------------------------------------------
 // Private types
@@ -27,15 +177,235 @@ typedef struct
 	double Thermistor_Temperature; //!< The thermistor temperature (Celsius).
 } TMainComputedValues;
 
+/** A function to minimize.
+ * @param Pointer_Context The objective constant parameters.
+ * @param X The variable to evaluate the objective at.
+ * @return The objective value.
+ */
+typedef double (*TMainObjectiveFunction)(void *Pointer_Context, double X);
+
+/** The constant parameters of the worst-case ADC step objective. */
+typedef struct
+{
+	double Thermistor_Beta_Coefficient; //!< Beta coefficient value.
+	double Thermistor_Reference_Resistance; //!< Thermistor R25 resistor value (ohms).
+	unsigned int ADC_Resolution; //!< The ADC resolution.
+	double Minimum_Temperature; //!< The range lowest temperature (Celsius).
+	double Maximum_Temperature; //!< The range highest temperature (Celsius).
+} TMainWorstADCStepObjectiveContext;
+
+/** The yield estimation problem : a firmware converts the ADC values with the nominal circuit lookup table, and the circuit parameters deviate from their nominal values. */
+typedef struct
+{
+	const double *Pointer_Logarithmic_Resistances; //!< The natural logarithm of the nominal thermistor resistance divided by the nominal R25, for each ADC value of the operating range.
+	const double *Pointer_Table_Temperatures; //!< The nominal lookup table rounded temperature of each ADC value of the operating range (Celsius).
+	unsigned int Values_Count; //!< How many ADC values are in the operating range.
+	double Thermistor_Beta_Coefficient; //!< The nominal Beta coefficient value.
+	double Standard_Deviations[MAIN_YIELD_PARAMETERS_COUNT]; //!< The Beta, R25 and voltage divider resistor relative standard deviations.
+	double Error_Limit; //!< The biggest allowed temperature error (Celsius).
+	unsigned long long Evaluations_Count; //!< How many times the circuit was evaluated.
+} TMainYieldProblem;
+
+/** All parameters needed to compute a lookup table. */
+typedef struct
+{
+	int Circuit_Variant; //!< The selected circuit variant (1 or 2).
+	double Thermistor_Beta_Coefficient; //!< Beta coefficient value.
+	double Thermistor_Reference_Resistance; //!< Thermistor R25 resistor value (ohms).
+	double Voltage_Divider_Resistor; //!< The bridge resistor value in ohms.
+	double Voltage_Divider_Bridge_Voltage; //!< Vcc voltage in volts.
+	unsigned int ADC_Resolution; //!< The ADC resolution.
+} TMainConfiguration;
+
+/** A multi-table emitter lookup table. */
+typedef struct
+{
+	int *Pointer_Temperatures; //!< The rounded temperature corresponding to each ADC value (Celsius).
+	unsigned long long Hash; //!< The hash of the table shape (the table values minus the first value), so tables differing by a constant offset have the same hash.
+	int Shared_Table_Index; //!< The index of the configuration whose table is emitted for this configuration.
+	int Offset; //!< The value to add to the shared table entries to get this table entries.
+} TMainEmitterTable;
+
+/** What the fractional conversion functions need to convert fixed-point ADC values. */
+typedef struct
+{
+	const TMainConfiguration *Pointer_Configuration; //!< The circuit and ADC configuration.
+	const TExpressionProgram *Pointer_Expression_Program; //!< The custom model, NULL to use the thermistor Beta model.
+	const double *Pointer_Table; //!< The computed temperatures to interpolate.
+	unsigned int Table_Stride; //!< How many doubles are between two consecutive temperatures of the table.
+	unsigned int Fraction_Bits; //!< How many low bits of the fixed-point values are the fractional part.
+} TMainFractionalConversion;
+
+/** A NUMA node. */
+typedef struct
+{
+	int Identifier; //!< The node number given by the kernel.
+	cpu_set_t CPUs_Set; //!< All CPUs belonging to the node.
+} TMainNumaNode;
+
+/** A thread computing a range of the values. */
+typedef struct
+{
+	pthread_t Thread; //!< The thread handle.
+	const TMainConfiguration *Pointer_Configuration; //!< The table parameters.
+	const TExpressionProgram *Pointer_Expression_Program; //!< The custom model, or NULL to use the Beta model.
+	unsigned int First_ADC_Value; //!< The first ADC value to compute.
+	unsigned int End_ADC_Value; //!< The ADC value following the last one to compute.
+	unsigned int Values_Offset; //!< The ADC value stored at the beginning of the Values array.
+	int Node_Index; //!< The index of the NUMA node the worker runs on.
+	double Elapsed_Time; //!< How long the computation took (seconds).
+} TMainWorker;
+
+/** How the fractional ADC values are converted. */
+typedef enum
+{
+	MAIN_FRACTIONAL_CONVERSION_METHOD_INTERPOLATION, //!< Interpolate the computed table.
+	MAIN_FRACTIONAL_CONVERSION_METHOD_MODEL, //!< Evaluate the model at the fractional ADC value.
+	MAIN_FRACTIONAL_CONVERSION_METHOD_FASTEST //!< Time both methods at startup and use the fastest one.
+} TMainFractionalConversionMethod;
+
+/** The table output formats. */
+typedef enum
+{
+	MAIN_OUTPUT_FORMAT_TEXT, //!< The human-readable tables.
+	MAIN_OUTPUT_FORMAT_JSON, //!< A single JSON document.
+	MAIN_OUTPUT_FORMAT_NDJSON //!< A JSON object per line.
+} TMainOutputFormat;
+
+/** A thread formatting the detail table. */
+typedef struct
+{
+	pthread_t Thread; //!< The thread handle.
+	pthread_mutex_t *Pointer_Start_Mutex; //!< Held until all formatters are created.
+	pthread_barrier_t *Pointer_Barrier; //!< Synchronize the formatters with the writer at the end of each round.
+	unsigned int First_ADC_Value; //!< The ADC value of the first Values array entry.
+	unsigned int Rows_Count; //!< How many rows all formatters render.
+	unsigned int Formatters_Count; //!< How many formatters there are.
+	unsigned int Index; //!< The formatter index, telling which slice of each round it renders.
+	char *Pointer_Buffers[2]; //!< A buffer is filled while the other one is written.
+	size_t Buffers_Sizes[2]; //!< How many characters are in each buffer.
+	unsigned int Formatted_Rows_Ends[2]; //!< The row following the last formatted row of each buffer.
+	unsigned int Slices_Ends[2]; //!< The row following the slice of each buffer, the writer formats the rows that did not fit in the buffer.
+} TMainFormatter;
+
+/** The generated temperatures trajectories. */
+typedef enum
+{
+	MAIN_GENERATOR_TRAJECTORY_SINE, //!< Each channel temperature follows a sine wave.
+	MAIN_GENERATOR_TRAJECTORY_TRANSIENT //!< Each channel sensor follows an ambient temperature step with a first order thermal model.
+} TMainGeneratorTrajectory;
+
+/** The generator parameters shared by all generator threads. */
+typedef struct
+{
+	const TMainConfiguration *Pointer_Configuration; //!< The circuit and ADC configuration.
+	TMainGeneratorTrajectory Trajectory; //!< The temperatures trajectories.
+	double Start_Temperature; //!< The sine waves lowest temperature, or the sensors initial temperature (Celsius).
+	double End_Temperature; //!< The sine waves highest temperature, or the ambient temperature after the step (Celsius).
+	double Time_Constant; //!< The first channel sensor thermal time constant (seconds), for the transient trajectory.
+	double Sample_Rate; //!< How many samples per second of simulated time.
+	double Noise_Standard_Deviation; //!< The noise standard deviation (ADC steps).
+	unsigned int Channels_Count; //!< How many interleaved channels are generated.
+	unsigned long long Maximum_Samples_Count; //!< Stop after this amount of samples.
+	unsigned long long Maximum_Size; //!< Stop at the end of the sample that reaches this amount of written bytes.
+	double Noise_Scale; //!< The noise standard deviation (volts), computed by MainGenerateADCValues().
+	unsigned int Block_Samples_Count; //!< How many samples a block contains, computed by MainGenerateADCValues().
+} TMainGeneratorParameters;
+
+/** A thread generating a block of samples at each round, the blocks of a round being consecutive. */
+typedef struct
+{
+	pthread_t Thread; //!< The thread handle.
+	pthread_mutex_t *Pointer_Start_Mutex; //!< Held until all generators are created.
+	pthread_barrier_t *Pointer_Barrier; //!< Synchronize the generators with the writer at the end of each round.
+	const unsigned long long *Pointer_Stop_Round; //!< The last round to generate, it is set by the writer.
+	const TMainGeneratorParameters *Pointer_Parameters; //!< The generation parameters.
+	unsigned int Generators_Count; //!< How many generators there are.
+	unsigned int Index; //!< The generator index, telling which block of each round it generates.
+	double *Pointer_Channels_States; //!< Room for the channels phasors, temperatures and voltages.
+	char *Pointer_Buffers[2]; //!< A buffer is filled while the other one is written.
+	size_t Buffers_Sizes[2]; //!< How many characters are in each buffer.
+} TMainGenerator;
+
+/** How a table computation job fits in the memory budget. */
+typedef struct
+{
+	int Is_Streaming_Enabled; //!< Set to 1 when the values are computed and displayed by chunks, set to 0 when the whole table is kept in memory.
+	int Is_Temperature_Only_Retained; //!< Set to 1 when only the temperatures column of the table is kept in memory (conversion mode).
+	unsigned int Chunk_Values_Count; //!< How many values are kept in memory at once.
+	unsigned int Workers_Count; //!< How many threads compute the values.
+	size_t Arena_Size; //!< The memory to map for the values.
+	size_t Estimated_Memory_Size; //!< The job estimated peak memory usage.
+} TMainExecutionPlan;
+
 //-------------------------------------------------------------------------------------------------
 // Private variables
 //-------------------------------------------------------------------------------------------------
-/** All computed values for all requested ADC values. */
-static TMainComputedValues Values[MAIN_MAXIMUM_ADC_RESOLUTION];
+/** All computed values for all requested ADC values (allocated from the arena). */
+static TMainComputedValues *Values;
+
+/** The temperatures column of the table, when the planner did not keep the whole Values array (allocated from the arena). */
+static double *Main_Temperatures;
+
+/** The fractional conversion functions parameters. */
+static TMainFractionalConversion Main_Fractional_Conversion;
+
+/** The thermocouple cold-junction compensation voltages (millivolts) corresponding to each ADC value (the temperatures are first gathered here, then converted in place). It is allocated from the arena. */
+static double *Main_Cold_Junction_Voltages;
+
+/** Each worker computes at least this amount of values, it is set by the tuning profile. */
+static unsigned int Main_Worker_Minimum_Values_Count = MAIN_WORKER_MINIMUM_VALUES_COUNT;
+/** How many detail table rows a formatter thread renders at once, it is set by the tuning profile. */
+static unsigned int Main_Formatter_Rows_Count = MAIN_FORMATTER_ROWS_COUNT;
+
+/** The file the execution trace is written to when the program exits. */
+static const char *Main_Pointer_String_Trace_File_Name;
+
+/** The minimum values counts per worker tried by the autotuner. */
+static const unsigned int Main_Tuner_Worker_Minimum_Values_Counts[MAIN_TUNER_SETTING_VALUES_COUNT] = {4096, 16384, 65536};
+/** The formatter rows counts tried by the autotuner. */
+static const unsigned int Main_Tuner_Formatter_Rows_Counts[MAIN_TUNER_SETTING_VALUES_COUNT] = {512, 2048, 8192};
+
+/** All the program big buffers are allocated from this arena, so they are mapped at once (with huge pages for big tables) and reused between jobs. */
+static TArena Main_Arena;
+
+/** The streaming modes input buffer. */
+static char Main_Stream_Input_Buffer[MAIN_STREAM_BUFFER_SIZE + 1]; // Keep room for a terminating character
+/** The first input buffer character that has not been parsed yet. */
+static unsigned int Main_Stream_Input_Buffer_Index = 0;
+/** How many characters are in the input buffer. */
+static unsigned int Main_Stream_Input_Buffer_Size = 0;
+
+/** The streaming modes output buffer. */
+static char Main_Stream_Output_Buffer[MAIN_STREAM_BUFFER_SIZE];
+/** How many characters are in the output buffer. */
+static unsigned int Main_Stream_Output_Buffer_Size = 0;
+
+/** The conversion mode median filter last samples, for each channel (a channel values are in the same column so all channels can be filtered at once). */
+static double Main_Conversion_Median_History[MAIN_CONVERSION_MAXIMUM_MEDIAN_WINDOW_SIZE][MAIN_CONVERSION_MAXIMUM_CHANNELS_COUNT];
+/** The median filter window being sorted. */
+static double Main_Conversion_Median_Window[MAIN_CONVERSION_MAXIMUM_MEDIAN_WINDOW_SIZE][MAIN_CONVERSION_MAXIMUM_CHANNELS_COUNT];
+
+/** All powers of ten that are exactly represented by a double. */
+static const double Main_JSON_Powers_Of_Ten[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/** All two-digit decimal numbers, to convert integers two digits at a time. */
+static const char Main_Digits_Pairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+/** E12 series standard resistor values (for a single decade). */
+static const double Main_E12_Series_Values[] = {1., 1.2, 1.5, 1.8, 2.2, 2.7, 3.3, 3.9, 4.7, 5.6, 6.8, 8.2};
 
 //-------------------------------------------------------------------------------------------------
 // Private functions
 //-------------------------------------------------------------------------------------------------
+/** Display the program banner. */
+static void MainDisplayBanner(void)
+{
+	puts("+-------------------------------------------------+");
+	puts("| Thermistor calculator (C) 2018 Adrien RICCIARDI |");
+	puts("+-------------------------------------------------+");
+}
+
 /** Display the program usage help.
  * @param Pointer_String_Program_Name The name the program has been executed with.
  */
@@ -63,189 +433,3680 @@ static void MainDisplayProgramUsage(char *Pointer_String_Program_Name)
 		"       |                        |\n"
 		"      GND                      GND\n"
 		"\n"
-		"Usage : %s [-c circuit] [-B beta] [-R R25] [-r resistor] [-v Vcc] [-a resolution] [-h]\n"
+		"Usage : %s [-c circuit] [-B beta] [-R R25] [-r resistor] [-v Vcc] [-a resolution] [-p Tmin:Tmax:step] [-o Tmin:Tmax] [-Y Tmin:Tmax:limit:Btol:R25tol:Rtol] [-k type] [-f Tmin:Tmax:step] [-F] [-x channels] [-g Tmin:Tmax:channels:rate:size] [-s channels:steps:period:tau:Tstart:Tend] [-n deviation] [-m size] [-l coefficient] [-d factor] [-q bits] [-i method] [-e expression] [-j] [-t circuit:beta:R25:resistor:Vcc:resolution] [-W directory] [-y] [-J format] [-b file] [-w workers] [-M bytes] [-S] [-A] [-T file] [-h]\n"
 		"  -c : circuit variant, it can be 1 or 2 (see above for circuit variants description). Default value is 1.\n"
 		"  -B : thermistor Beta coefficient (kelvin), this is the B25/100 value of the datasheet. Default value is 4300.\n"
 		"  -R : thermistor resistance at 25 Celsius degrees (ohm), floating numbers are allowed. Default value is 10000.\n"
 		"  -r : voltage divider bridge other resistance value (ohm), floating numbers are allowed. Default value is 10000.\n"
 		"  -v : Vcc voltage (volt), floating numbers are allowed. Default value is 3.3.\n"
 		"  -a : ADC resolution (or how many values you want in the lookup table). Default value is 256.\n"
-		"  -h : display this help.\n", Pointer_String_Program_Name);
+		"  -p : plan the hardware instead of computing a table : find the smallest ADC resolution and the E12 voltage divider resistor that make one ADC step worth at most 'step' Celsius degrees over the [Tmin; Tmax] Celsius range.\n"
+		"  -o : optimize the voltage divider resistor instead of computing a table : find the resistor value that minimizes the worst-case ADC step over the [Tmin; Tmax] Celsius range, using the configured ADC resolution.\n"
+		"  -Y : estimate the yield instead of computing a table : the probability that a circuit built with toleranced parts converts an ADC value of the [Tmin; Tmax] Celsius range with an error bigger than 'limit' Celsius, when the firmware uses the nominal lookup table. 'Btol', 'R25tol' and 'Rtol' are the Beta coefficient, R25 and voltage divider resistor tolerances in percent, taken as three standard deviations. The Vcc voltage does not matter because the ADC reference is the voltage divider supply. The failures are sampled around the nominal parameters and all the failing worst-case corners (defensive importance sampling), so very small probabilities are estimated with a confidence interval. Example : -Y 0:50:1:1:1:1.\n"
+		"  -k : also display the cold-junction compensation table of a thermocouple whose cold junction temperature is measured by the thermistor. Each entry is the thermocouple voltage (microvolt) at the thermistor temperature, add it to the measured thermocouple voltage before converting it to the hot junction temperature. Supported thermocouple types are K and T.\n"
+		"  -f : compute the forward table instead of the ADC lookup table : display the thermistor resistance, the voltage divider output voltage and the DAC value (the DAC resolution is set with -a) for each temperature of the [Tmin; Tmax] Celsius range, by steps of 'step' Celsius degrees. This allows a DAC to emulate the thermistor.\n"
+		"  -F : stream the forward conversion : read whitespace-separated Celsius temperatures from the standard input and write the corresponding DAC values to the standard output, one per line. The banner is not displayed in this mode.\n"
+		"  -x : convert ADC values to temperatures : read whitespace-separated ADC values of 'channels' interleaved channels from the standard input and write the corresponding Celsius temperatures to the standard output, one line per sample with tab-separated channels. The banner is not displayed in this mode.\n"
+		"  -g : generate synthetic ADC values instead of computing a table, in the conversion mode input format (one line per sample with tab-separated channels), to benchmark and test the conversion. Each of the 'channels' channels temperature follows a sine wave spanning the [Tmin; Tmax] Celsius range, with a period of %g seconds plus %g seconds per previous channel, sampled 'rate' times per simulated second. The temperatures go through the configured thermistor, circuit and ADC, and the generation stops at the end of the sample that reaches 'size' bytes (the k, M and G binary units can be appended). The blocks of samples are generated by the -w threads while the previous ones are written, and the same parameters always give the same values whatever the threads count. The banner is not displayed in this mode.\n"
+		"  -s : simulate a temperature transient instead of computing a table, and write the ADC values like the generator does. The ambient temperature of 'channels' sensors steps from Tstart to Tend Celsius degrees, and each sensor follows it with a first order thermal model of time constant 'tau' seconds multiplied by (1 + channel index / channels), like sensors of different thermal masses. The models are advanced and converted to ADC values 'steps' times, every 'period' seconds of simulated time. The statistics tell how faster than real time the values are written. The banner is not displayed in this mode.\n"
+		"  -n : generator and simulator gaussian noise standard deviation, in ADC steps, added to the voltage before the ADC quantization. Default value is 0 (no noise).\n"
+		"  -m : conversion mode median filter window size (odd number, up to %d), it removes the ADC value spikes before the lookup. Default value is 1 (no filtering).\n"
+		"  -l : conversion mode first order low-pass filter coefficient, in range ]0; 1], it is applied to the temperatures after the lookup. Default value is 1 (no filtering).\n"
+		"  -d : conversion mode decimation factor, only one filtered sample over 'factor' is written. Default value is 1 (no decimation).\n"
+		"  -q : conversion mode reads fixed-point ADC values with 'bits' fractional bits (up to %d), like the ones of an oversampling and averaging ADC. For instance, with 4 bits the value 40 is the ADC value 2.5. The temperatures are interpolated from the computed table by default (see -i). It can't be combined with -j.\n"
+		"  -i : how the -q fractional ADC values are converted. Set 'interpolation' (the default) to linearly interpolate the two nearest table entries, its error is at most one eighth of the table second difference there, which is a small fraction of a Celsius degree except near the table ends where the temperature curve bends the most (the -S option displays the estimated biggest error). Set 'model' to get the exact temperatures by evaluating the model at the fractional ADC value, it is slower. Set 'fastest' to time both methods at startup and use the fastest one on this machine, the chosen method can then change between runs.\n"
+		"  -e : compute the temperatures with a custom model instead of the thermistor Beta model. The expression can use the 'code' (ADC value), 'voltage' (volts) and 'resistance' (ohms) variables, numbers, the + - * / ^ operators, parenthesis and the log(), log10(), exp(), sqrt() and abs() functions. For instance, the default model is \"1 / (log(resistance / 10000) / 4300 + 1 / 298.15) - 273.15\".\n"
+		"  -j : conversion mode uses a conversion function specialized for the computed table, it is compiled with the system compiler (set by the CC environment variable, default is cc) and cached in the user cache directory for this processor. The generic conversion is used for tables of more than %d entries, if the compilation fails or if the cache directory is not private to the user.\n"
+		"  -t : emit C lookup tables for several configurations instead of displaying a single table, repeat this option for each configuration (up to %d). Identical tables and tables that differ only by a constant offset are emitted once and shared by the channel descriptors. The tables use the narrowest signed integer type that holds all their temperatures. The banner is not displayed in this mode.\n"
+		"  -W : write the -t configurations tables to binary files in the specified directory instead of emitting C code, as native-endian signed 16-bit Celsius temperatures (one \"table-<configuration index>.bin\" file per configuration). The files are written asynchronously while the next tables are computed, then synchronized to the storage.\n"
+		"  -y : emit the -t configurations tables as a family instead : the first configuration table is the base table, and the other tables are stored as bit-packed differences to the base table. All configurations must have the same resolution.\n"
+		"  -J : write the table to the standard output as JSON instead of displaying the tables. Set 'json' to get a single document with the parameters, the columns names, the rows, the lookup table and the -k cold-junction compensation table, or 'ndjson' to get a parameters line followed by a line per ADC value (including its tables entries). The tables entries are rounded and saturated like the displayed tables. The numbers are written with the fewest digits that give back the same values, and the output is streamed so any table size can be written with little memory. The banner is not displayed in this mode.\n"
+		"  -b : also write the computed values to a binary file, as native-endian doubles (thermistor voltage, thermistor resistance, thermistor temperature) for each ADC value. Set '-' to write only the binary values to the standard output. This file can be directly mapped by tools like NumPy.\n"
+		"  -w : how many threads compute the values. The threads are spread over the NUMA nodes, each one computing the part of the table that is stored in its node memory, and the same amount of threads format the detail table, spread the same way with their output buffers in their node memory. Default value is the amount of online CPUs, or the tuning profile one (see -A).\n"
+		"  -M : the biggest amount of memory the program can use, in bytes (the k, M and G binary units can be appended). The table is kept in memory when it fits, otherwise it is computed and displayed by chunks (only the temperatures are kept in conversion mode), and the workers count is reduced if needed.\n"
+		"  -S : display statistics on the standard error output (the execution plan, the computation bandwidth of each NUMA node, the tables files writing bandwidth and the peak resident memory).\n"
+		"  -A : benchmark the values computation and the detail table output with several workers counts, minimum values per worker and formatter output buffer sizes, and save the fastest settings of this machine to a tuning profile in the user cache directory. The next runs load the profile at startup, the -w option still overrides the workers count. The profile is not used if the online CPUs count changes.\n"
+		"  -T : record what each thread is doing (computing, formatting, writing or waiting) and write it to the specified file when the program exits, in the Chrome trace event JSON format (open it with chrome://tracing or https://ui.perfetto.dev). Each thread keeps its last 8192 spans.\n"
+		"  -h : display this help.\n", Pointer_String_Program_Name, MAIN_GENERATOR_BASE_PERIOD, MAIN_GENERATOR_PERIOD_STEP, MAIN_CONVERSION_MAXIMUM_MEDIAN_WINDOW_SIZE, MAIN_CONVERSION_MAXIMUM_FRACTION_BITS, CONVERTER_MAXIMUM_TABLE_ENTRIES_COUNT, MAIN_EMITTER_MAXIMUM_CONFIGURATIONS_COUNT);
 }
 
-/** Compute the voltage divider output voltage corresponding to an ADC value.
- * @param Voltage_Divider_Bridge_Voltage Vcc voltage in volts.
- * @param ADC_Resolution The ADC resolution (corresponding to the amount of ADC steps). For instance, set 256 for a 8-bit ADC.
- * @param ADC_Value The ADC value (in range [0; ADC_resolution-1]).
- * @return The corresponding voltage in volts.
+/** Determine the thermistor resistance for a given Celsius temperature (this is the inverse of ThermistorComputeTemperature()).
+ * @param Thermistor_Beta_Coefficient Beta coefficient value.
+ * @param Thermistor_Reference_Resistance Thermistor R25 resistor value (ohms).
+ * @param Thermistor_Temperature The temperature to get resistance from (Celsius).
+ * @return The corresponding resistance (ohms).
  */
-static double MainComputeVoltageDividerOutputVoltage(double Voltage_Divider_Bridge_Voltage, unsigned int ADC_Resolution, unsigned int ADC_Value)
+static double MainComputeThermistorResistanceFromTemperature(double Thermistor_Beta_Coefficient, double Thermistor_Reference_Resistance, double Thermistor_Temperature)
 {
-	return Voltage_Divider_Bridge_Voltage * ADC_Value / (ADC_Resolution - 1); // Subtract 1 to resolution because the maximum reachable ADC value is resolution-1
+	return Thermistor_Reference_Resistance * exp(Thermistor_Beta_Coefficient * ((1. / (THERMISTOR_KELVIN_OFFSET + Thermistor_Temperature)) - (1. / (THERMISTOR_KELVIN_OFFSET + THERMISTOR_REFERENCE_TEMPERATURE))));
 }
 
-/** Compute the thermistor resistance corresponding to a specific voltage divider output voltage.
+/** Compute the voltage divider output voltage corresponding to a specific thermistor resistance (this is the inverse of ThermistorComputeResistance()).
  * @param Circuit_Variant The selected circuit variant (must be 1 or 2).
  * @param Voltage_Divider_Bridge_Voltage Vcc voltage in volts.
- * @param Voltage_Divider_Output_Voltage The voltage divider output voltage to get corresponding thermistor resistance (volts).
+ * @param Thermistor_Resistance The thermistor resistance (ohms).
  * @param Voltage_Divider_Resistor The bridge resistor value in ohms.
- * @return The corresponding thermistor resistance (ohms).
+ * @return The corresponding voltage divider output voltage (volts).
+ */
+static double MainComputeVoltageDividerOutputVoltageFromResistance(int Circuit_Variant, double Voltage_Divider_Bridge_Voltage, double Thermistor_Resistance, double Voltage_Divider_Resistor)
+{
+	// The thermistor is the bottom resistor
+	if (Circuit_Variant == 1) return Voltage_Divider_Bridge_Voltage * Thermistor_Resistance / (Voltage_Divider_Resistor + Thermistor_Resistance);
+	// The thermistor is the top resistor
+	return Voltage_Divider_Bridge_Voltage * Voltage_Divider_Resistor / (Voltage_Divider_Resistor + Thermistor_Resistance);
+}
+
+/** Compute the ADC (or DAC) value corresponding to a voltage (this is the inverse of ThermistorComputeVoltageDividerOutputVoltage()).
+ * @param Voltage_Divider_Bridge_Voltage Vcc voltage in volts, it is also the converter reference voltage.
+ * @param ADC_Resolution The converter resolution (corresponding to the amount of converter steps).
+ * @param Voltage The voltage to convert (volts).
+ * @return The nearest converter value, clamped to [0; ADC_Resolution-1].
+ */
+static unsigned int MainComputeADCValue(double Voltage_Divider_Bridge_Voltage, unsigned int ADC_Resolution, double Voltage)
+{
+	double Value;
+	
+	Value = rint(Voltage * (ADC_Resolution - 1) / Voltage_Divider_Bridge_Voltage);
+	if (!(Value > 0)) return 0; // Also catch NaN values
+	if (Value > ADC_Resolution - 1) return ADC_Resolution - 1;
+	return (unsigned int) Value;
+}
+
+/** Read the next numbers from the standard input, the numbers can be separated by any whitespace character.
+ * @param Pointer_Numbers On output, contain the read numbers.
+ * @param Maximum_Count How many numbers to read at most.
+ * @return How many numbers were read (0 means that the end of the input has been reached),
+ * @return -1 if a malformed number was found,
+ * @return -2 if a number is longer than MAIN_STREAM_MAXIMUM_NUMBER_LENGTH characters.
  */
-static double MainComputeThermistorResistance(int Circuit_Variant, double Voltage_Divider_Bridge_Voltage, double Voltage_Divider_Output_Voltage, double Voltage_Divider_Resistor)
+static int MainReadStreamNumbers(double *Pointer_Numbers, unsigned int Maximum_Count)
 {
-	double Result;
+	unsigned int Count = 0, Remaining_Size, Token_Length;
+	char *Pointer_Token_Start, *Pointer_Token_End;
+	unsigned long long Trace_Start_Time;
 	
-	// Compute voltage divider second resistance value
-	if (Circuit_Variant == 1) Result = Voltage_Divider_Output_Voltage * Voltage_Divider_Resistor / (Voltage_Divider_Bridge_Voltage - Voltage_Divider_Output_Voltage);
-	// Compute voltage divider first resistance value
-	else Result = (Voltage_Divider_Bridge_Voltage * Voltage_Divider_Resistor / Voltage_Divider_Output_Voltage) - Voltage_Divider_Resistor;
+	while (Count < Maximum_Count)
+	{
+		// Skip whitespaces
+		while ((Main_Stream_Input_Buffer_Index < Main_Stream_Input_Buffer_Size) && isspace((unsigned char) Main_Stream_Input_Buffer[Main_Stream_Input_Buffer_Index])) Main_Stream_Input_Buffer_Index++;
+		
+		// Make sure that the whole number is in the buffer, refill the buffer when needed
+		if (Main_Stream_Input_Buffer_Size - Main_Stream_Input_Buffer_Index < MAIN_STREAM_MAXIMUM_NUMBER_LENGTH)
+		{
+			Remaining_Size = Main_Stream_Input_Buffer_Size - Main_Stream_Input_Buffer_Index;
+			memmove(Main_Stream_Input_Buffer, &Main_Stream_Input_Buffer[Main_Stream_Input_Buffer_Index], Remaining_Size);
+			Trace_Start_Time = TraceGetTime();
+			Main_Stream_Input_Buffer_Size = Remaining_Size + fread(&Main_Stream_Input_Buffer[Remaining_Size], 1, MAIN_STREAM_BUFFER_SIZE - Remaining_Size, stdin);
+			TraceRecordSpan(TRACE_SPAN_WAIT, Trace_Start_Time);
+			Main_Stream_Input_Buffer[Main_Stream_Input_Buffer_Size] = 0; // Stop strtod() at the end of the valid data
+			Main_Stream_Input_Buffer_Index = 0;
+			
+			// Skip the whitespaces that could have just been read
+			while ((Main_Stream_Input_Buffer_Index < Main_Stream_Input_Buffer_Size) && isspace((unsigned char) Main_Stream_Input_Buffer[Main_Stream_Input_Buffer_Index])) Main_Stream_Input_Buffer_Index++;
+			if (Main_Stream_Input_Buffer_Index >= Main_Stream_Input_Buffer_Size) break; // End of input
+		}
+		
+		// Find the token end, a longer token could have been cut by the buffer end
+		Pointer_Token_Start = &Main_Stream_Input_Buffer[Main_Stream_Input_Buffer_Index];
+		Token_Length = 0;
+		while ((Main_Stream_Input_Buffer_Index + Token_Length < Main_Stream_Input_Buffer_Size) && !isspace((unsigned char) Pointer_Token_Start[Token_Length]))
+		{
+			Token_Length++;
+			if (Token_Length >= MAIN_STREAM_MAXIMUM_NUMBER_LENGTH) return -2;
+		}
+		
+		// The whole token must be a number
+		Pointer_Numbers[Count] = strtod(Pointer_Token_Start, &Pointer_Token_End);
+		if ((Pointer_Token_End == Pointer_Token_Start) || (Pointer_Token_End != &Pointer_Token_Start[Token_Length])) return -1;
+		Main_Stream_Input_Buffer_Index += Token_Length;
+		Count++;
+	}
 	
-	return Result;
+	return (int) Count;
 }
 
-/** Determine the thermistor Celsius temperature for a given thermistor resistance.
- * @param Thermistor_Beta_Coefficient Beta coefficient value.
- * @param Thermistor_Reference_Resistance Thermistor R25 resistor value (ohms).
- * @param Thermistor_Resistance The resistance to get temperature from (ohms).
- * @return The corresponding temperature (Celsius).
+/** Write the standard output buffer content, then empty it. */
+static void MainFlushStreamOutput(void)
+{
+	unsigned long long Trace_Start_Time = TraceGetTime();
+	
+	fwrite(Main_Stream_Output_Buffer, 1, Main_Stream_Output_Buffer_Size, stdout);
+	Main_Stream_Output_Buffer_Size = 0;
+	TraceRecordSpan(TRACE_SPAN_WRITE, Trace_Start_Time);
+}
+
+/** Convert an unsigned integer to decimal digits.
+ * @param Pointer_Buffer On output, contain the digits, without terminating character. It must have room for 10 characters.
+ * @param Number The number to convert.
+ * @return How many digits were written.
  */
-static double MainComputeThermistorTemperature(double Thermistor_Beta_Coefficient, double Thermistor_Reference_Resistance, double Thermistor_Resistance)
+static inline unsigned int MainFormatUnsignedInteger(char *Pointer_Buffer, unsigned int Number)
 {
-	double Kelvin_Result;
+	char String_Digits[16];
+	unsigned int Digits_Count = 0;
+	
+	// Convert the digits in reverse order from the end of the digits buffer, two digits at a time to halve the divisions
+	while (Number >= 100)
+	{
+		Digits_Count += 2;
+		memcpy(&String_Digits[sizeof(String_Digits) - Digits_Count], &Main_Digits_Pairs[(Number % 100) * 2], 2);
+		Number /= 100;
+	}
+	if (Number >= 10)
+	{
+		Digits_Count += 2;
+		memcpy(&String_Digits[sizeof(String_Digits) - Digits_Count], &Main_Digits_Pairs[Number * 2], 2);
+	}
+	else
+	{
+		Digits_Count++;
+		String_Digits[sizeof(String_Digits) - Digits_Count] = '0' + Number;
+	}
 	
-	Kelvin_Result = 1. / ((log(Thermistor_Resistance / Thermistor_Reference_Resistance) / Thermistor_Beta_Coefficient) + (1. / (273.15 + 25.)));
-	return Kelvin_Result - 273.15;
+	memcpy(Pointer_Buffer, &String_Digits[sizeof(String_Digits) - Digits_Count], Digits_Count);
+	return Digits_Count;
 }
 
-//-------------------------------------------------------------------------------------------------
-// Entry point
-//-------------------------------------------------------------------------------------------------
-int main(int argc, char *argv[])
+/** Append an unsigned integer followed by a new line to the standard output buffer.
+ * @param Number The number to write.
+ */
+static void MainWriteStreamUnsignedInteger(unsigned int Number)
 {
-	unsigned int i, ADC_Resolution = 256;
-	int Circuit_Variant = 1, Parameter, j;
-	double Voltage_Divider_Bridge_Voltage = 3.3, Voltage_Divider_Resistor = 10000., Thermistor_Beta_Coefficient = 4300., Thermistor_Reference_Resistance = 10000.;
+	if (Main_Stream_Output_Buffer_Size + 16 > MAIN_STREAM_BUFFER_SIZE) MainFlushStreamOutput();
 	
-	// Display banner
-	puts("+-------------------------------------------------+");
-	puts("| Thermistor calculator (C) 2018 Adrien RICCIARDI |");
-	puts("+-------------------------------------------------+");
+	Main_Stream_Output_Buffer_Size += MainFormatUnsignedInteger(&Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size], Number);
+	Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size] = '\n';
+	Main_Stream_Output_Buffer_Size++;
+}
+
+/** Append a string to the standard output buffer.
+ * @param Pointer_String The string to write.
+ */
+static void MainWriteStreamString(const char *Pointer_String)
+{
+	while (*Pointer_String != 0)
+	{
+		if (Main_Stream_Output_Buffer_Size >= MAIN_STREAM_BUFFER_SIZE) MainFlushStreamOutput();
+		Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size] = *Pointer_String;
+		Main_Stream_Output_Buffer_Size++;
+		Pointer_String++;
+	}
+}
+
+/** Append a JSON string (surrounded by quotes and with the special characters escaped) to the standard output buffer.
+ * @param Pointer_String The string to write.
+ */
+static void MainWriteStreamJSONString(const char *Pointer_String)
+{
+	static const char String_Hexadecimal_Digits[] = "0123456789abcdef";
+	unsigned char Character;
 	
-	// Extract parameters
-	while (1)
+	MainWriteStreamString("\"");
+	while (*Pointer_String != 0)
 	{
-		Parameter = getopt(argc, argv, "B:R:a:c:hr:v:");
-		if (Parameter == -1) break;
+		// Keep room for the longest escape sequence
+		if (Main_Stream_Output_Buffer_Size + 6 > MAIN_STREAM_BUFFER_SIZE) MainFlushStreamOutput();
 		
-		switch (Parameter)
+		Character = (unsigned char) *Pointer_String;
+		if ((Character == '"') || (Character == '\\'))
 		{
-			case 'B':
-				if (sscanf(optarg, "%lf", &Thermistor_Beta_Coefficient) != 1)
-				{
-					printf("Error : invalid thermistor beta coefficient value.\n\n");
-					MainDisplayProgramUsage(argv[0]);
-					return EXIT_FAILURE;
-				}
-				break;
-				
-			case 'R':
-				if (sscanf(optarg, "%lf", &Thermistor_Reference_Resistance) != 1)
-				{
-					printf("Error : invalid thermistor reference resistance (R25) value.\n\n");
-					MainDisplayProgramUsage(argv[0]);
-					return EXIT_FAILURE;
-				}
-				break;
-			
-			case 'a':
-				if (sscanf(optarg, "%u", &ADC_Resolution) != 1)
-				{
-					printf("Error : invalid ADC resolution value.\n\n");
-					MainDisplayProgramUsage(argv[0]);
-					return EXIT_FAILURE;
-				}
-				// Make sure the results array has enough room
-				if (ADC_Resolution > MAIN_MAXIMUM_ADC_RESOLUTION)
-				{
-					printf("Error : maximum allowed ADC resolution is %u.\n", MAIN_MAXIMUM_ADC_RESOLUTION);
-					return EXIT_FAILURE;
-				}
-				break;
-				
-			case 'c':
-				if (sscanf(optarg, "%d", &Circuit_Variant) != 1)
-				{
-					printf("Error : invalid circuit variant value.\n\n");
-					MainDisplayProgramUsage(argv[0]);
-					return EXIT_FAILURE;
-				}
-				if ((Circuit_Variant < 1) || (Circuit_Variant > 2))
-				{
-					printf("Error : circuit variant value must be 1 or 2.\n\n");
-					MainDisplayProgramUsage(argv[0]);
-					return EXIT_FAILURE;
-				}
-				break;
-				
-			case 'h':
-				MainDisplayProgramUsage(argv[0]);
-				return EXIT_SUCCESS;
-				
-			case 'r':
-				if (sscanf(optarg, "%lf", &Voltage_Divider_Resistor) != 1)
-				{
-					printf("Error : invalid voltage divider resistor value.\n\n");
-					MainDisplayProgramUsage(argv[0]);
-					return EXIT_FAILURE;
-				}
-				break;
-				
-			case 'v':
-				if (sscanf(optarg, "%lf", &Voltage_Divider_Bridge_Voltage) != 1)
-				{
-					printf("Error : invalid voltage divider bridge voltage value.\n\n");
-					MainDisplayProgramUsage(argv[0]);
-					return EXIT_FAILURE;
-				}
-				break;
-				
-			case '?':
-				putchar('\n');
-				MainDisplayProgramUsage(argv[0]);
-				return EXIT_FAILURE;
-			
-			default:
-				break;
+			Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size] = '\\';
+			Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size + 1] = (char) Character;
+			Main_Stream_Output_Buffer_Size += 2;
+		}
+		else if (Character < ' ')
+		{
+			memcpy(&Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size], "\\u00", 4);
+			Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size + 4] = String_Hexadecimal_Digits[Character >> 4];
+			Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size + 5] = String_Hexadecimal_Digits[Character & 0x0F];
+			Main_Stream_Output_Buffer_Size += 6;
+		}
+		else
+		{
+			Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size] = (char) Character;
+			Main_Stream_Output_Buffer_Size++;
 		}
+		Pointer_String++;
 	}
+	MainWriteStreamString("\"");
+}
+
+/** Append a JSON number to the standard output buffer, using the shortest representation that is read back as the same double. The numbers JSON can't represent (infinite values and NaN) are written as null.
+ * @param Number The number to write.
+ */
+static void MainWriteStreamJSONNumber(double Number)
+{
+	char String_Digits[48];
+	int Digits_Count = 0, Precision, Length, Exponent, Scale_Exponent;
+	long long Integer, Candidate;
 	
-	// Compute values
-	for (i = 0; i < ADC_Resolution; i++)
+	if (Main_Stream_Output_Buffer_Size + MAIN_STREAM_MAXIMUM_NUMBER_LENGTH > MAIN_STREAM_BUFFER_SIZE) MainFlushStreamOutput();
+	
+	if (!isfinite(Number))
 	{
-		Values[i].Voltage_Divider_Output_Voltage = MainComputeVoltageDividerOutputVoltage(Voltage_Divider_Bridge_Voltage, ADC_Resolution, i);
-		Values[i].Thermistor_Resistance = MainComputeThermistorResistance(Circuit_Variant, Voltage_Divider_Bridge_Voltage, Values[i].Voltage_Divider_Output_Voltage, Voltage_Divider_Resistor);
-		Values[i].Thermistor_Temperature = MainComputeThermistorTemperature(Thermistor_Beta_Coefficient, Thermistor_Reference_Resistance, Values[i].Thermistor_Resistance);
+		memcpy(&Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size], "null", 4);
+		Main_Stream_Output_Buffer_Size += 4;
+		return;
 	}
 	
-	// Display results
-	printf("ADC value	Thermistor voltage (V)	Thermistor resistance (ohm)	Thermistor temperature (Celsius)\n");
-	for (i = 0; i < ADC_Resolution; i++) printf("%d		%lf		%lf			%lf\n", i, Values[i].Voltage_Divider_Output_Voltage, Values[i].Thermistor_Resistance, Values[i].Thermistor_Temperature);
+	// Integers are common (the ADC values, the lookup table), convert them directly
+	if ((fabs(Number) < 1e15) && (Number == (double) (long long) Number) && !((Number == 0) && signbit(Number)))
+	{
+		Integer = (long long) Number;
+		if (Integer < 0)
+		{
+			Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size] = '-';
+			Main_Stream_Output_Buffer_Size++;
+			Integer = -Integer;
+		}
+		do
+		{
+			String_Digits[Digits_Count] = '0' + (Integer % 10);
+			Digits_Count++;
+			Integer /= 10;
+		} while (Integer > 0);
+		while (Digits_Count > 0)
+		{
+			Digits_Count--;
+			Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size] = String_Digits[Digits_Count];
+			Main_Stream_Output_Buffer_Size++;
+		}
+		return;
+	}
 	
-	// Display ADC table
-	printf("\nADC lookup table :\n");
-	i = 0;
-	while (i < ADC_Resolution)
+	// Most numbers can be scaled by an exact power of ten to an integer mantissa, which is written with the decimal point inserted. The division of two exact doubles is correctly rounded like strtod() is, so the mantissa gives back the number if the division does
+	Exponent = (int) floor(log10(fabs(Number)));
+	for (Precision = MAIN_JSON_MINIMUM_PRECISION; Precision < 17; Precision++)
 	{
-		for (j = 0; j < MAIN_LOOKUP_TABLE_COLUMNS_COUNT; j++)
+		Scale_Exponent = Precision - 1 - Exponent;
+		if ((Scale_Exponent < 0) || (Scale_Exponent > 22)) break; // Only the powers of ten up to 1e22 are exact doubles
+		Integer = llrint(Number * Main_JSON_Powers_Of_Ten[Scale_Exponent]);
+		if ((Integer >= MAIN_JSON_MAXIMUM_EXACT_INTEGER) || (Integer <= -MAIN_JSON_MAXIMUM_EXACT_INTEGER)) break;
+		
+		// The scaling is rounded, so the correctly rounded mantissa can be a neighbor
+		for (Candidate = Integer - 1; Candidate <= Integer + 1; Candidate++)
 		{
-			// Stop displaying when there is no more data to display
-			if (i >= ADC_Resolution) break;
-			
-			printf("%4d, ", (int) lrint(Values[i].Thermistor_Temperature));
-			i++;
+			if ((double) Candidate / Main_JSON_Powers_Of_Ten[Scale_Exponent] == Number) break;
 		}
-		putchar('\n');
+		if (Candidate > Integer + 1) continue;
+		Integer = Candidate;
+		
+		if (Integer < 0)
+		{
+			Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size] = '-';
+			Main_Stream_Output_Buffer_Size++;
+			Integer = -Integer;
+		}
+		
+		// Convert the digits in reverse order, skipping the trailing fractional zeros, there is always an integer digit
+		while ((Scale_Exponent > 0) && (Integer % 10 == 0))
+		{
+			Integer /= 10;
+			Scale_Exponent--;
+		}
+		do
+		{
+			if ((Digits_Count == Scale_Exponent) && (Scale_Exponent > 0))
+			{
+				String_Digits[Digits_Count] = '.';
+				Digits_Count++;
+			}
+			String_Digits[Digits_Count] = '0' + (Integer % 10);
+			Digits_Count++;
+			Integer /= 10;
+		} while ((Integer > 0) || (Digits_Count <= Scale_Exponent));
+		while (Digits_Count > 0)
+		{
+			Digits_Count--;
+			Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size] = String_Digits[Digits_Count];
+			Main_Stream_Output_Buffer_Size++;
+		}
+		return;
+	}
+	
+	// 17 significant digits always give back the same double, try the shorter representations first (the ones that failed above are not tried again)
+	for ( ; ; Precision++)
+	{
+		Length = snprintf(&Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size], MAIN_STREAM_MAXIMUM_NUMBER_LENGTH, "%.*g", Precision, Number);
+		if ((Precision >= 17) || (strtod(&Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size], NULL) == Number)) break;
+	}
+	Main_Stream_Output_Buffer_Size += Length;
+}
+
+/** Append a floating number with 6 decimals (like printf() "%lf" does) followed by a separator to the standard output buffer.
+ * @param Number The number to write.
+ * @param Separator The character to append after the number.
+ */
+static void MainWriteStreamDouble(double Number, char Separator)
+{
+	char String_Digits[24];
+	int Digits_Count = 0;
+	long long Micro_Units;
+	
+	if (Main_Stream_Output_Buffer_Size + sizeof(String_Digits) + 2 > MAIN_STREAM_BUFFER_SIZE) MainFlushStreamOutput();
+	
+	// Let the C library handle the numbers that do not fit in the fast path, they can be a lot longer
+	if (!(fabs(Number) < 1e12))
+	{
+		if (Main_Stream_Output_Buffer_Size + MAIN_STREAM_MAXIMUM_PRINTF_NUMBER_LENGTH > MAIN_STREAM_BUFFER_SIZE) MainFlushStreamOutput();
+		Main_Stream_Output_Buffer_Size += sprintf(&Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size], "%lf%c", Number, Separator);
+		return;
 	}
 	
+	Micro_Units = llrint(Number * 1000000.);
+	if (Micro_Units < 0)
+	{
+		Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size] = '-';
+		Main_Stream_Output_Buffer_Size++;
+		Micro_Units = -Micro_Units;
+	}
+	else if (signbit(Number)) // Keep the sign of small negative numbers, like printf() does
+	{
+		Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size] = '-';
+		Main_Stream_Output_Buffer_Size++;
+	}
+	
+	// Convert the digits in reverse order, there are always 6 decimals and at least one integer digit
+	do
+	{
+		if (Digits_Count == 6)
+		{
+			String_Digits[Digits_Count] = '.';
+			Digits_Count++;
+		}
+		String_Digits[Digits_Count] = '0' + (Micro_Units % 10);
+		Digits_Count++;
+		Micro_Units /= 10;
+	} while ((Micro_Units > 0) || (Digits_Count < 8));
+	
+	while (Digits_Count > 0)
+	{
+		Digits_Count--;
+		Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size] = String_Digits[Digits_Count];
+		Main_Stream_Output_Buffer_Size++;
+	}
+	Main_Stream_Output_Buffer[Main_Stream_Output_Buffer_Size] = Separator;
+	Main_Stream_Output_Buffer_Size++;
+}
+
+/** Compute the DAC values corresponding to many thermistor temperatures.
+ * @param Circuit_Variant The selected circuit variant (must be 1 or 2).
+ * @param Voltage_Divider_Bridge_Voltage Vcc voltage in volts.
+ * @param Voltage_Divider_Resistor The bridge resistor value in ohms.
+ * @param Thermistor_Beta_Coefficient Beta coefficient value.
+ * @param Thermistor_Reference_Resistance Thermistor R25 resistor value (ohms).
+ * @param DAC_Resolution The DAC resolution.
+ * @param Pointer_Temperatures The temperatures to convert (Celsius). The array content is overwritten by the voltage divider output voltages.
+ * @param Pointer_DAC_Values On output, contain the DAC values.
+ * @param Count How many temperatures to convert.
+ */
+static void MainComputeDACValues(int Circuit_Variant, double Voltage_Divider_Bridge_Voltage, double Voltage_Divider_Resistor, double Thermistor_Beta_Coefficient, double Thermistor_Reference_Resistance, unsigned int DAC_Resolution, double *Pointer_Temperatures, unsigned int *Pointer_DAC_Values, unsigned int Count)
+{
+	unsigned int i;
+	
+	// Each step is done on the whole block to keep the loops simple enough to be vectorized
+	for (i = 0; i < Count; i++) Pointer_Temperatures[i] = MainComputeThermistorResistanceFromTemperature(Thermistor_Beta_Coefficient, Thermistor_Reference_Resistance, Pointer_Temperatures[i]);
+	for (i = 0; i < Count; i++) Pointer_Temperatures[i] = MainComputeVoltageDividerOutputVoltageFromResistance(Circuit_Variant, Voltage_Divider_Bridge_Voltage, Pointer_Temperatures[i], Voltage_Divider_Resistor);
+	for (i = 0; i < Count; i++) Pointer_DAC_Values[i] = MainComputeADCValue(Voltage_Divider_Bridge_Voltage, DAC_Resolution, Pointer_Temperatures[i]);
+}
+
+/** Convert the temperatures read from the standard input to DAC values written to the standard output.
+ * @param Circuit_Variant The selected circuit variant (must be 1 or 2).
+ * @param Voltage_Divider_Bridge_Voltage Vcc voltage in volts.
+ * @param Voltage_Divider_Resistor The bridge resistor value in ohms.
+ * @param Thermistor_Beta_Coefficient Beta coefficient value.
+ * @param Thermistor_Reference_Resistance Thermistor R25 resistor value (ohms).
+ * @param DAC_Resolution The DAC resolution.
+ * @return 0 on success,
+ * @return -1 if the input contains something that is not a number.
+ */
+static int MainStreamForwardConversion(int Circuit_Variant, double Voltage_Divider_Bridge_Voltage, double Voltage_Divider_Resistor, double Thermistor_Beta_Coefficient, double Thermistor_Reference_Resistance, unsigned int DAC_Resolution)
+{
+	double Temperatures[MAIN_STREAM_BLOCK_SIZE];
+	unsigned int DAC_Values[MAIN_STREAM_BLOCK_SIZE];
+	int Count, i;
+	
+	while (1)
+	{
+		Count = MainReadStreamNumbers(Temperatures, MAIN_STREAM_BLOCK_SIZE);
+		if (Count < 0)
+		{
+			MainFlushStreamOutput();
+			if (Count == -2) fprintf(stderr, "Error : the input contains a temperature longer than %d characters.\n", MAIN_STREAM_MAXIMUM_NUMBER_LENGTH - 1);
+			else fprintf(stderr, "Error : the input contains an invalid temperature.\n");
+			return -1;
+		}
+		if (Count == 0) break;
+		
+		MainComputeDACValues(Circuit_Variant, Voltage_Divider_Bridge_Voltage, Voltage_Divider_Resistor, Thermistor_Beta_Coefficient, Thermistor_Reference_Resistance, DAC_Resolution, Temperatures, DAC_Values, Count);
+		for (i = 0; i < Count; i++) MainWriteStreamUnsignedInteger(DAC_Values[i]);
+	}
+	
+	MainFlushStreamOutput();
+	return 0;
+}
+
+/** Convert a bytes count, optionally followed by the k, M or G binary unit, to a number.
+ * @param Pointer_String The string to convert.
+ * @param Pointer_Bytes_Count On output, contain the bytes count.
+ * @return 0 on success,
+ * @return -1 if the string is not a positive bytes count.
+ */
+static int MainParseBytesCount(const char *Pointer_String, double *Pointer_Bytes_Count)
+{
+	double Bytes_Count;
+	char Unit = 'B';
+	
+	if (sscanf(Pointer_String, "%lf%c", &Bytes_Count, &Unit) < 1) return -1;
+	if (Unit == 'k') Bytes_Count *= 1024.;
+	else if (Unit == 'M') Bytes_Count *= 1024. * 1024.;
+	else if (Unit == 'G') Bytes_Count *= 1024. * 1024. * 1024.;
+	else if (Unit != 'B') return -1;
+	if (!(Bytes_Count >= 1.)) return -1;
+	
+	*Pointer_Bytes_Count = Bytes_Count;
+	return 0;
+}
+
+/** Get the current time.
+ * @return A monotonic time in seconds.
+ */
+static double MainGetTime(void)
+{
+	struct timespec Time;
+	
+	clock_gettime(CLOCK_MONOTONIC, &Time);
+	return Time.tv_sec + Time.tv_nsec / 1000000000.;
+}
+
+/** Write the computed values to a binary file, without any conversion.
+ * @param Pointer_String_File_Name The file to write to, "-" means the standard output.
+ * @param ADC_Resolution How many values to write.
+ * @return 0 on success,
+ * @return -1 if the file could not be written.
+ */
+static int MainWriteBinaryValues(const char *Pointer_String_File_Name, unsigned int ADC_Resolution)
+{
+	FILE *Pointer_File;
+	int Result = 0;
+	
+	if (strcmp(Pointer_String_File_Name, "-") == 0) Pointer_File = stdout;
+	else
+	{
+		Pointer_File = fopen(Pointer_String_File_Name, "wb");
+		if (Pointer_File == NULL) return -1;
+	}
+	
+	if (fwrite(Values, sizeof(Values[0]), ADC_Resolution, Pointer_File) != ADC_Resolution) Result = -1;
+	
+	if (Pointer_File == stdout)
+	{
+		if (fflush(stdout) != 0) Result = -1;
+	}
+	else if (fclose(Pointer_File) != 0) Result = -1;
+	return Result;
+}
+
+/** Convert ADC values to temperatures using the Values array (this is the generic conversion function, the table size is the ADC resolution given to MainStreamConversion()).
+ * @param Pointer_ADC_Values The ADC values to convert, they must all be lower than the ADC resolution.
+ * @param Pointer_Temperatures On output, contain the corresponding temperatures (Celsius).
+ * @param Count How many values to convert.
+ */
+static void MainConvertADCValues(const unsigned int *Pointer_ADC_Values, double *Pointer_Temperatures, unsigned int Count)
+{
+	unsigned int i;
+	
+	for (i = 0; i < Count; i++) Pointer_Temperatures[i] = Values[Pointer_ADC_Values[i]].Thermistor_Temperature;
+}
+
+/** Convert ADC values to temperatures using the Main_Temperatures array, this is the generic conversion function used when only the temperatures column is kept in memory.
+ * @param Pointer_ADC_Values The ADC values to convert, they must all be lower than the ADC resolution.
+ * @param Pointer_Temperatures On output, contain the corresponding temperatures (Celsius).
+ * @param Count How many values to convert.
+ */
+static void MainConvertADCValuesFromTemperatures(const unsigned int *Pointer_ADC_Values, double *Pointer_Temperatures, unsigned int Count)
+{
+	unsigned int i;
+	
+	for (i = 0; i < Count; i++) Pointer_Temperatures[i] = Main_Temperatures[Pointer_ADC_Values[i]];
+}
+
+/** Convert fixed-point ADC values to temperatures by interpolating the computed table, this is a fractional conversion function.
+ * @param Pointer_ADC_Values The fixed-point ADC values to convert, with Main_Fractional_Conversion.Fraction_Bits fractional bits.
+ * @param Pointer_Temperatures On output, contain the corresponding temperatures (Celsius).
+ * @param Count How many values to convert.
+ */
+static void MainConvertFractionalADCValuesByInterpolation(const unsigned int *Pointer_ADC_Values, double *Pointer_Temperatures, unsigned int Count)
+{
+	InterpolatorConvert(Main_Fractional_Conversion.Pointer_Table, Main_Fractional_Conversion.Table_Stride, Main_Fractional_Conversion.Pointer_Configuration->ADC_Resolution, Main_Fractional_Conversion.Fraction_Bits, Pointer_ADC_Values, Pointer_Temperatures, Count);
+}
+
+/** Convert fixed-point ADC values to temperatures by evaluating the model at the fractional ADC values, this is a fractional conversion function.
+ * @param Pointer_ADC_Values The fixed-point ADC values to convert, with Main_Fractional_Conversion.Fraction_Bits fractional bits.
+ * @param Pointer_Temperatures On output, contain the corresponding temperatures (Celsius).
+ * @param Count How many values to convert.
+ */
+static void MainConvertFractionalADCValuesByModel(const unsigned int *Pointer_ADC_Values, double *Pointer_Temperatures, unsigned int Count)
+{
+	const TMainConfiguration *Pointer_Configuration = Main_Fractional_Conversion.Pointer_Configuration;
+	double Codes[EXPRESSION_BLOCK_SIZE], Voltages[EXPRESSION_BLOCK_SIZE], Resistances[EXPRESSION_BLOCK_SIZE], Scale = 1. / (1U << Main_Fractional_Conversion.Fraction_Bits);
+	unsigned int i, j, Block_Size;
+	
+	// Compute the values by blocks to feed the expression interpreter, the same way the table is computed
+	for (i = 0; i < Count; i += Block_Size)
+	{
+		Block_Size = Count - i < EXPRESSION_BLOCK_SIZE ? Count - i : EXPRESSION_BLOCK_SIZE;
+		for (j = 0; j < Block_Size; j++)
+		{
+			Codes[j] = Pointer_ADC_Values[i + j] * Scale;
+			Voltages[j] = Pointer_Configuration->Voltage_Divider_Bridge_Voltage * Codes[j] / (Pointer_Configuration->ADC_Resolution - 1);
+			Resistances[j] = ThermistorComputeResistance(Pointer_Configuration->Circuit_Variant, Pointer_Configuration->Voltage_Divider_Bridge_Voltage, Voltages[j], Pointer_Configuration->Voltage_Divider_Resistor);
+		}
+		
+		if (Main_Fractional_Conversion.Pointer_Expression_Program != NULL) ExpressionEvaluate(Main_Fractional_Conversion.Pointer_Expression_Program, Codes, Voltages, Resistances, &Pointer_Temperatures[i], Block_Size);
+		else
+		{
+			for (j = 0; j < Block_Size; j++) Pointer_Temperatures[i + j] = ThermistorComputeTemperature(Pointer_Configuration->Thermistor_Beta_Coefficient, Pointer_Configuration->Thermistor_Reference_Resistance, Resistances[j]);
+		}
+	}
+}
+
+/** Estimate the biggest error of the table interpolation : the linear interpolation error between two entries is at most one eighth of the temperature second difference there. The segments touching the table ends are not taken into account, because the first and last ADC values do not correspond to a finite thermistor resistance.
+ * @return The estimated biggest interpolation error (Celsius).
+ */
+static double MainEstimateInterpolationError(void)
+{
+	const double *Pointer_Table = Main_Fractional_Conversion.Pointer_Table;
+	unsigned int i, Stride = Main_Fractional_Conversion.Table_Stride, ADC_Resolution = Main_Fractional_Conversion.Pointer_Configuration->ADC_Resolution;
+	double Second_Difference, Maximum_Second_Difference = 0;
+	
+	for (i = 2; i + 2 < ADC_Resolution; i++)
+	{
+		Second_Difference = fabs(Pointer_Table[(size_t) (i - 1) * Stride] - 2. * Pointer_Table[(size_t) i * Stride] + Pointer_Table[(size_t) (i + 1) * Stride]);
+		if (Second_Difference > Maximum_Second_Difference) Maximum_Second_Difference = Second_Difference; // NaN values are skipped by the comparison
+	}
+	return Maximum_Second_Difference / 8.;
+}
+
+/** Choose the fractional conversion function. The forced methods always give the same function, only the fastest method times the conversion functions on this machine. The functions are then called with as many values as there are channels, like the conversion mode does.
+ * @param Method How to choose the function.
+ * @param Channels_Count How many interleaved channels are converted at once.
+ * @param Is_Statistics_Display_Enabled Set to 1 to display the chosen method, the estimated interpolation error and the measured speeds on the standard error output.
+ * @return The conversion function.
+ */
+static TConverterFunction MainSelectFractionalConversionFunction(TMainFractionalConversionMethod Method, unsigned int Channels_Count, int Is_Statistics_Display_Enabled)
+{
+	static unsigned int Fixed_Point_Values[MAIN_CONVERSION_BENCHMARK_VALUES_COUNT];
+	static double Temperatures[MAIN_CONVERSION_BENCHMARK_VALUES_COUNT];
+	TConverterFunction Functions[2] = {MainConvertFractionalADCValuesByInterpolation, MainConvertFractionalADCValuesByModel};
+	const char *Pointer_Strings_Names[2] = {"table interpolation", "model evaluation"};
+	unsigned long long Values_Count;
+	double Times[2], Start_Time, Elapsed_Time;
+	unsigned int i, Block_Size;
+	int j, Repetition, Selected_Index;
+	
+	if (Method == MAIN_FRACTIONAL_CONVERSION_METHOD_FASTEST)
+	{
+		// Spread the values over the whole range in a scattered order, so the table is not read sequentially
+		Values_Count = ((unsigned long long) (Main_Fractional_Conversion.Pointer_Configuration->ADC_Resolution - 1) << Main_Fractional_Conversion.Fraction_Bits) + 1;
+		for (i = 0; i < MAIN_CONVERSION_BENCHMARK_VALUES_COUNT; i++) Fixed_Point_Values[i] = (unsigned int) ((i * 2654435761ULL) % Values_Count);
+		
+		for (j = 0; j < 2; j++)
+		{
+			Times[j] = HUGE_VAL;
+			for (Repetition = 0; Repetition < MAIN_CONVERSION_BENCHMARK_REPETITIONS_COUNT; Repetition++)
+			{
+				Start_Time = MainGetTime();
+				for (i = 0; i < MAIN_CONVERSION_BENCHMARK_VALUES_COUNT; i += Block_Size)
+				{
+					Block_Size = MAIN_CONVERSION_BENCHMARK_VALUES_COUNT - i < Channels_Count ? MAIN_CONVERSION_BENCHMARK_VALUES_COUNT - i : Channels_Count;
+					Functions[j](&Fixed_Point_Values[i], &Temperatures[i], Block_Size);
+				}
+				Elapsed_Time = MainGetTime() - Start_Time;
+				if (Elapsed_Time < Times[j]) Times[j] = Elapsed_Time;
+			}
+		}
+		Selected_Index = Times[0] <= Times[1] ? 0 : 1;
+		if (Is_Statistics_Display_Enabled) fprintf(stderr, "Fractional conversion : %s %.2f ns/value, %s %.2f ns/value.\n", Pointer_Strings_Names[0], Times[0] * 1e9 / MAIN_CONVERSION_BENCHMARK_VALUES_COUNT, Pointer_Strings_Names[1], Times[1] * 1e9 / MAIN_CONVERSION_BENCHMARK_VALUES_COUNT);
+	}
+	else Selected_Index = Method == MAIN_FRACTIONAL_CONVERSION_METHOD_INTERPOLATION ? 0 : 1;
+	
+	if (Is_Statistics_Display_Enabled)
+	{
+		if (Selected_Index == 0) fprintf(stderr, "Fractional conversion : using the %s, estimated error up to %g Celsius.\n", Pointer_Strings_Names[0], MainEstimateInterpolationError());
+		else fprintf(stderr, "Fractional conversion : using the %s.\n", Pointer_Strings_Names[1]);
+	}
+	return Functions[Selected_Index];
+}
+
+/** Convert the ADC values read from the standard input to temperatures written to the standard output, going through the signal conditioning pipeline : median filter on the ADC values, lookup, low-pass filter on the temperatures, and decimation.
+ * Each stage processes all channels of a sample at once, so the channels loops can be vectorized and the data is read only once.
+ * @param ADC_Resolution The ADC resolution, the Values array must contain this amount of computed values.
+ * @param Fraction_Bits How many low bits of the input ADC values are the fractional part, set 0 for integer ADC values.
+ * @param Channels_Count How many interleaved channels are in the input.
+ * @param Median_Window_Size The median filter window size (must be odd), set 1 to disable the filter.
+ * @param Low_Pass_Coefficient The low-pass filter coefficient, set 1 to disable the filter.
+ * @param Decimation_Factor Write one sample over this amount of samples.
+ * @param Conversion_Function The function converting the ADC values to temperatures.
+ * @return 0 on success,
+ * @return -1 if the input is invalid.
+ */
+static int MainStreamConversion(unsigned int ADC_Resolution, unsigned int Fraction_Bits, unsigned int Channels_Count, int Median_Window_Size, double Low_Pass_Coefficient, unsigned int Decimation_Factor, TConverterFunction Conversion_Function)
+{
+	static double Samples[MAIN_CONVERSION_MAXIMUM_CHANNELS_COUNT], Filtered_Temperatures[MAIN_CONVERSION_MAXIMUM_CHANNELS_COUNT];
+	static unsigned int ADC_Values[MAIN_CONVERSION_MAXIMUM_CHANNELS_COUNT];
+	double Minimum, Maximum;
+	unsigned int i, Samples_Count = 0, Maximum_ADC_Value = (ADC_Resolution - 1) << Fraction_Bits;
+	int Count, History_Index = 0, j, k, Pass;
+	
+	while (1)
+	{
+		// Read all channels values of the next sample
+		Count = MainReadStreamNumbers(Samples, Channels_Count);
+		if (Count == 0) break;
+		if (Count != (int) Channels_Count)
+		{
+			MainFlushStreamOutput();
+			if (Count == -2) fprintf(stderr, "Error : the input contains an ADC value longer than %d characters.\n", MAIN_STREAM_MAXIMUM_NUMBER_LENGTH - 1);
+			else if (Count < 0) fprintf(stderr, "Error : the input contains an invalid ADC value.\n");
+			else fprintf(stderr, "Error : the input last sample does not contain all channels.\n");
+			return -1;
+		}
+		for (i = 0; i < Channels_Count; i++)
+		{
+			if (!(Samples[i] >= 0) || (Samples[i] > Maximum_ADC_Value) || (Samples[i] != floor(Samples[i])))
+			{
+				MainFlushStreamOutput();
+				fprintf(stderr, "Error : the input contains the ADC value %lf, which is not an integer in range [0; %u].\n", Samples[i], Maximum_ADC_Value);
+				return -1;
+			}
+		}
+		
+		// Remove spikes with a median filter
+		if (Median_Window_Size > 1)
+		{
+			// Fill the whole history with the first sample, so the filter can start right away
+			if (Samples_Count == 0)
+			{
+				for (j = 0; j < Median_Window_Size; j++) memcpy(Main_Conversion_Median_History[j], Samples, Channels_Count * sizeof(double));
+			}
+			else memcpy(Main_Conversion_Median_History[History_Index], Samples, Channels_Count * sizeof(double));
+			History_Index++;
+			if (History_Index >= Median_Window_Size) History_Index = 0;
+			
+			// Sort all channels windows at once with an odd-even transposition network, made of branchless minimum and maximum operations
+			for (j = 0; j < Median_Window_Size; j++) memcpy(Main_Conversion_Median_Window[j], Main_Conversion_Median_History[j], Channels_Count * sizeof(double));
+			for (Pass = 0; Pass < Median_Window_Size; Pass++)
+			{
+				for (k = Pass & 1; k < Median_Window_Size - 1; k += 2)
+				{
+					for (i = 0; i < Channels_Count; i++)
+					{
+						Minimum = Main_Conversion_Median_Window[k][i] < Main_Conversion_Median_Window[k + 1][i] ? Main_Conversion_Median_Window[k][i] : Main_Conversion_Median_Window[k + 1][i];
+						Maximum = Main_Conversion_Median_Window[k][i] < Main_Conversion_Median_Window[k + 1][i] ? Main_Conversion_Median_Window[k + 1][i] : Main_Conversion_Median_Window[k][i];
+						Main_Conversion_Median_Window[k][i] = Minimum;
+						Main_Conversion_Median_Window[k + 1][i] = Maximum;
+					}
+				}
+			}
+			memcpy(Samples, Main_Conversion_Median_Window[Median_Window_Size / 2], Channels_Count * sizeof(double));
+		}
+		
+		// Convert the ADC values to temperatures
+		for (i = 0; i < Channels_Count; i++) ADC_Values[i] = (unsigned int) Samples[i];
+		Conversion_Function(ADC_Values, Samples, Channels_Count);
+		
+		// Smooth the temperatures (the filter starts from the first sample temperature)
+		if (Samples_Count == 0) memcpy(Filtered_Temperatures, Samples, Channels_Count * sizeof(double));
+		else
+		{
+			for (i = 0; i < Channels_Count; i++) Filtered_Temperatures[i] += Low_Pass_Coefficient * (Samples[i] - Filtered_Temperatures[i]);
+		}
+		
+		// Write only the samples that are kept by the decimation
+		if (Samples_Count % Decimation_Factor == 0)
+		{
+			for (i = 0; i < Channels_Count - 1; i++) MainWriteStreamDouble(Filtered_Temperatures[i], '\t');
+			MainWriteStreamDouble(Filtered_Temperatures[i], '\n');
+		}
+		Samples_Count++;
+	}
+	
+	MainFlushStreamOutput();
+	return 0;
+}
+
+/** Find the NUMA nodes and their CPUs.
+ * @param Pointer_Nodes On output, contain the found nodes.
+ * @return How many nodes were found (0 if the system does not expose its NUMA topology).
+ */
+static int MainGetNumaNodes(TMainNumaNode *Pointer_Nodes)
+{
+	FILE *Pointer_File;
+	char String_File_Name[64];
+	int Node_Identifier, Nodes_Count = 0, First_CPU, Last_CPU, CPU, Character;
+	
+	// Node identifiers can have holes, so try all of them
+	for (Node_Identifier = 0; (Node_Identifier < 1024) && (Nodes_Count < MAIN_MAXIMUM_NUMA_NODES_COUNT); Node_Identifier++)
+	{
+		snprintf(String_File_Name, sizeof(String_File_Name), "/sys/devices/system/node/node%d/cpulist", Node_Identifier);
+		Pointer_File = fopen(String_File_Name, "r");
+		if (Pointer_File == NULL) continue;
+		
+		// The file contains comma-separated CPU ranges, like "0-3,8-11"
+		CPU_ZERO(&Pointer_Nodes[Nodes_Count].CPUs_Set);
+		while (fscanf(Pointer_File, "%d", &First_CPU) == 1)
+		{
+			Last_CPU = First_CPU;
+			Character = fgetc(Pointer_File);
+			if ((Character == '-') && (fscanf(Pointer_File, "%d", &Last_CPU) == 1)) Character = fgetc(Pointer_File);
+			for (CPU = First_CPU; (CPU <= Last_CPU) && (CPU < CPU_SETSIZE); CPU++) CPU_SET(CPU, &Pointer_Nodes[Nodes_Count].CPUs_Set);
+			if (Character != ',') break;
+		}
+		fclose(Pointer_File);
+		
+		// Ignore the memory-only nodes
+		if (CPU_COUNT(&Pointer_Nodes[Nodes_Count].CPUs_Set) == 0) continue;
+		Pointer_Nodes[Nodes_Count].Identifier = Node_Identifier;
+		Nodes_Count++;
+	}
+	
+	return Nodes_Count;
+}
+
+/** Compute a range of the Values array. The range pages are touched for the first time here, so the kernel places them in the memory of the node the worker runs on.
+ * @param Pointer_Worker_Parameter The TMainWorker structure describing the range.
+ * @return Always NULL.
+ */
+static void *MainComputeValuesWorker(void *Pointer_Worker_Parameter)
+{
+	TMainWorker *Pointer_Worker = Pointer_Worker_Parameter;
+	const TMainConfiguration *Pointer_Configuration = Pointer_Worker->Pointer_Configuration;
+	TMainComputedValues *Pointer_Values = &Values[Pointer_Worker->First_ADC_Value - Pointer_Worker->Values_Offset]; // The Values array begins with the ADC value Values_Offset
+	double Start_Time, Codes[EXPRESSION_BLOCK_SIZE], Voltages[EXPRESSION_BLOCK_SIZE], Resistances[EXPRESSION_BLOCK_SIZE], Temperatures[EXPRESSION_BLOCK_SIZE];
+	unsigned int i, j, Block_Size;
+	unsigned long long Trace_Start_Time;
+	
+	TraceNameThread("Compute worker");
+	Trace_Start_Time = TraceGetTime();
+	Start_Time = MainGetTime();
+	
+	for (i = Pointer_Worker->First_ADC_Value; i < Pointer_Worker->End_ADC_Value; i++)
+	{
+		Pointer_Values->Voltage_Divider_Output_Voltage = ThermistorComputeVoltageDividerOutputVoltage(Pointer_Configuration->Voltage_Divider_Bridge_Voltage, Pointer_Configuration->ADC_Resolution, i);
+		Pointer_Values->Thermistor_Resistance = ThermistorComputeResistance(Pointer_Configuration->Circuit_Variant, Pointer_Configuration->Voltage_Divider_Bridge_Voltage, Pointer_Values->Voltage_Divider_Output_Voltage, Pointer_Configuration->Voltage_Divider_Resistor);
+		if (Pointer_Worker->Pointer_Expression_Program == NULL) Pointer_Values->Thermistor_Temperature = ThermistorComputeTemperature(Pointer_Configuration->Thermistor_Beta_Coefficient, Pointer_Configuration->Thermistor_Reference_Resistance, Pointer_Values->Thermistor_Resistance);
+		Pointer_Values++;
+	}
+	
+	// Use the custom model when requested, the values are gathered by blocks to feed the expression interpreter
+	if (Pointer_Worker->Pointer_Expression_Program != NULL)
+	{
+		for (i = Pointer_Worker->First_ADC_Value; i < Pointer_Worker->End_ADC_Value; i += Block_Size)
+		{
+			Block_Size = Pointer_Worker->End_ADC_Value - i < EXPRESSION_BLOCK_SIZE ? Pointer_Worker->End_ADC_Value - i : EXPRESSION_BLOCK_SIZE;
+			for (j = 0; j < Block_Size; j++)
+			{
+				Codes[j] = i + j;
+				Voltages[j] = Values[i + j - Pointer_Worker->Values_Offset].Voltage_Divider_Output_Voltage;
+				Resistances[j] = Values[i + j - Pointer_Worker->Values_Offset].Thermistor_Resistance;
+			}
+			ExpressionEvaluate(Pointer_Worker->Pointer_Expression_Program, Codes, Voltages, Resistances, Temperatures, Block_Size);
+			for (j = 0; j < Block_Size; j++) Values[i + j - Pointer_Worker->Values_Offset].Thermistor_Temperature = Temperatures[j];
+		}
+	}
+	
+	Pointer_Worker->Elapsed_Time = MainGetTime() - Start_Time;
+	TraceRecordSpan(TRACE_SPAN_COMPUTE, Trace_Start_Time);
+	return NULL;
+}
+
+/** Start a thread pinned to the CPUs of a NUMA node.
+ * @param Pointer_Thread On output, contain the thread handle.
+ * @param Pointer_CPUs_Set The node CPUs, or NULL to start the thread without pinning it.
+ * @param Thread_Function The thread entry point.
+ * @param Pointer_Parameter The thread entry point parameter.
+ * @return 0 if the thread was started, pinned or not (the thread is started without pinning when the process is not allowed to run on the node CPUs),
+ * @return -1 if the thread could not be started.
+ */
+static int MainCreatePinnedThread(pthread_t *Pointer_Thread, const cpu_set_t *Pointer_CPUs_Set, void *(*Thread_Function)(void *), void *Pointer_Parameter)
+{
+	pthread_attr_t Thread_Attributes;
+	int Result;
+	
+	pthread_attr_init(&Thread_Attributes);
+	if (Pointer_CPUs_Set != NULL) pthread_attr_setaffinity_np(&Thread_Attributes, sizeof(cpu_set_t), Pointer_CPUs_Set);
+	Result = pthread_create(Pointer_Thread, &Thread_Attributes, Thread_Function, Pointer_Parameter);
+	pthread_attr_destroy(&Thread_Attributes);
+	
+	// Try again without pinning, in case the process is not allowed to run on the node CPUs
+	if ((Result != 0) && (Pointer_CPUs_Set != NULL)) Result = pthread_create(Pointer_Thread, NULL, Thread_Function, Pointer_Parameter);
+	return Result == 0 ? 0 : -1;
+}
+
+/** Compute a range of ADC values to the Values array with several threads. The workers are grouped by NUMA node, each node computing a contiguous part of the range, and each worker is pinned to its node CPUs. The calling thread runs the first worker, its CPUs are restored on return so the threads it creates later are not confined to a node.
+ * @param Pointer_Configuration The table parameters.
+ * @param Pointer_Expression_Program The custom model, or NULL to use the Beta model.
+ * @param First_ADC_Value The first ADC value to compute, it is stored at the beginning of the Values array.
+ * @param End_ADC_Value The ADC value following the last one to compute.
+ * @param Workers_Count How many threads to use.
+ * @param Is_Statistics_Display_Enabled Set to 1 to display each node computation bandwidth on the standard error output.
+ */
+static void MainComputeValues(const TMainConfiguration *Pointer_Configuration, const TExpressionProgram *Pointer_Expression_Program, unsigned int First_ADC_Value, unsigned int End_ADC_Value, unsigned int Workers_Count, int Is_Statistics_Display_Enabled)
+{
+	static TMainWorker Workers[MAIN_MAXIMUM_WORKERS_COUNT];
+	static TMainNumaNode Nodes[MAIN_MAXIMUM_NUMA_NODES_COUNT];
+	cpu_set_t Saved_CPUs_Set;
+	int Nodes_Count, Is_Thread_Created[MAIN_MAXIMUM_WORKERS_COUNT], Node_Index, Node_Workers_Count, Is_Affinity_Changed = 0;
+	unsigned int i, Maximum_Workers_Count, Node_Values_Count;
+	double Node_Elapsed_Time;
+	
+	// Do not create more threads than the range size is worth
+	Maximum_Workers_Count = (End_ADC_Value - First_ADC_Value + Main_Worker_Minimum_Values_Count - 1) / Main_Worker_Minimum_Values_Count;
+	if (Workers_Count > Maximum_Workers_Count) Workers_Count = Maximum_Workers_Count;
+	if (Workers_Count > MAIN_MAXIMUM_WORKERS_COUNT) Workers_Count = MAIN_MAXIMUM_WORKERS_COUNT;
+	if (Workers_Count < 1) Workers_Count = 1;
+	
+	Nodes_Count = MainGetNumaNodes(Nodes);
+	
+	// Split the range in contiguous ranges, consecutive workers being on the same node
+	for (i = 0; i < Workers_Count; i++)
+	{
+		Workers[i].Pointer_Configuration = Pointer_Configuration;
+		Workers[i].Pointer_Expression_Program = Pointer_Expression_Program;
+		Workers[i].First_ADC_Value = First_ADC_Value + (unsigned int) ((unsigned long long) (End_ADC_Value - First_ADC_Value) * i / Workers_Count);
+		Workers[i].End_ADC_Value = First_ADC_Value + (unsigned int) ((unsigned long long) (End_ADC_Value - First_ADC_Value) * (i + 1) / Workers_Count);
+		Workers[i].Values_Offset = First_ADC_Value;
+		Workers[i].Node_Index = Nodes_Count > 0 ? (int) (i * Nodes_Count / Workers_Count) : 0;
+		Is_Thread_Created[i] = 0;
+	}
+	
+	// The first worker runs in the calling thread, start the other ones pinned to their node CPUs
+	for (i = 1; i < Workers_Count; i++)
+	{
+		if (MainCreatePinnedThread(&Workers[i].Thread, Nodes_Count > 1 ? &Nodes[Workers[i].Node_Index].CPUs_Set : NULL, MainComputeValuesWorker, &Workers[i]) == 0) Is_Thread_Created[i] = 1;
+	}
+	if ((Nodes_Count > 1) && (sched_getaffinity(0, sizeof(cpu_set_t), &Saved_CPUs_Set) == 0) && (sched_setaffinity(0, sizeof(cpu_set_t), &Nodes[Workers[0].Node_Index].CPUs_Set) == 0)) Is_Affinity_Changed = 1;
+	MainComputeValuesWorker(&Workers[0]);
+	if (Is_Affinity_Changed) sched_setaffinity(0, sizeof(cpu_set_t), &Saved_CPUs_Set);
+	
+	// Wait for all workers, compute the ranges of the threads that could not be created
+	for (i = 1; i < Workers_Count; i++)
+	{
+		if (Is_Thread_Created[i]) pthread_join(Workers[i].Thread, NULL);
+		else MainComputeValuesWorker(&Workers[i]);
+	}
+	
+	if (Is_Statistics_Display_Enabled)
+	{
+		fprintf(stderr, "Values computation : %u worker(s) on %d NUMA node(s).\n", Workers_Count, Nodes_Count > 0 ? Nodes_Count : 1);
+		for (Node_Index = 0; Node_Index < (Nodes_Count > 0 ? Nodes_Count : 1); Node_Index++)
+		{
+			// The node bandwidth is limited by its slowest worker
+			Node_Workers_Count = 0;
+			Node_Values_Count = 0;
+			Node_Elapsed_Time = 0;
+			for (i = 0; i < Workers_Count; i++)
+			{
+				if (Workers[i].Node_Index != Node_Index) continue;
+				Node_Workers_Count++;
+				Node_Values_Count += Workers[i].End_ADC_Value - Workers[i].First_ADC_Value;
+				if (Workers[i].Elapsed_Time > Node_Elapsed_Time) Node_Elapsed_Time = Workers[i].Elapsed_Time;
+			}
+			fprintf(stderr, "  Node %d : %d worker(s), %u values, %.3f MB written in %.3f ms (%.1f MB/s).\n", Nodes_Count > 0 ? Nodes[Node_Index].Identifier : 0, Node_Workers_Count, Node_Values_Count, Node_Values_Count * sizeof(TMainComputedValues) / 1e6, Node_Elapsed_Time * 1e3, Node_Elapsed_Time > 0 ? Node_Values_Count * sizeof(TMainComputedValues) / 1e6 / Node_Elapsed_Time : 0.);
+		}
+	}
+}
+
+/** Format a detail table row.
+ * @param Pointer_Buffer On output, contain the row text.
+ * @param Buffer_Size The buffer size, it must be at least MAIN_FORMATTER_MAXIMUM_ROW_LENGTH bytes.
+ * @param ADC_Value The row ADC value.
+ * @param Pointer_Values The row values.
+ * @return The row length.
+ */
+static inline size_t MainFormatDetailTableRow(char *Pointer_Buffer, size_t Buffer_Size, unsigned int ADC_Value, const TMainComputedValues *Pointer_Values)
+{
+	return (size_t) snprintf(Pointer_Buffer, Buffer_Size, MAIN_DETAIL_TABLE_ROW_FORMAT, ADC_Value, Pointer_Values->Voltage_Divider_Output_Voltage, Pointer_Values->Thermistor_Resistance, Pointer_Values->Thermistor_Temperature);
+}
+
+/** Write all the buffers to the standard output, in order.
+ * @param Pointer_Vectors The buffers, they are modified to track the partial writes.
+ * @param Vectors_Count How many buffers there are.
+ * @return 0 on success,
+ * @return -1 if the standard output could not be written.
+ */
+static int MainWriteVectors(struct iovec *Pointer_Vectors, int Vectors_Count)
+{
+	ssize_t Written_Size;
+	
+	while (Vectors_Count > 0)
+	{
+		Written_Size = writev(STDOUT_FILENO, Pointer_Vectors, Vectors_Count);
+		if (Written_Size < 0)
+		{
+			if (errno == EINTR) continue;
+			return -1;
+		}
+		
+		// Skip the written buffers and the written part of the partially written one
+		while ((Vectors_Count > 0) && ((size_t) Written_Size >= Pointer_Vectors->iov_len))
+		{
+			Written_Size -= Pointer_Vectors->iov_len;
+			Pointer_Vectors++;
+			Vectors_Count--;
+		}
+		if (Vectors_Count > 0)
+		{
+			Pointer_Vectors->iov_base = (char *) Pointer_Vectors->iov_base + Written_Size;
+			Pointer_Vectors->iov_len -= Written_Size;
+		}
+	}
+	
+	return 0;
+}
+
+/** A thread formatting a slice of the detail table rows at each round, the slices of a round being consecutive. A round is formatted while the previous one is written.
+ * @param Pointer_Formatter_Parameter The TMainFormatter structure.
+ * @return Always NULL.
+ */
+static void *MainFormatDetailTableWorker(void *Pointer_Formatter_Parameter)
+{
+	TMainFormatter *Pointer_Formatter = Pointer_Formatter_Parameter;
+	unsigned int Round, Rounds_Count, i, First_Row, End_Row, Buffer_Index;
+	size_t Size;
+	unsigned long long Trace_Start_Time;
+	
+	TraceNameThread("Detail table formatter");
+	
+	// Wait for all formatters to be created, the formatters count is known after that
+	pthread_mutex_lock(Pointer_Formatter->Pointer_Start_Mutex);
+	pthread_mutex_unlock(Pointer_Formatter->Pointer_Start_Mutex);
+	
+	Rounds_Count = (Pointer_Formatter->Rows_Count + Pointer_Formatter->Formatters_Count * Main_Formatter_Rows_Count - 1) / (Pointer_Formatter->Formatters_Count * Main_Formatter_Rows_Count);
+	for (Round = 0; Round < Rounds_Count; Round++)
+	{
+		Buffer_Index = Round & 1;
+		First_Row = (Round * Pointer_Formatter->Formatters_Count + Pointer_Formatter->Index) * Main_Formatter_Rows_Count;
+		End_Row = First_Row + Main_Formatter_Rows_Count;
+		if (End_Row > Pointer_Formatter->Rows_Count) End_Row = Pointer_Formatter->Rows_Count;
+		
+		// Stop when a row might not fit, the writer formats the remaining rows (this happens only with very long numbers)
+		Trace_Start_Time = TraceGetTime();
+		Size = 0;
+		for (i = First_Row; i < End_Row; i++)
+		{
+			if (MAIN_FORMATTER_BUFFER_SIZE(Main_Formatter_Rows_Count) - Size < MAIN_FORMATTER_MAXIMUM_ROW_LENGTH) break;
+			Size += MainFormatDetailTableRow(Pointer_Formatter->Pointer_Buffers[Buffer_Index] + Size, MAIN_FORMATTER_MAXIMUM_ROW_LENGTH, Pointer_Formatter->First_ADC_Value + i, &Values[i]);
+		}
+		Pointer_Formatter->Buffers_Sizes[Buffer_Index] = Size;
+		Pointer_Formatter->Formatted_Rows_Ends[Buffer_Index] = i;
+		Pointer_Formatter->Slices_Ends[Buffer_Index] = End_Row;
+		TraceRecordSpan(TRACE_SPAN_FORMAT, Trace_Start_Time);
+		
+		Trace_Start_Time = TraceGetTime();
+		pthread_barrier_wait(Pointer_Formatter->Pointer_Barrier);
+		TraceRecordSpan(TRACE_SPAN_WAIT, Trace_Start_Time);
+	}
+	
+	return NULL;
+}
+
+/** Display the detail table rows of the Values array. Big tables are formatted by several threads, each one rendering consecutive rows to its own buffer, and the buffers are written in order, so the output is the same as the one of printf().
+ * The formatters are spread over the NUMA nodes and pinned like the computation workers, so each formatter buffers are first touched, and stay, in its node memory. The rows of a round are consecutive, so they are read from the node that computed them by all formatters.
+ * @param First_ADC_Value The ADC value of the first Values array entry.
+ * @param Rows_Count How many rows to display.
+ * @param Workers_Count How many threads can format the rows.
+ * @return 0 on success,
+ * @return -1 if the rows could not be written to the standard output.
+ */
+static int MainDisplayDetailTable(unsigned int First_ADC_Value, unsigned int Rows_Count, unsigned int Workers_Count)
+{
+	static TMainFormatter Formatters[MAIN_MAXIMUM_WORKERS_COUNT];
+	static TMainNumaNode Nodes[MAIN_MAXIMUM_NUMA_NODES_COUNT];
+	pthread_mutex_t Start_Mutex = PTHREAD_MUTEX_INITIALIZER;
+	pthread_barrier_t Barrier;
+	struct iovec Vectors[MAIN_MAXIMUM_WORKERS_COUNT + 1];
+	char String_Row[MAIN_FORMATTER_MAXIMUM_ROW_LENGTH];
+	unsigned int i, j, Formatters_Count, Round, Rounds_Count, Buffer_Index;
+	int Vectors_Count, Nodes_Count, Result = 0;
+	size_t Arena_Mark = Main_Arena.Used_Size;
+	unsigned long long Trace_Start_Time;
+	
+	// Do not create more threads than the table size is worth
+	Formatters_Count = Rows_Count / Main_Formatter_Rows_Count;
+	if (Formatters_Count > Workers_Count) Formatters_Count = Workers_Count;
+	if (Formatters_Count > MAIN_MAXIMUM_WORKERS_COUNT) Formatters_Count = MAIN_MAXIMUM_WORKERS_COUNT;
+	for (i = 0; i < Formatters_Count; i++)
+	{
+		Formatters[i].Pointer_Buffers[0] = ArenaAllocate(&Main_Arena, MAIN_FORMATTER_BUFFER_SIZE(Main_Formatter_Rows_Count));
+		Formatters[i].Pointer_Buffers[1] = ArenaAllocate(&Main_Arena, MAIN_FORMATTER_BUFFER_SIZE(Main_Formatter_Rows_Count));
+		if ((Formatters[i].Pointer_Buffers[0] == NULL) || (Formatters[i].Pointer_Buffers[1] == NULL)) break;
+	}
+	Formatters_Count = i;
+	
+	// Use the standard output when the table is too small to be formatted in parallel
+	if (Formatters_Count < 2)
+	{
+		Trace_Start_Time = TraceGetTime();
+		for (i = 0; i < Rows_Count; i++) printf(MAIN_DETAIL_TABLE_ROW_FORMAT, First_ADC_Value + i, Values[i].Voltage_Divider_Output_Voltage, Values[i].Thermistor_Resistance, Values[i].Thermistor_Temperature);
+		TraceRecordSpan(TRACE_SPAN_FORMAT, Trace_Start_Time);
+		ArenaReset(&Main_Arena, Arena_Mark);
+		return ferror(stdout) ? -1 : 0;
+	}
+	
+	// Start the formatters, consecutive formatters being on the same node, they wait until they all are created
+	Nodes_Count = MainGetNumaNodes(Nodes);
+	pthread_mutex_lock(&Start_Mutex);
+	for (i = 0; i < Formatters_Count; i++)
+	{
+		Formatters[i].Pointer_Start_Mutex = &Start_Mutex;
+		Formatters[i].Pointer_Barrier = &Barrier;
+		Formatters[i].First_ADC_Value = First_ADC_Value;
+		Formatters[i].Rows_Count = Rows_Count;
+		Formatters[i].Index = i;
+		if (MainCreatePinnedThread(&Formatters[i].Thread, Nodes_Count > 1 ? &Nodes[i * Nodes_Count / Formatters_Count].CPUs_Set : NULL, MainFormatDetailTableWorker, &Formatters[i]) != 0) break;
+	}
+	Formatters_Count = i;
+	// Work with the formatters that could be created, even if there is a single one
+	if (Formatters_Count == 0)
+	{
+		pthread_mutex_unlock(&Start_Mutex);
+		for (i = 0; i < Rows_Count; i++) printf(MAIN_DETAIL_TABLE_ROW_FORMAT, First_ADC_Value + i, Values[i].Voltage_Divider_Output_Voltage, Values[i].Thermistor_Resistance, Values[i].Thermistor_Temperature);
+		ArenaReset(&Main_Arena, Arena_Mark);
+		return ferror(stdout) ? -1 : 0;
+	}
+	for (i = 0; i < Formatters_Count; i++) Formatters[i].Formatters_Count = Formatters_Count;
+	pthread_barrier_init(&Barrier, NULL, Formatters_Count + 1);
+	pthread_mutex_unlock(&Start_Mutex);
+	
+	// The rows are written without the standard output buffer, so write what it contains first
+	if (fflush(stdout) != 0) Result = -1;
+	
+	Rounds_Count = (Rows_Count + Formatters_Count * Main_Formatter_Rows_Count - 1) / (Formatters_Count * Main_Formatter_Rows_Count);
+	for (Round = 0; Round < Rounds_Count; Round++)
+	{
+		Buffer_Index = Round & 1;
+		Trace_Start_Time = TraceGetTime();
+		pthread_barrier_wait(&Barrier);
+		TraceRecordSpan(TRACE_SPAN_WAIT, Trace_Start_Time);
+		
+		// Keep synchronizing with the formatters after a write error so they can finish, but do not write anymore
+		if (Result != 0) continue;
+		
+		// Write the round buffers at once, unless a formatter could not format all its rows
+		Trace_Start_Time = TraceGetTime();
+		Vectors_Count = 0;
+		for (i = 0; (i < Formatters_Count) && (Result == 0); i++)
+		{
+			Vectors[Vectors_Count].iov_base = Formatters[i].Pointer_Buffers[Buffer_Index];
+			Vectors[Vectors_Count].iov_len = Formatters[i].Buffers_Sizes[Buffer_Index];
+			Vectors_Count++;
+			if (Formatters[i].Formatted_Rows_Ends[Buffer_Index] == Formatters[i].Slices_Ends[Buffer_Index]) continue;
+			
+			if (MainWriteVectors(Vectors, Vectors_Count) != 0) Result = -1;
+			Vectors_Count = 0;
+			for (j = Formatters[i].Formatted_Rows_Ends[Buffer_Index]; (j < Formatters[i].Slices_Ends[Buffer_Index]) && (Result == 0); j++)
+			{
+				Vectors[0].iov_base = String_Row;
+				Vectors[0].iov_len = MainFormatDetailTableRow(String_Row, sizeof(String_Row), First_ADC_Value + j, &Values[j]);
+				if (MainWriteVectors(Vectors, 1) != 0) Result = -1;
+			}
+		}
+		if ((Result == 0) && (MainWriteVectors(Vectors, Vectors_Count) != 0)) Result = -1;
+		TraceRecordSpan(TRACE_SPAN_WRITE, Trace_Start_Time);
+	}
+	
+	for (i = 0; i < Formatters_Count; i++) pthread_join(Formatters[i].Thread, NULL);
+	pthread_barrier_destroy(&Barrier);
+	ArenaReset(&Main_Arena, Arena_Mark);
+	return Result;
+}
+
+/** Get the next number of the xorshift64* pseudo-random sequence.
+ * @param Pointer_State The generator state, it must not be zero.
+ * @return A uniformly distributed number in range ]0; 1].
+ */
+static inline double MainGenerateRandomNumber(uint64_t *Pointer_State)
+{
+	uint64_t State = *Pointer_State;
+	
+	State ^= State >> 12;
+	State ^= State << 25;
+	State ^= State >> 27;
+	*Pointer_State = State;
+	
+	// Keep the 53 most significant bits, which fill a double mantissa
+	return (((State * 0x2545F4914F6CDD1DULL) >> 11) + 1) * (1. / 9007199254740992.);
+}
+
+/** Tell how many lanes groups hold all generator channels.
+ * @param Channels_Count How many interleaved channels are generated.
+ * @return The groups count.
+ */
+static inline unsigned int MainGetGeneratorLanesGroupsCount(unsigned int Channels_Count)
+{
+	return (Channels_Count + MAIN_GENERATOR_LANES_COUNT - 1) / MAIN_GENERATOR_LANES_COUNT;
+}
+
+/** Compute the generator sine trajectories temperatures from the phasors sines.
+ * @param Pointer_Sines The phasors sines.
+ * @param Pointer_Temperatures On output, contain the channels temperatures (Celsius).
+ * @param Middle_Temperature The sine waves middle temperature (Celsius).
+ * @param Amplitude The sine waves amplitude (Celsius).
+ * @param Groups_Count How many lanes groups to compute.
+ */
+static void MainComputeGeneratorSineTemperatures(const double * restrict Pointer_Sines, double * restrict Pointer_Temperatures, double Middle_Temperature, double Amplitude, unsigned int Groups_Count)
+{
+	unsigned int i, j;
+	
+	for (i = 0; i < Groups_Count; i++)
+	{
+		for (j = 0; j < MAIN_GENERATOR_LANES_COUNT; j++) Pointer_Temperatures[j] = Middle_Temperature + Amplitude * Pointer_Sines[j];
+		Pointer_Sines += MAIN_GENERATOR_LANES_COUNT;
+		Pointer_Temperatures += MAIN_GENERATOR_LANES_COUNT;
+	}
+}
+
+/** Compute the voltage divider output voltages of the generator channels temperatures, with the same operations as MainComputeThermistorResistanceFromTemperature() and MainComputeVoltageDividerOutputVoltageFromResistance().
+ * The circuit variant is tested once for all channels so the divider loops have no branch, only the exp() loop stays scalar because the C library has no vector exp() without -ffast-math.
+ * @param Pointer_Configuration The circuit configuration.
+ * @param Pointer_Temperatures The channels temperatures (Celsius).
+ * @param Pointer_Voltages On output, contain the channels voltages (volts).
+ * @param Groups_Count How many lanes groups to compute.
+ */
+static void MainComputeGeneratorVoltages(const TMainConfiguration *Pointer_Configuration, const double * restrict Pointer_Temperatures, double * restrict Pointer_Voltages, unsigned int Groups_Count)
+{
+	unsigned int i, j;
+	double Beta_Coefficient = Pointer_Configuration->Thermistor_Beta_Coefficient, Reference_Resistance = Pointer_Configuration->Thermistor_Reference_Resistance, Bridge_Voltage = Pointer_Configuration->Voltage_Divider_Bridge_Voltage, Divider_Resistor = Pointer_Configuration->Voltage_Divider_Resistor;
+	int Is_Bottom_Thermistor = Pointer_Configuration->Circuit_Variant == 1;
+	
+	for (i = 0; i < Groups_Count; i++)
+	{
+		for (j = 0; j < MAIN_GENERATOR_LANES_COUNT; j++) Pointer_Voltages[j] = Beta_Coefficient * ((1. / (THERMISTOR_KELVIN_OFFSET + Pointer_Temperatures[j])) - (1. / (THERMISTOR_KELVIN_OFFSET + THERMISTOR_REFERENCE_TEMPERATURE)));
+		for (j = 0; j < MAIN_GENERATOR_LANES_COUNT; j++) Pointer_Voltages[j] = Reference_Resistance * exp(Pointer_Voltages[j]); // The thermistor resistances
+		
+		if (Is_Bottom_Thermistor)
+		{
+			for (j = 0; j < MAIN_GENERATOR_LANES_COUNT; j++) Pointer_Voltages[j] = Bridge_Voltage * Pointer_Voltages[j] / (Divider_Resistor + Pointer_Voltages[j]);
+		}
+		else
+		{
+			for (j = 0; j < MAIN_GENERATOR_LANES_COUNT; j++) Pointer_Voltages[j] = Bridge_Voltage * Divider_Resistor / (Divider_Resistor + Pointer_Voltages[j]);
+		}
+		Pointer_Temperatures += MAIN_GENERATOR_LANES_COUNT;
+		Pointer_Voltages += MAIN_GENERATOR_LANES_COUNT;
+	}
+}
+
+/** Rotate the generator sine trajectories phasors to the next sample.
+ * @param Pointer_Cosines The phasors cosines, they are updated on output.
+ * @param Pointer_Sines The phasors sines, they are updated on output.
+ * @param Pointer_Steps_Cosines The rotation angles cosines.
+ * @param Pointer_Steps_Sines The rotation angles sines.
+ * @param Groups_Count How many lanes groups to rotate.
+ */
+static void MainAdvanceGeneratorPhasors(double * restrict Pointer_Cosines, double * restrict Pointer_Sines, const double * restrict Pointer_Steps_Cosines, const double * restrict Pointer_Steps_Sines, unsigned int Groups_Count)
+{
+	unsigned int i, j;
+	double Cosine;
+	
+	for (i = 0; i < Groups_Count; i++)
+	{
+		for (j = 0; j < MAIN_GENERATOR_LANES_COUNT; j++)
+		{
+			Cosine = Pointer_Cosines[j] * Pointer_Steps_Cosines[j] - Pointer_Sines[j] * Pointer_Steps_Sines[j];
+			Pointer_Sines[j] = Pointer_Sines[j] * Pointer_Steps_Cosines[j] + Pointer_Cosines[j] * Pointer_Steps_Sines[j];
+			Pointer_Cosines[j] = Cosine;
+		}
+		Pointer_Cosines += MAIN_GENERATOR_LANES_COUNT;
+		Pointer_Sines += MAIN_GENERATOR_LANES_COUNT;
+		Pointer_Steps_Cosines += MAIN_GENERATOR_LANES_COUNT;
+		Pointer_Steps_Sines += MAIN_GENERATOR_LANES_COUNT;
+	}
+}
+
+/** Advance the generator transient trajectories sensors temperatures to the next sample.
+ * @param Pointer_Temperatures The sensors temperatures (Celsius), they are updated on output.
+ * @param Pointer_Decays How much of the difference with the ambient temperature remains after a sample.
+ * @param End_Temperature The ambient temperature (Celsius).
+ * @param Groups_Count How many lanes groups to advance.
+ */
+static void MainAdvanceGeneratorTemperatures(double * restrict Pointer_Temperatures, const double * restrict Pointer_Decays, double End_Temperature, unsigned int Groups_Count)
+{
+	unsigned int i, j;
+	
+	for (i = 0; i < Groups_Count; i++)
+	{
+		for (j = 0; j < MAIN_GENERATOR_LANES_COUNT; j++) Pointer_Temperatures[j] = End_Temperature + (Pointer_Temperatures[j] - End_Temperature) * Pointer_Decays[j];
+		Pointer_Temperatures += MAIN_GENERATOR_LANES_COUNT;
+		Pointer_Decays += MAIN_GENERATOR_LANES_COUNT;
+	}
+}
+
+/** Generate a block of synthetic ADC values samples, in the conversion mode input format. The blocks do not depend on each other, so they can be generated in any order and by any thread.
+ * With the sine trajectory, each channel temperature follows a sine wave spanning the temperature range, its period is MAIN_GENERATOR_BASE_PERIOD plus MAIN_GENERATOR_PERIOD_STEP for each previous channel.
+ * With the transient trajectory, the ambient temperature steps from the start temperature to the end temperature at the first sample, and each channel sensor follows it with a first order thermal model. The channel n time constant is Time_Constant * (1 + n / Channels_Count), like sensors of different thermal masses.
+ * The temperatures go through the thermistor and voltage divider models, then the noise is added to the voltages before the quantization.
+ * @param Pointer_Parameters The generation parameters.
+ * @param Block_Index The block to generate, it starts at the sample Block_Index * Block_Samples_Count.
+ * @param Pointer_Channels_States Room for MAIN_GENERATOR_STATE_ARRAYS_COUNT arrays of doubles, each one holding the channels count rounded up to whole lanes groups.
+ * @param Pointer_Buffer On output, contain the samples text. It must have room for MAIN_GENERATOR_MAXIMUM_VALUE_LENGTH characters per value.
+ * @return The samples text length.
+ */
+static size_t MainGenerateADCValuesBlock(const TMainGeneratorParameters *Pointer_Parameters, unsigned long long Block_Index, double *Pointer_Channels_States, char *Pointer_Buffer)
+{
+	const TMainConfiguration *Pointer_Configuration = Pointer_Parameters->Pointer_Configuration;
+	unsigned int Channels_Count = Pointer_Parameters->Channels_Count, Groups_Count = MainGetGeneratorLanesGroupsCount(Channels_Count), Lanes_Count = Groups_Count * MAIN_GENERATOR_LANES_COUNT, i, j;
+	double *Pointer_Cosines = Pointer_Channels_States, *Pointer_Sines = &Pointer_Channels_States[Lanes_Count], *Pointer_Steps_Cosines = &Pointer_Channels_States[2 * Lanes_Count], *Pointer_Steps_Sines = &Pointer_Channels_States[3 * Lanes_Count], *Pointer_Temperatures = &Pointer_Channels_States[4 * Lanes_Count], *Pointer_Voltages = &Pointer_Channels_States[5 * Lanes_Count];
+	double *Pointer_Decays = Pointer_Channels_States; // The transient trajectory does not use the phasors room
+	double First_Sample = (double) Block_Index * Pointer_Parameters->Block_Samples_Count, Middle_Temperature, Amplitude, End_Temperature = Pointer_Parameters->End_Temperature, Period, Angle, X, Y, Radius;
+	uint64_t Random_State;
+	size_t Size = 0;
+	
+	// Also initialize the padding lanes, their values are computed but never written
+	Middle_Temperature = (Pointer_Parameters->Start_Temperature + Pointer_Parameters->End_Temperature) / 2.;
+	Amplitude = (Pointer_Parameters->End_Temperature - Pointer_Parameters->Start_Temperature) / 2.;
+	for (i = 0; i < Lanes_Count; i++)
+	{
+		if (Pointer_Parameters->Trajectory == MAIN_GENERATOR_TRAJECTORY_SINE)
+		{
+			// Start the phasors at the exact trajectories angles of the block first sample, then rotate them by a constant angle at each sample, so no sine needs to be computed per sample
+			Period = (MAIN_GENERATOR_BASE_PERIOD + i * MAIN_GENERATOR_PERIOD_STEP) * Pointer_Parameters->Sample_Rate; // In samples
+			Angle = i + 2. * M_PI * fmod(First_Sample, Period) / Period; // Spread the channels starting phases
+			Pointer_Cosines[i] = cos(Angle);
+			Pointer_Sines[i] = sin(Angle);
+			Angle = 2. * M_PI / Period;
+			Pointer_Steps_Cosines[i] = cos(Angle);
+			Pointer_Steps_Sines[i] = sin(Angle);
+		}
+		else
+		{
+			// The step response is exact at each sample, so the block first temperature is given by the closed form and the next ones by the recurrence
+			Pointer_Decays[i] = exp(-1. / (Pointer_Parameters->Time_Constant * (1. + (double) i / Channels_Count) * Pointer_Parameters->Sample_Rate));
+			Pointer_Temperatures[i] = End_Temperature + (Pointer_Parameters->Start_Temperature - End_Temperature) * pow(Pointer_Decays[i], First_Sample);
+		}
+	}
+	
+	// Give each block its own random sequence (seeded with the SplitMix64 finalizer), so the values do not depend on the threads count
+	Random_State = MAIN_GENERATOR_RANDOM_SEED + Block_Index * 0x9E3779B97F4A7C15ULL;
+	Random_State = (Random_State ^ (Random_State >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	Random_State = (Random_State ^ (Random_State >> 27)) * 0x94D049BB133111EBULL;
+	Random_State ^= Random_State >> 31;
+	if (Random_State == 0) Random_State = MAIN_GENERATOR_RANDOM_SEED;
+	
+	for (j = 0; j < Pointer_Parameters->Block_Samples_Count; j++)
+	{
+		// Each step is done on all channels at once, in separate arrays, so the loops can be vectorized
+		if (Pointer_Parameters->Trajectory == MAIN_GENERATOR_TRAJECTORY_SINE) MainComputeGeneratorSineTemperatures(Pointer_Sines, Pointer_Temperatures, Middle_Temperature, Amplitude, Groups_Count);
+		MainComputeGeneratorVoltages(Pointer_Configuration, Pointer_Temperatures, Pointer_Voltages, Groups_Count);
+		
+		// Get two gaussian numbers from each pair of uniform numbers with the Marsaglia polar method, which needs no trigonometric function
+		if (Pointer_Parameters->Noise_Scale > 0)
+		{
+			for (i = 0; i < Channels_Count; i += 2)
+			{
+				do
+				{
+					X = 2. * MainGenerateRandomNumber(&Random_State) - 1.;
+					Y = 2. * MainGenerateRandomNumber(&Random_State) - 1.;
+					Radius = X * X + Y * Y;
+				} while ((Radius >= 1.) || (Radius == 0.));
+				Radius = Pointer_Parameters->Noise_Scale * sqrt(-2. * log(Radius) / Radius);
+				Pointer_Voltages[i] += Radius * X;
+				if (i + 1 < Channels_Count) Pointer_Voltages[i + 1] += Radius * Y;
+			}
+		}
+		
+		for (i = 0; i < Channels_Count; i++)
+		{
+			Size += MainFormatUnsignedInteger(&Pointer_Buffer[Size], MainComputeADCValue(Pointer_Configuration->Voltage_Divider_Bridge_Voltage, Pointer_Configuration->ADC_Resolution, Pointer_Voltages[i]));
+			Pointer_Buffer[Size] = i + 1 < Channels_Count ? '\t' : '\n';
+			Size++;
+		}
+		
+		// Advance the trajectories to the next sample
+		if (Pointer_Parameters->Trajectory == MAIN_GENERATOR_TRAJECTORY_SINE) MainAdvanceGeneratorPhasors(Pointer_Cosines, Pointer_Sines, Pointer_Steps_Cosines, Pointer_Steps_Sines, Groups_Count);
+		else MainAdvanceGeneratorTemperatures(Pointer_Temperatures, Pointer_Decays, End_Temperature, Groups_Count);
+	}
+	
+	return Size;
+}
+
+/** A thread generating a block at each round, the blocks of a round being consecutive. A round is generated while the previous one is written.
+ * @param Pointer_Generator_Parameter The TMainGenerator structure.
+ * @return Always NULL.
+ */
+static void *MainGenerateADCValuesWorker(void *Pointer_Generator_Parameter)
+{
+	TMainGenerator *Pointer_Generator = Pointer_Generator_Parameter;
+	unsigned long long Round, Trace_Start_Time;
+	
+	TraceNameThread("Generator");
+	
+	// Wait for all generators to be created, the generators count is known after that
+	pthread_mutex_lock(Pointer_Generator->Pointer_Start_Mutex);
+	pthread_mutex_unlock(Pointer_Generator->Pointer_Start_Mutex);
+	
+	for (Round = 0; ; Round++)
+	{
+		Trace_Start_Time = TraceGetTime();
+		Pointer_Generator->Buffers_Sizes[Round & 1] = MainGenerateADCValuesBlock(Pointer_Generator->Pointer_Parameters, Round * Pointer_Generator->Generators_Count + Pointer_Generator->Index, Pointer_Generator->Pointer_Channels_States, Pointer_Generator->Pointer_Buffers[Round & 1]);
+		TraceRecordSpan(TRACE_SPAN_COMPUTE, Trace_Start_Time);
+		
+		Trace_Start_Time = TraceGetTime();
+		pthread_barrier_wait(Pointer_Generator->Pointer_Barrier);
+		TraceRecordSpan(TRACE_SPAN_WAIT, Trace_Start_Time);
+		
+		// The writer sets the last round while this round is generated, so all generators see the same value after the barrier
+		if (__atomic_load_n(Pointer_Generator->Pointer_Stop_Round, __ATOMIC_RELAXED) <= Round) break;
+	}
+	
+	return NULL;
+}
+
+/** Tell how many samples a generator block contains.
+ * @param Channels_Count How many interleaved channels are generated.
+ * @return The block samples count.
+ */
+static unsigned int MainGetGeneratorBlockSamplesCount(unsigned int Channels_Count)
+{
+	return Channels_Count < MAIN_GENERATOR_BLOCK_VALUES_COUNT ? MAIN_GENERATOR_BLOCK_VALUES_COUNT / Channels_Count : 1;
+}
+
+/** Tell how much memory a generator thread needs.
+ * @param Channels_Count How many interleaved channels are generated.
+ * @return The generator thread memory size (bytes).
+ */
+static size_t MainGetGeneratorMemorySize(unsigned int Channels_Count)
+{
+	// Add some room for the arena allocations alignment
+	return 2 * (size_t) MainGetGeneratorBlockSamplesCount(Channels_Count) * Channels_Count * MAIN_GENERATOR_MAXIMUM_VALUE_LENGTH + (size_t) MAIN_GENERATOR_STATE_ARRAYS_COUNT * MainGetGeneratorLanesGroupsCount(Channels_Count) * MAIN_GENERATOR_LANES_COUNT * sizeof(double) + 256;
+}
+
+/** Write synthetic ADC values to the standard output, in the conversion mode input format (one line per sample with tab-separated channels). The blocks are generated by several threads while the previous blocks are written, and the output does not depend on the threads count.
+ * @param Pointer_Parameters The generation parameters, the values computed by this function are set on output.
+ * @param Workers_Count How many threads can generate the values.
+ * @param Is_Statistics_Display_Enabled Set to 1 to display the generation statistics on the standard error output.
+ * @return 0 on success,
+ * @return -1 if the memory could not be allocated or the standard output could not be written.
+ */
+static int MainGenerateADCValues(TMainGeneratorParameters *Pointer_Parameters, unsigned int Workers_Count, int Is_Statistics_Display_Enabled)
+{
+	static TMainGenerator Generators[MAIN_MAXIMUM_WORKERS_COUNT];
+	pthread_mutex_t Start_Mutex = PTHREAD_MUTEX_INITIALIZER;
+	pthread_barrier_t Barrier;
+	struct iovec Vectors[MAIN_MAXIMUM_WORKERS_COUNT];
+	unsigned long long Stop_Round = ULLONG_MAX, Round, Written_Size = 0, Samples_Count = 0;
+	unsigned int i, Channels_Count = Pointer_Parameters->Channels_Count, Generators_Count, Blocks_Count, Buffer_Index;
+	int Vectors_Count, Result = 0, Is_Done = 0;
+	size_t Buffer_Size, Block_Size, j;
+	unsigned long long Block_Samples_Count, Size_Samples_Count, Trace_Start_Time;
+	double Start_Time, Duration;
+	char *Pointer_Buffer;
+	
+	Pointer_Parameters->Noise_Scale = Pointer_Parameters->Noise_Standard_Deviation * Pointer_Parameters->Pointer_Configuration->Voltage_Divider_Bridge_Voltage / (Pointer_Parameters->Pointer_Configuration->ADC_Resolution - 1); // Convert ADC steps to volts
+	Pointer_Parameters->Block_Samples_Count = MainGetGeneratorBlockSamplesCount(Channels_Count);
+	Buffer_Size = (size_t) Pointer_Parameters->Block_Samples_Count * Channels_Count * MAIN_GENERATOR_MAXIMUM_VALUE_LENGTH;
+	
+	// Give each generator its buffers, the caller sized the arena with MainGetGeneratorMemorySize()
+	for (i = 0; i < Workers_Count; i++)
+	{
+		Generators[i].Pointer_Channels_States = ArenaAllocate(&Main_Arena, (size_t) MAIN_GENERATOR_STATE_ARRAYS_COUNT * MainGetGeneratorLanesGroupsCount(Channels_Count) * MAIN_GENERATOR_LANES_COUNT * sizeof(double));
+		Generators[i].Pointer_Buffers[0] = ArenaAllocate(&Main_Arena, Buffer_Size);
+		Generators[i].Pointer_Buffers[1] = ArenaAllocate(&Main_Arena, Buffer_Size);
+		if ((Generators[i].Pointer_Channels_States == NULL) || (Generators[i].Pointer_Buffers[0] == NULL) || (Generators[i].Pointer_Buffers[1] == NULL)) break;
+	}
+	if (i == 0)
+	{
+		fprintf(stderr, "Error : failed to allocate the generator buffers.\n");
+		return -1;
+	}
+	Workers_Count = i;
+	
+	// Start the generators, they wait until they all are created
+	pthread_mutex_lock(&Start_Mutex);
+	for (i = 0; i < Workers_Count; i++)
+	{
+		Generators[i].Pointer_Start_Mutex = &Start_Mutex;
+		Generators[i].Pointer_Barrier = &Barrier;
+		Generators[i].Pointer_Stop_Round = &Stop_Round;
+		Generators[i].Pointer_Parameters = Pointer_Parameters;
+		Generators[i].Index = i;
+		if (pthread_create(&Generators[i].Thread, NULL, MainGenerateADCValuesWorker, &Generators[i]) != 0) break;
+	}
+	Generators_Count = i;
+	for (i = 0; i < Generators_Count; i++) Generators[i].Generators_Count = Generators_Count;
+	if (Generators_Count > 0) pthread_barrier_init(&Barrier, NULL, Generators_Count + 1);
+	pthread_mutex_unlock(&Start_Mutex);
+	
+	// Generate the blocks in this thread when no generator thread could be created
+	Blocks_Count = Generators_Count > 0 ? Generators_Count : 1;
+	
+	Start_Time = MainGetTime();
+	for (Round = 0; !Is_Done; Round++)
+	{
+		Buffer_Index = Round & 1;
+		Trace_Start_Time = TraceGetTime();
+		if (Generators_Count == 0)
+		{
+			Generators[0].Buffers_Sizes[Buffer_Index] = MainGenerateADCValuesBlock(Pointer_Parameters, Round, Generators[0].Pointer_Channels_States, Generators[0].Pointer_Buffers[Buffer_Index]);
+			TraceRecordSpan(TRACE_SPAN_COMPUTE, Trace_Start_Time);
+		}
+		else
+		{
+			pthread_barrier_wait(&Barrier);
+			TraceRecordSpan(TRACE_SPAN_WAIT, Trace_Start_Time);
+		}
+		
+		// Write the round blocks at once, the block that reaches a limit is cut after the sample that reaches it
+		Vectors_Count = 0;
+		for (i = 0; i < Blocks_Count; i++)
+		{
+			Pointer_Buffer = Generators[i].Pointer_Buffers[Buffer_Index];
+			Block_Size = Generators[i].Buffers_Sizes[Buffer_Index];
+			Block_Samples_Count = Pointer_Parameters->Block_Samples_Count;
+			if (Samples_Count + Block_Samples_Count >= Pointer_Parameters->Maximum_Samples_Count)
+			{
+				Block_Samples_Count = Pointer_Parameters->Maximum_Samples_Count - Samples_Count;
+				Is_Done = 1;
+			}
+			if (Written_Size + Block_Size >= Pointer_Parameters->Maximum_Size)
+			{
+				// Count the samples up to the one that reaches the size
+				Size_Samples_Count = 1;
+				for (j = 0; j < Pointer_Parameters->Maximum_Size - Written_Size - 1; j++)
+				{
+					if (Pointer_Buffer[j] == '\n') Size_Samples_Count++;
+				}
+				if (Size_Samples_Count < Block_Samples_Count) Block_Samples_Count = Size_Samples_Count;
+				Is_Done = 1;
+			}
+			
+			// Find the end of the last sample to write
+			if (Is_Done)
+			{
+				j = 0;
+				for (Block_Size = 0; j < Block_Samples_Count; Block_Size++)
+				{
+					if (Pointer_Buffer[Block_Size] == '\n') j++;
+				}
+			}
+			
+			Vectors[Vectors_Count].iov_base = Pointer_Buffer;
+			Vectors[Vectors_Count].iov_len = Block_Size;
+			Vectors_Count++;
+			Written_Size += Block_Size;
+			Samples_Count += Block_Samples_Count;
+			if (Is_Done) break;
+		}
+		Trace_Start_Time = TraceGetTime();
+		if (MainWriteVectors(Vectors, Vectors_Count) != 0)
+		{
+			fprintf(stderr, "Error : failed to write the generated ADC values.\n");
+			Result = -1;
+			Is_Done = 1;
+		}
+		TraceRecordSpan(TRACE_SPAN_WRITE, Trace_Start_Time);
+	}
+	Duration = MainGetTime() - Start_Time;
+	
+	// The generators are generating the next round, let them finish it then stop
+	if (Generators_Count > 0)
+	{
+		__atomic_store_n(&Stop_Round, Round, __ATOMIC_RELAXED);
+		pthread_barrier_wait(&Barrier);
+		for (i = 0; i < Generators_Count; i++) pthread_join(Generators[i].Thread, NULL);
+		pthread_barrier_destroy(&Barrier);
+	}
+	
+	if (Is_Statistics_Display_Enabled) fprintf(stderr, "Generator : %llu sample(s) of %u channel(s) (%.3f s of simulated time, %.1f times faster than real time), %.3f MB written in %.3f s (%.1f MB/s) by %u thread(s).\n", Samples_Count, Channels_Count, Samples_Count / Pointer_Parameters->Sample_Rate, Samples_Count / Pointer_Parameters->Sample_Rate / Duration, Written_Size / 1e6, Duration, Written_Size / 1e6 / Duration, Generators_Count);
+	return Result;
+}
+
+/** Compute the rounded lookup table of a configuration. The temperatures are computed by blocks, which are rounded and packed at once.
+ * @param Pointer_Configuration The configuration.
+ * @param Width The table integers size, the temperatures that do not fit are saturated.
+ * @param Pointer_Temperatures On output, contain the rounded temperature corresponding to each ADC value (Celsius).
+ */
+static void MainComputeRoundedTable(const TMainConfiguration *Pointer_Configuration, TPackerWidth Width, void *Pointer_Temperatures)
+{
+	unsigned int i, j, Block_Size;
+	double Voltage, Resistance, Temperatures[MAIN_STREAM_BLOCK_SIZE];
+	
+	for (i = 0; i < Pointer_Configuration->ADC_Resolution; i += Block_Size)
+	{
+		Block_Size = Pointer_Configuration->ADC_Resolution - i < MAIN_STREAM_BLOCK_SIZE ? Pointer_Configuration->ADC_Resolution - i : MAIN_STREAM_BLOCK_SIZE;
+		for (j = 0; j < Block_Size; j++)
+		{
+			Voltage = ThermistorComputeVoltageDividerOutputVoltage(Pointer_Configuration->Voltage_Divider_Bridge_Voltage, Pointer_Configuration->ADC_Resolution, i + j);
+			Resistance = ThermistorComputeResistance(Pointer_Configuration->Circuit_Variant, Pointer_Configuration->Voltage_Divider_Bridge_Voltage, Voltage, Pointer_Configuration->Voltage_Divider_Resistor);
+			Temperatures[j] = ThermistorComputeTemperature(Pointer_Configuration->Thermistor_Beta_Coefficient, Pointer_Configuration->Thermistor_Reference_Resistance, Resistance);
+		}
+		PackerRoundAndPack(Temperatures, 1, Block_Size, Width, (char *) Pointer_Temperatures + (size_t) i * Width);
+	}
+}
+
+/** Display numbers rounded to integers, MAIN_LOOKUP_TABLE_COLUMNS_COUNT numbers per line. The numbers can be a part of a bigger table.
+ * @param Pointer_Numbers The numbers to display.
+ * @param Stride How many doubles are between two consecutive numbers.
+ * @param Count How many numbers to display.
+ * @param First_Index The index of the first number in the whole table.
+ * @param Table_Size The whole table size, to end its last line.
+ * @param Pointer_String_Format The printf() format of a number.
+ */
+static void MainDisplayRoundedNumbers(const double *Pointer_Numbers, unsigned int Stride, unsigned int Count, unsigned int First_Index, unsigned int Table_Size, const char *Pointer_String_Format)
+{
+	int Integers[MAIN_STREAM_BLOCK_SIZE];
+	unsigned int i, j, Block_Size;
+	unsigned long long Trace_Start_Time = TraceGetTime();
+	
+	for (i = 0; i < Count; i += Block_Size)
+	{
+		Block_Size = Count - i < MAIN_STREAM_BLOCK_SIZE ? Count - i : MAIN_STREAM_BLOCK_SIZE;
+		PackerRoundAndPack(Pointer_Numbers + (size_t) i * Stride, Stride, Block_Size, PACKER_WIDTH_32_BITS, Integers);
+		for (j = 0; j < Block_Size; j++)
+		{
+			printf(Pointer_String_Format, Integers[j]);
+			if (((First_Index + i + j + 1) % MAIN_LOOKUP_TABLE_COLUMNS_COUNT == 0) || (First_Index + i + j + 1 == Table_Size)) putchar('\n');
+		}
+	}
+	TraceRecordSpan(TRACE_SPAN_FORMAT, Trace_Start_Time);
+}
+
+/** Emit the lookup tables of several configurations as C code, sharing the tables that are identical or that differ only by a constant offset.
+ * @param Pointer_Configurations The configurations.
+ * @param Configurations_Count How many configurations there are.
+ * @return 0 on success,
+ * @return -1 if there is not enough memory.
+ */
+static int MainEmitTables(const TMainConfiguration *Pointer_Configurations, int Configurations_Count)
+{
+	TMainEmitterTable Tables[MAIN_EMITTER_MAXIMUM_CONFIGURATIONS_COUNT];
+	unsigned int i, Table_Size, Emitted_Size = 0, Unshared_Size = 0;
+	int j, k, Result = -1;
+	TPackerWidth Width = PACKER_WIDTH_8_BITS, Table_Width;
+	size_t Arena_Mark = Main_Arena.Used_Size;
+	
+	// Compute all tables and the hash of their shape
+	for (j = 0; j < Configurations_Count; j++)
+	{
+		Tables[j].Pointer_Temperatures = ArenaAllocate(&Main_Arena, Pointer_Configurations[j].ADC_Resolution * sizeof(int));
+		if (Tables[j].Pointer_Temperatures == NULL)
+		{
+			fprintf(stderr, "Error : not enough memory to compute the tables.\n");
+			goto Exit;
+		}
+		MainComputeRoundedTable(&Pointer_Configurations[j], PACKER_WIDTH_32_BITS, Tables[j].Pointer_Temperatures);
+		
+		// FNV-1a hash of the differences to the first entry
+		Tables[j].Hash = 0xCBF29CE484222325ULL;
+		for (i = 0; i < Pointer_Configurations[j].ADC_Resolution; i++)
+		{
+			Tables[j].Hash ^= (unsigned int) (Tables[j].Pointer_Temperatures[i] - Tables[j].Pointer_Temperatures[0]);
+			Tables[j].Hash *= 0x100000001B3ULL;
+		}
+	}
+	
+	// Find the tables that can be shared, only the first table of each shape is emitted
+	for (j = 0; j < Configurations_Count; j++)
+	{
+		Tables[j].Shared_Table_Index = j;
+		Tables[j].Offset = 0;
+		for (k = 0; k < j; k++)
+		{
+			// Only compare the emitted tables with the same shape hash
+			if ((Tables[k].Shared_Table_Index != k) || (Tables[k].Hash != Tables[j].Hash) || (Pointer_Configurations[k].ADC_Resolution != Pointer_Configurations[j].ADC_Resolution)) continue;
+			
+			// Make sure this is not a hash collision
+			for (i = 1; i < Pointer_Configurations[j].ADC_Resolution; i++)
+			{
+				if (Tables[j].Pointer_Temperatures[i] - Tables[j].Pointer_Temperatures[0] != Tables[k].Pointer_Temperatures[i] - Tables[k].Pointer_Temperatures[0]) break;
+			}
+			if (i < Pointer_Configurations[j].ADC_Resolution) continue;
+			
+			Tables[j].Shared_Table_Index = k;
+			Tables[j].Offset = Tables[j].Pointer_Temperatures[0] - Tables[k].Pointer_Temperatures[0];
+			break;
+		}
+	}
+	
+	// All tables use the narrowest integer type that fits all emitted tables, because they are referenced by the same descriptor type
+	for (j = 0; j < Configurations_Count; j++)
+	{
+		if (Tables[j].Shared_Table_Index != j) continue;
+		Table_Width = PackerGetNarrowestWidth(Tables[j].Pointer_Temperatures, Pointer_Configurations[j].ADC_Resolution);
+		if (Table_Width > Width) Width = Table_Width;
+	}
+	
+	// Emit the shared tables
+	printf("/* Generated by thermistor-calculator. */\n\n");
+	for (j = 0; j < Configurations_Count; j++)
+	{
+		Table_Size = Pointer_Configurations[j].ADC_Resolution * Width;
+		Unshared_Size += Table_Size;
+		if (Tables[j].Shared_Table_Index != j) continue;
+		Emitted_Size += Table_Size;
+		
+		printf("static const %s Thermistor_Table_%d[%u] =\n{", PackerGetTypeName(Width), j, Pointer_Configurations[j].ADC_Resolution);
+		for (i = 0; i < Pointer_Configurations[j].ADC_Resolution; i++)
+		{
+			if (i % MAIN_LOOKUP_TABLE_COLUMNS_COUNT == 0) printf("\n\t");
+			printf("%4d, ", Tables[j].Pointer_Temperatures[i]);
+		}
+		printf("\n};\n\n");
+	}
+	
+	// Emit the channel descriptors
+	printf("/** A channel lookup table, the channel temperature is Pointer_Table[ADC_Value] + Offset. */\n"
+		"typedef struct\n"
+		"{\n"
+		"\tconst %s *Pointer_Table;\n"
+		"\tunsigned int Size;\n"
+		"\tsigned short Offset;\n"
+		"} TThermistorChannel;\n"
+		"\n"
+		"static const TThermistorChannel Thermistor_Channels[%d] =\n"
+		"{\n", PackerGetTypeName(Width), Configurations_Count);
+	for (j = 0; j < Configurations_Count; j++) printf("\t{ Thermistor_Table_%d, %u, %d }, // Circuit %d, Beta %g, R25 %g ohm, resistor %g ohm, Vcc %g V\n", Tables[j].Shared_Table_Index, Pointer_Configurations[j].ADC_Resolution, Tables[j].Offset, Pointer_Configurations[j].Circuit_Variant, Pointer_Configurations[j].Thermistor_Beta_Coefficient, Pointer_Configurations[j].Thermistor_Reference_Resistance, Pointer_Configurations[j].Voltage_Divider_Resistor, Pointer_Configurations[j].Voltage_Divider_Bridge_Voltage);
+	printf("};\n\n");
+	
+	printf("/* Tables flash usage : %u bytes instead of %u bytes, %u bytes saved. */\n", Emitted_Size, Unshared_Size, Unshared_Size - Emitted_Size);
+	Result = 0;
+	
+Exit:
+	ArenaReset(&Main_Arena, Arena_Mark);
+	return Result;
+}
+
+/** Read a value from a bit-packed array (this is the same code as the emitted decoder one).
+ * @param Pointer_Packed_Bytes The packed array, it must be followed by 3 padding bytes.
+ * @param Bits_Count How many bits each value is made of (up to 25).
+ * @param Index The value to read.
+ * @return The unpacked value.
+ */
+static unsigned int MainReadPackedValue(const unsigned char *Pointer_Packed_Bytes, int Bits_Count, unsigned int Index)
+{
+	unsigned long Bit_Index, Word;
+	
+	Bit_Index = (unsigned long) Index * Bits_Count;
+	Pointer_Packed_Bytes += Bit_Index >> 3;
+	Word = Pointer_Packed_Bytes[0] | ((unsigned long) Pointer_Packed_Bytes[1] << 8) | ((unsigned long) Pointer_Packed_Bytes[2] << 16) | ((unsigned long) Pointer_Packed_Bytes[3] << 24);
+	return (unsigned int) ((Word >> (Bit_Index & 7)) & ((1UL << Bits_Count) - 1));
+}
+
+/** Emit the lookup tables of several configurations as C code, as a base table (the first configuration one) and bit-packed differences to the base table for the other configurations.
+ * Each packed table is decoded again to make sure that the encoding is lossless.
+ * @param Pointer_Configurations The configurations, they must all have the same ADC resolution.
+ * @param Configurations_Count How many configurations there are.
+ * @return 0 on success,
+ * @return -1 if an error occurred.
+ */
+static int MainEmitFamilyTables(const TMainConfiguration *Pointer_Configurations, int Configurations_Count)
+{
+	unsigned int ADC_Resolution = Pointer_Configurations[0].ADC_Resolution, i, Packed_Size, Emitted_Size, Unshared_Size;
+	int *Pointer_Base_Temperatures = NULL, *Pointer_Temperatures = NULL, Minimum_Deltas[MAIN_EMITTER_MAXIMUM_CONFIGURATIONS_COUNT], Bits_Counts[MAIN_EMITTER_MAXIMUM_CONFIGURATIONS_COUNT], Maximum_Delta, Delta, j, Result = -1;
+	unsigned char *Pointer_Packed_Bytes = NULL;
+	unsigned long Bit_Index;
+	TPackerWidth Width;
+	size_t Arena_Mark = Main_Arena.Used_Size;
+	
+	for (j = 1; j < Configurations_Count; j++)
+	{
+		if (Pointer_Configurations[j].ADC_Resolution != ADC_Resolution)
+		{
+			fprintf(stderr, "Error : all family configurations must have the same resolution.\n");
+			return -1;
+		}
+	}
+	
+	// The biggest packed table has 17-bit values, keep room for the decoder padding bytes (the buffers are reused for each variant)
+	Pointer_Base_Temperatures = ArenaAllocate(&Main_Arena, ADC_Resolution * sizeof(int));
+	Pointer_Temperatures = ArenaAllocate(&Main_Arena, ADC_Resolution * sizeof(int));
+	Pointer_Packed_Bytes = ArenaAllocate(&Main_Arena, (size_t) ADC_Resolution * 3 + 4);
+	if ((Pointer_Base_Temperatures == NULL) || (Pointer_Temperatures == NULL) || (Pointer_Packed_Bytes == NULL))
+	{
+		fprintf(stderr, "Error : not enough memory to compute the tables.\n");
+		goto Exit;
+	}
+	
+	// Emit the base table
+	MainComputeRoundedTable(&Pointer_Configurations[0], PACKER_WIDTH_32_BITS, Pointer_Base_Temperatures);
+	Width = PackerGetNarrowestWidth(Pointer_Base_Temperatures, ADC_Resolution);
+	printf("/* Generated by thermistor-calculator. */\n\n"
+		"static const %s Thermistor_Base_Table[%u] =\n{", PackerGetTypeName(Width), ADC_Resolution);
+	for (i = 0; i < ADC_Resolution; i++)
+	{
+		if (i % MAIN_LOOKUP_TABLE_COLUMNS_COUNT == 0) printf("\n\t");
+		printf("%4d, ", Pointer_Base_Temperatures[i]);
+	}
+	printf("\n};\n\n");
+	Emitted_Size = ADC_Resolution * Width;
+	Unshared_Size = Emitted_Size;
+	
+	// Emit each variant packed differences
+	Minimum_Deltas[0] = 0;
+	Bits_Counts[0] = 0;
+	for (j = 1; j < Configurations_Count; j++)
+	{
+		MainComputeRoundedTable(&Pointer_Configurations[j], PACKER_WIDTH_32_BITS, Pointer_Temperatures);
+		Unshared_Size += ADC_Resolution * Width;
+		
+		// Find how many bits are needed to store the differences
+		Minimum_Deltas[j] = Maximum_Delta = Pointer_Temperatures[0] - Pointer_Base_Temperatures[0];
+		for (i = 1; i < ADC_Resolution; i++)
+		{
+			Delta = Pointer_Temperatures[i] - Pointer_Base_Temperatures[i];
+			if (Delta < Minimum_Deltas[j]) Minimum_Deltas[j] = Delta;
+			if (Delta > Maximum_Delta) Maximum_Delta = Delta;
+		}
+		Bits_Counts[j] = 0;
+		while ((Bits_Counts[j] < 17) && ((1L << Bits_Counts[j]) <= (long) Maximum_Delta - Minimum_Deltas[j])) Bits_Counts[j]++;
+		
+		// Pack the differences, least significant bits first
+		Packed_Size = (unsigned int) (((unsigned long) ADC_Resolution * Bits_Counts[j] + 7) / 8);
+		memset(Pointer_Packed_Bytes, 0, Packed_Size + 3);
+		for (i = 0; i < ADC_Resolution; i++)
+		{
+			Delta = Pointer_Temperatures[i] - Pointer_Base_Temperatures[i] - Minimum_Deltas[j];
+			for (Bit_Index = (unsigned long) i * Bits_Counts[j]; Delta != 0; Bit_Index++, Delta >>= 1)
+			{
+				if (Delta & 1) Pointer_Packed_Bytes[Bit_Index >> 3] |= (unsigned char) (1 << (Bit_Index & 7));
+			}
+		}
+		
+		// Make sure that the decoder gives back the exact table
+		for (i = 0; i < ADC_Resolution; i++)
+		{
+			if (Pointer_Base_Temperatures[i] + Minimum_Deltas[j] + (int) MainReadPackedValue(Pointer_Packed_Bytes, Bits_Counts[j], i) != Pointer_Temperatures[i])
+			{
+				fprintf(stderr, "Error : the configuration %d packed table does not decode to the original table at ADC value %u.\n", j, i);
+				goto Exit;
+			}
+		}
+		
+		// A variant identical to the base table or only offset from it has no differences to store, it uses the shared zero array that the decoder can always read 4 bytes from
+		if (Bits_Counts[j] == 0) continue;
+		
+		printf("static const unsigned char Thermistor_Deltas_%d[%u] = // %d bits per value, 3 padding bytes\n{", j, Packed_Size + 3, Bits_Counts[j]);
+		for (i = 0; i < Packed_Size + 3; i++)
+		{
+			if (i % MAIN_LOOKUP_TABLE_COLUMNS_COUNT == 0) printf("\n\t");
+			printf("0x%02X, ", Pointer_Packed_Bytes[i]);
+		}
+		printf("\n};\n\n");
+		Emitted_Size += Packed_Size + 3;
+	}
+	
+	// Emit the variant descriptors and the decoder
+	printf("/** A family variant, its temperature is Thermistor_Base_Table[ADC_Value] + Minimum_Delta + the ADC_Value-th Bits_Count-bit packed value. */\n"
+		"typedef struct\n"
+		"{\n"
+		"\tconst unsigned char *Pointer_Deltas;\n"
+		"\tunsigned char Bits_Count;\n"
+		"\tsigned short Minimum_Delta;\n"
+		"} TThermistorVariant;\n"
+		"\n"
+		"static const unsigned char Thermistor_No_Deltas[4] = { 0 }; // The decoder reads 4 bytes even when there are no differences\n"
+		"\n"
+		"static const TThermistorVariant Thermistor_Variants[%d] =\n"
+		"{\n", Configurations_Count);
+	for (j = 0; j < Configurations_Count; j++)
+	{
+		if (Bits_Counts[j] == 0) printf("\t{ Thermistor_No_Deltas, 0, %d },", Minimum_Deltas[j]);
+		else printf("\t{ Thermistor_Deltas_%d, %d, %d },", j, Bits_Counts[j], Minimum_Deltas[j]);
+		printf(" // Circuit %d, Beta %g, R25 %g ohm, resistor %g ohm, Vcc %g V\n", Pointer_Configurations[j].Circuit_Variant, Pointer_Configurations[j].Thermistor_Beta_Coefficient, Pointer_Configurations[j].Thermistor_Reference_Resistance, Pointer_Configurations[j].Voltage_Divider_Resistor, Pointer_Configurations[j].Voltage_Divider_Bridge_Voltage);
+	}
+	printf("};\n\n"
+		"/** Get a variant temperature in constant time.\n"
+		" * @param Variant The variant index.\n"
+		" * @param ADC_Value The ADC value, it must be lower than %u.\n"
+		" * @return The temperature (Celsius).\n"
+		" */\n"
+		"static int ThermistorGetFamilyTemperature(unsigned int Variant, unsigned int ADC_Value)\n"
+		"{\n"
+		"\tconst TThermistorVariant *Pointer_Variant = &Thermistor_Variants[Variant];\n"
+		"\tconst unsigned char *Pointer_Bytes;\n"
+		"\tunsigned long Bit_Index, Word;\n"
+		"\t\n"
+		"\tBit_Index = (unsigned long) ADC_Value * Pointer_Variant->Bits_Count;\n"
+		"\tPointer_Bytes = &Pointer_Variant->Pointer_Deltas[Bit_Index >> 3];\n"
+		"\tWord = Pointer_Bytes[0] | ((unsigned long) Pointer_Bytes[1] << 8) | ((unsigned long) Pointer_Bytes[2] << 16) | ((unsigned long) Pointer_Bytes[3] << 24);\n"
+		"\treturn Thermistor_Base_Table[ADC_Value] + Pointer_Variant->Minimum_Delta + (int) ((Word >> (Bit_Index & 7)) & ((1UL << Pointer_Variant->Bits_Count) - 1));\n"
+		"}\n\n", ADC_Resolution);
+	
+	printf("/* Tables flash usage : %u bytes instead of %u bytes, all tables decode losslessly. */\n", Emitted_Size, Unshared_Size);
+	Result = 0;
+	
+Exit:
+	ArenaReset(&Main_Arena, Arena_Mark);
+	return Result;
+}
+
+/** Write the lookup table of each configuration to its own binary file, as native-endian signed 16-bit temperatures (Celsius). The tables are computed straight into the output buffers, which are written asynchronously and handed back to the computation as soon as their writes complete.
+ * @param Pointer_Configurations The configurations.
+ * @param Configurations_Count How many configurations there are.
+ * @param Pointer_String_Directory The directory to write the "table-<configuration index>.bin" files to.
+ * @param Memory_Budget The biggest amount of memory the program can use (bytes), it limits how many tables are computed ahead of the writes. Set SIZE_MAX for no limit.
+ * @param Is_Statistics_Display_Enabled Set to 1 to display the writer statistics on the standard error output.
+ * @return 0 on success,
+ * @return -1 if a file could not be written.
+ */
+static int MainWriteTablesFiles(const TMainConfiguration *Pointer_Configurations, int Configurations_Count, const char *Pointer_String_Directory, size_t Memory_Budget, int Is_Statistics_Display_Enabled)
+{
+	unsigned int Maximum_ADC_Resolution = 0, Buffers_Count;
+	int j, Buffer_Index, Result = 0;
+	double Start_Time;
+	char String_File_Name[MAIN_WRITER_MAXIMUM_PATH_LENGTH];
+	unsigned long long Written_Size = 0, Trace_Start_Time;
+	
+	for (j = 0; j < Configurations_Count; j++)
+	{
+		if (Pointer_Configurations[j].ADC_Resolution > Maximum_ADC_Resolution) Maximum_ADC_Resolution = Pointer_Configurations[j].ADC_Resolution;
+	}
+	Buffers_Count = (unsigned int) Configurations_Count < MAIN_WRITER_BUFFERS_COUNT ? (unsigned int) Configurations_Count : MAIN_WRITER_BUFFERS_COUNT;
+	if (Memory_Budget != SIZE_MAX)
+	{
+		if ((Memory_Budget < MAIN_MEMORY_PLANNER_BASE_SIZE) || ((Memory_Budget - MAIN_MEMORY_PLANNER_BASE_SIZE) / (Maximum_ADC_Resolution * sizeof(signed short)) == 0))
+		{
+			fprintf(stderr, "Error : the memory budget is too small to hold a table.\n");
+			return -1;
+		}
+		if (Buffers_Count > (Memory_Budget - MAIN_MEMORY_PLANNER_BASE_SIZE) / (Maximum_ADC_Resolution * sizeof(signed short))) Buffers_Count = (unsigned int) ((Memory_Budget - MAIN_MEMORY_PLANNER_BASE_SIZE) / (Maximum_ADC_Resolution * sizeof(signed short)));
+	}
+	
+	// The last configuration has the longest file name, make sure no file name is truncated before writing anything
+	if (snprintf(String_File_Name, sizeof(String_File_Name), "%s/table-%d.bin", Pointer_String_Directory, Configurations_Count - 1) >= (int) sizeof(String_File_Name))
+	{
+		fprintf(stderr, "Error : the tables files directory path is too long.\n");
+		return -1;
+	}
+	
+	if (AsyncWriterInitialize(Buffers_Count, Maximum_ADC_Resolution * sizeof(signed short)) != 0)
+	{
+		fprintf(stderr, "Error : failed to initialize the asynchronous writer.\n");
+		return -1;
+	}
+	
+	Start_Time = MainGetTime();
+	for (j = 0; j < Configurations_Count; j++)
+	{
+		// Wait for a previous table write to complete if all buffers are in use
+		Trace_Start_Time = TraceGetTime();
+		Buffer_Index = AsyncWriterGetBuffer();
+		TraceRecordSpan(TRACE_SPAN_WAIT, Trace_Start_Time);
+		if (Buffer_Index < 0)
+		{
+			Result = -1;
+			break;
+		}
+		
+		// The temperatures that do not fit in the table entries are saturated
+		Trace_Start_Time = TraceGetTime();
+		MainComputeRoundedTable(&Pointer_Configurations[j], PACKER_WIDTH_16_BITS, AsyncWriterGetBufferAddress(Buffer_Index));
+		TraceRecordSpan(TRACE_SPAN_COMPUTE, Trace_Start_Time);
+		
+		snprintf(String_File_Name, sizeof(String_File_Name), "%s/table-%d.bin", Pointer_String_Directory, j);
+		Trace_Start_Time = TraceGetTime();
+		if (AsyncWriterSubmit(String_File_Name, Buffer_Index, Pointer_Configurations[j].ADC_Resolution * sizeof(signed short)) != 0)
+		{
+			fprintf(stderr, "Error : failed to write the file \"%s\".\n", String_File_Name);
+			Result = -1;
+			break;
+		}
+		TraceRecordSpan(TRACE_SPAN_WRITE, Trace_Start_Time);
+		Written_Size += Pointer_Configurations[j].ADC_Resolution * sizeof(signed short);
+	}
+	
+	// Wait for all files to be on the storage
+	Trace_Start_Time = TraceGetTime();
+	if (AsyncWriterFinish() != 0)
+	{
+		fprintf(stderr, "Error : failed to write or synchronize the tables files.\n");
+		Result = -1;
+	}
+	TraceRecordSpan(TRACE_SPAN_WAIT, Trace_Start_Time);
+	
+	if (Is_Statistics_Display_Enabled) fprintf(stderr, "Tables files : %d table(s), %.3f MB written and synchronized in %.3f ms using %s with %u buffer(s).\n", Configurations_Count, Written_Size / 1e6, (MainGetTime() - Start_Time) * 1e3, AsyncWriterIsUsingIOUring() ? "io_uring" : "a threads pool", Buffers_Count);
+	return Result;
+}
+
+/** Find how to run a table computation job within a memory budget. The whole table is kept in memory when it fits, otherwise the values are streamed by chunks (or only the temperatures column is kept in conversion mode, because the conversion needs the whole table).
+ * @param Memory_Budget The biggest amount of memory the job can use (bytes), set SIZE_MAX for no limit.
+ * @param ADC_Resolution The ADC resolution.
+ * @param Workers_Count How many threads were requested to compute the values.
+ * @param Is_Conversion_Enabled Set to 1 when the table is used by the conversion mode.
+ * @param Is_Thermocouple_Enabled Set to 1 when the cold-junction compensation table is displayed.
+ * @param Is_Compiled_Converter_Enabled Set to 1 when a temperatures copy of the table is needed to build the specialized conversion function.
+ * @param Is_Streaming_Required Set to 1 when the output is always streamed, even if the whole table fits in the budget.
+ * @param Pointer_Plan On output, contain the chosen plan.
+ * @return 0 on success,
+ * @return -1 if the job does not fit in the budget.
+ */
+static int MainPlanExecution(size_t Memory_Budget, unsigned int ADC_Resolution, unsigned int Workers_Count, int Is_Conversion_Enabled, int Is_Thermocouple_Enabled, int Is_Compiled_Converter_Enabled, int Is_Streaming_Required, TMainExecutionPlan *Pointer_Plan)
+{
+	size_t Available_Size, Value_Size, Chunk_Values_Count, Worker_Size, Formatter_Size;
+	
+	memset(Pointer_Plan, 0, sizeof(TMainExecutionPlan));
+	if (Memory_Budget < MAIN_MEMORY_PLANNER_BASE_SIZE + MAIN_MEMORY_PLANNER_WORKER_SIZE) return -1;
+	Available_Size = Memory_Budget - MAIN_MEMORY_PLANNER_BASE_SIZE;
+	
+	// The workers also format the detail table when it is displayed
+	Formatter_Size = Is_Conversion_Enabled ? 0 : 2 * (MAIN_FORMATTER_BUFFER_SIZE(Main_Formatter_Rows_Count) + 64);
+	Worker_Size = MAIN_MEMORY_PLANNER_WORKER_SIZE + Formatter_Size;
+	
+	// Do not let the threads use more than a quarter of the budget, the data is more useful
+	if (Workers_Count > Available_Size / 4 / Worker_Size) Workers_Count = (unsigned int) (Available_Size / 4 / Worker_Size);
+	if (Workers_Count < 1) Workers_Count = 1;
+	if (Workers_Count * Worker_Size > Available_Size) return -1;
+	Available_Size -= Workers_Count * Worker_Size;
+	
+	// Keep the whole table when it fits
+	Value_Size = sizeof(TMainComputedValues);
+	if (Is_Conversion_Enabled && Is_Compiled_Converter_Enabled) Value_Size += sizeof(double);
+	else if (!Is_Conversion_Enabled && Is_Thermocouple_Enabled) Value_Size += sizeof(double);
+	Pointer_Plan->Arena_Size = (size_t) ADC_Resolution * Value_Size + 1024;
+	if (Pointer_Plan->Arena_Size > Available_Size)
+	{
+		// The conversion needs random access to the whole table, keep only the temperatures (they are also given to the specialized conversion function builder)
+		if (Is_Conversion_Enabled)
+		{
+			Pointer_Plan->Arena_Size = (size_t) ADC_Resolution * sizeof(double) + 1024;
+			if (Pointer_Plan->Arena_Size > Available_Size) return -1;
+			Pointer_Plan->Is_Temperature_Only_Retained = 1;
+			
+			// The values are computed by chunks to fill the temperatures column
+			Chunk_Values_Count = (Available_Size - Pointer_Plan->Arena_Size) / sizeof(TMainComputedValues);
+			if (Chunk_Values_Count < MAIN_MEMORY_PLANNER_MINIMUM_CHUNK_VALUES_COUNT) return -1;
+			if (Chunk_Values_Count > ADC_Resolution) Chunk_Values_Count = ADC_Resolution;
+			Pointer_Plan->Arena_Size += Chunk_Values_Count * sizeof(TMainComputedValues) + 1024;
+		}
+		// Stream the displayed tables, the chunks are recomputed for each table
+		else
+		{
+			Chunk_Values_Count = (Available_Size - 2048) / Value_Size;
+			if (Chunk_Values_Count < MAIN_MEMORY_PLANNER_MINIMUM_CHUNK_VALUES_COUNT) return -1;
+			Pointer_Plan->Is_Streaming_Enabled = 1;
+			Pointer_Plan->Arena_Size = Chunk_Values_Count * Value_Size + 2048;
+		}
+	}
+	// Bound the memory even when the whole table fits if the output is always streamed
+	else if (Is_Streaming_Required)
+	{
+		Chunk_Values_Count = ADC_Resolution < MAIN_MEMORY_PLANNER_STREAMING_CHUNK_VALUES_COUNT ? ADC_Resolution : MAIN_MEMORY_PLANNER_STREAMING_CHUNK_VALUES_COUNT;
+		Pointer_Plan->Is_Streaming_Enabled = 1;
+		Pointer_Plan->Arena_Size = Chunk_Values_Count * Value_Size + 2048;
+	}
+	else Chunk_Values_Count = ADC_Resolution;
+	
+	// Each worker computes at least a minimum amount of values from a chunk
+	if (Workers_Count > (Chunk_Values_Count + Main_Worker_Minimum_Values_Count - 1) / Main_Worker_Minimum_Values_Count) Workers_Count = (unsigned int) ((Chunk_Values_Count + Main_Worker_Minimum_Values_Count - 1) / Main_Worker_Minimum_Values_Count);
+	Pointer_Plan->Chunk_Values_Count = (unsigned int) Chunk_Values_Count;
+	Pointer_Plan->Workers_Count = Workers_Count;
+	Pointer_Plan->Arena_Size += Workers_Count * Formatter_Size;
+	Pointer_Plan->Estimated_Memory_Size = MAIN_MEMORY_PLANNER_BASE_SIZE + Workers_Count * MAIN_MEMORY_PLANNER_WORKER_SIZE + Pointer_Plan->Arena_Size;
+	return 0;
+}
+
+/** Display the computation plan.
+ * @param Pointer_Plan The plan.
+ * @param ADC_Resolution The ADC resolution.
+ */
+static void MainDisplayExecutionPlan(const TMainExecutionPlan *Pointer_Plan, unsigned int ADC_Resolution)
+{
+	const char *Pointer_String_Mode;
+	
+	if (Pointer_Plan->Is_Streaming_Enabled) Pointer_String_Mode = "streaming";
+	else if (Pointer_Plan->Is_Temperature_Only_Retained) Pointer_String_Mode = "in-memory (temperatures column only)";
+	else Pointer_String_Mode = "in-memory";
+	fprintf(stderr, "Execution plan : %s, %u value(s) computed at once in %u chunk(s), %u worker(s), %.3f MB estimated peak memory.\n", Pointer_String_Mode, Pointer_Plan->Chunk_Values_Count, (ADC_Resolution + Pointer_Plan->Chunk_Values_Count - 1) / Pointer_Plan->Chunk_Values_Count, Pointer_Plan->Workers_Count, Pointer_Plan->Estimated_Memory_Size / 1e6);
+}
+
+/** Display the process peak resident memory on the standard error output, it is registered with atexit() so all the program modes report it. */
+static void MainDisplayPeakMemoryUsage(void)
+{
+	struct rusage Usage;
+	
+	if (getrusage(RUSAGE_SELF, &Usage) != 0) return;
+	fprintf(stderr, "Peak resident memory : %.3f MB.\n", Usage.ru_maxrss * 1024 / 1e6); // The size is given in kilobytes
+}
+
+/** Write the execution trace, this function is called when the program exits so all modes are traced up to their end. */
+static void MainWriteTrace(void)
+{
+	if (TraceWrite(Main_Pointer_String_Trace_File_Name) != 0) fprintf(stderr, "Error : failed to write the execution trace to \"%s\".\n", Main_Pointer_String_Trace_File_Name);
+}
+
+/** Compute the table by chunks of the Values array size, and display the same tables as the in-memory mode. The chunks are recomputed for each displayed table, so only a chunk is in memory at any time.
+ * @param Pointer_Configuration The table parameters.
+ * @param Pointer_Expression_Program The custom model, or NULL to use the Beta model.
+ * @param Pointer_Plan The plan giving the chunk size and the workers count.
+ * @param Pointer_String_Binary_File_Name When not NULL, also write the binary values to this file ('-' to write only the binary values to the standard output).
+ * @param Is_Thermocouple_Enabled Set to 1 to display the cold-junction compensation table (Main_Cold_Junction_Voltages must be allocated for a whole chunk).
+ * @param Thermocouple_Type The thermocouple type.
+ * @param Is_Statistics_Display_Enabled Set to 1 to display the first chunk computation statistics.
+ * @return 0 on success,
+ * @return -1 if the binary values could not be written,
+ * @return -2 if the detail table could not be written.
+ */
+static int MainDisplayStreamedTables(const TMainConfiguration *Pointer_Configuration, const TExpressionProgram *Pointer_Expression_Program, const TMainExecutionPlan *Pointer_Plan, const char *Pointer_String_Binary_File_Name, int Is_Thermocouple_Enabled, TThermocoupleType Thermocouple_Type, int Is_Statistics_Display_Enabled)
+{
+	unsigned int i, First_ADC_Value, Count, ADC_Resolution = Pointer_Configuration->ADC_Resolution;
+	int Pass, Passes_Count = Is_Thermocouple_Enabled ? 3 : 2, Result = 0;
+	FILE *Pointer_Binary_File = NULL;
+	
+	if (Pointer_String_Binary_File_Name != NULL)
+	{
+		if (strcmp(Pointer_String_Binary_File_Name, "-") == 0)
+		{
+			Pointer_Binary_File = stdout;
+			Passes_Count = 1;
+		}
+		else
+		{
+			Pointer_Binary_File = fopen(Pointer_String_Binary_File_Name, "wb");
+			if (Pointer_Binary_File == NULL) return -1;
+		}
+	}
+	
+	// The first pass displays the detail table, the second one the lookup table and the last one the cold-junction compensation table
+	for (Pass = 0; Pass < Passes_Count; Pass++)
+	{
+		if (Pass == 0)
+		{
+			if (Pointer_Binary_File != stdout) printf("ADC value	Thermistor voltage (V)	Thermistor resistance (ohm)	Thermistor temperature (Celsius)\n");
+		}
+		else if (Pass == 1) printf("\nADC lookup table :\n");
+		else printf("\nType %c thermocouple cold-junction compensation table (microvolts) :\n", ThermocoupleGetTypeLetter(Thermocouple_Type));
+		
+		for (First_ADC_Value = 0; First_ADC_Value < ADC_Resolution; First_ADC_Value += Count)
+		{
+			Count = ADC_Resolution - First_ADC_Value < Pointer_Plan->Chunk_Values_Count ? ADC_Resolution - First_ADC_Value : Pointer_Plan->Chunk_Values_Count;
+			MainComputeValues(Pointer_Configuration, Pointer_Expression_Program, First_ADC_Value, First_ADC_Value + Count, Pointer_Plan->Workers_Count, Is_Statistics_Display_Enabled && (Pass == 0) && (First_ADC_Value == 0));
+			
+			if (Pass == 0)
+			{
+				if ((Pointer_Binary_File != NULL) && (fwrite(Values, sizeof(Values[0]), Count, Pointer_Binary_File) != Count)) Result = -1;
+				if ((Pointer_Binary_File != stdout) && (MainDisplayDetailTable(First_ADC_Value, Count, Pointer_Plan->Workers_Count) != 0))
+				{
+					Result = -2;
+					break;
+				}
+			}
+			else if (Pass == 1)
+			{
+				MainDisplayRoundedNumbers(&Values[0].Thermistor_Temperature, MAIN_VALUES_STRIDE, Count, First_ADC_Value, ADC_Resolution, "%4d, ");
+			}
+			else
+			{
+				for (i = 0; i < Count; i++) Main_Cold_Junction_Voltages[i] = Values[i].Thermistor_Temperature;
+				ThermocoupleComputeVoltages(Thermocouple_Type, Main_Cold_Junction_Voltages, Main_Cold_Junction_Voltages, Count);
+				for (i = 0; i < Count; i++) Main_Cold_Junction_Voltages[i] *= 1000.; // Convert to microvolts
+				MainDisplayRoundedNumbers(Main_Cold_Junction_Voltages, 1, Count, First_ADC_Value, ADC_Resolution, "%6d, ");
+			}
+		}
+	}
+	
+	if (Pointer_Binary_File == stdout)
+	{
+		if (fflush(stdout) != 0) Result = -1;
+	}
+	else if ((Pointer_Binary_File != NULL) && (fclose(Pointer_Binary_File) != 0)) Result = -1;
+	return Result;
+}
+
+/** Write the table as JSON or NDJSON to the standard output. The values are computed and serialized by chunks of the Values array size, so the memory usage does not depend on the table size.
+ * JSON output is a single object containing the parameters, the columns names, the rows, the lookup table and the cold-junction compensation table when requested. NDJSON output is a parameters object line followed by an object line per ADC value, including its lookup table and cold-junction compensation entries.
+ * The tables entries are rounded and saturated the same way as the displayed tables.
+ * @param Pointer_Configuration The table parameters.
+ * @param Pointer_String_Expression The custom model expression, or NULL when the Beta model is used.
+ * @param Pointer_Expression_Program The compiled custom model, or NULL to use the Beta model.
+ * @param Pointer_Plan The plan giving the chunk size and the workers count.
+ * @param Output_Format The JSON flavor.
+ * @param Is_Thermocouple_Enabled Set to 1 to write the cold-junction compensation table (Main_Cold_Junction_Voltages must be allocated for a whole chunk).
+ * @param Thermocouple_Type The thermocouple type.
+ */
+static void MainWriteJSONTables(const TMainConfiguration *Pointer_Configuration, const char *Pointer_String_Expression, const TExpressionProgram *Pointer_Expression_Program, const TMainExecutionPlan *Pointer_Plan, TMainOutputFormat Output_Format, int Is_Thermocouple_Enabled, TThermocoupleType Thermocouple_Type)
+{
+	int Lookup_Temperatures[MAIN_STREAM_BLOCK_SIZE], Compensation_Voltages[MAIN_STREAM_BLOCK_SIZE];
+	unsigned int i, First_ADC_Value, Count, Block_Size, ADC_Resolution = Pointer_Configuration->ADC_Resolution;
+	int Pass, Passes_Count = 1;
+	unsigned long long Trace_Start_Time;
+	char String_Thermocouple_Type[2];
+	
+	if (Output_Format == MAIN_OUTPUT_FORMAT_JSON) Passes_Count = Is_Thermocouple_Enabled ? 3 : 2;
+	
+	// Parameters
+	MainWriteStreamString("{\"parameters\":{\"circuit_variant\":");
+	MainWriteStreamJSONNumber(Pointer_Configuration->Circuit_Variant);
+	MainWriteStreamString(",\"voltage_divider_resistor\":");
+	MainWriteStreamJSONNumber(Pointer_Configuration->Voltage_Divider_Resistor);
+	MainWriteStreamString(",\"voltage_divider_bridge_voltage\":");
+	MainWriteStreamJSONNumber(Pointer_Configuration->Voltage_Divider_Bridge_Voltage);
+	MainWriteStreamString(",\"adc_resolution\":");
+	MainWriteStreamJSONNumber(ADC_Resolution);
+	if (Pointer_String_Expression != NULL)
+	{
+		MainWriteStreamString(",\"model\":\"expression\",\"expression\":");
+		MainWriteStreamJSONString(Pointer_String_Expression);
+	}
+	else
+	{
+		MainWriteStreamString(",\"model\":\"beta\",\"thermistor_beta_coefficient\":");
+		MainWriteStreamJSONNumber(Pointer_Configuration->Thermistor_Beta_Coefficient);
+		MainWriteStreamString(",\"thermistor_reference_resistance\":");
+		MainWriteStreamJSONNumber(Pointer_Configuration->Thermistor_Reference_Resistance);
+	}
+	if (Is_Thermocouple_Enabled)
+	{
+		String_Thermocouple_Type[0] = ThermocoupleGetTypeLetter(Thermocouple_Type);
+		String_Thermocouple_Type[1] = 0;
+		MainWriteStreamString(",\"thermocouple_type\":");
+		MainWriteStreamJSONString(String_Thermocouple_Type);
+	}
+	if (Output_Format == MAIN_OUTPUT_FORMAT_JSON) MainWriteStreamString("},\n\"columns\":[\"adc_value\",\"thermistor_voltage\",\"thermistor_resistance\",\"thermistor_temperature\"],\n\"rows\":[\n");
+	else MainWriteStreamString("}}\n");
+	
+	// The first pass writes the rows, the second one the JSON lookup table and the last one the JSON cold-junction compensation table (the NDJSON rows contain their tables entries)
+	for (Pass = 0; Pass < Passes_Count; Pass++)
+	{
+		if (Pass == 1) MainWriteStreamString("],\n\"lookup_table\":[");
+		else if (Pass == 2) MainWriteStreamString("],\n\"cold_junction_compensation_table\":[");
+		
+		for (First_ADC_Value = 0; First_ADC_Value < ADC_Resolution; First_ADC_Value += Count)
+		{
+			Count = ADC_Resolution - First_ADC_Value < Pointer_Plan->Chunk_Values_Count ? ADC_Resolution - First_ADC_Value : Pointer_Plan->Chunk_Values_Count;
+			MainComputeValues(Pointer_Configuration, Pointer_Expression_Program, First_ADC_Value, First_ADC_Value + Count, Pointer_Plan->Workers_Count, 0);
+			
+			// Compute the thermocouple voltages (in microvolts) at the thermistor temperatures
+			if (Is_Thermocouple_Enabled && ((Output_Format == MAIN_OUTPUT_FORMAT_NDJSON) || (Pass == 2)))
+			{
+				for (i = 0; i < Count; i++) Main_Cold_Junction_Voltages[i] = Values[i].Thermistor_Temperature;
+				ThermocoupleComputeVoltages(Thermocouple_Type, Main_Cold_Junction_Voltages, Main_Cold_Junction_Voltages, Count);
+				for (i = 0; i < Count; i++) Main_Cold_Junction_Voltages[i] *= 1000.;
+			}
+			
+			Trace_Start_Time = TraceGetTime();
+			for (i = 0; i < Count; i++)
+			{
+				// Round the tables entries by blocks
+				if (i % MAIN_STREAM_BLOCK_SIZE == 0)
+				{
+					Block_Size = Count - i < MAIN_STREAM_BLOCK_SIZE ? Count - i : MAIN_STREAM_BLOCK_SIZE;
+					if ((Output_Format == MAIN_OUTPUT_FORMAT_NDJSON) || (Pass == 1)) PackerRoundAndPack(&Values[i].Thermistor_Temperature, MAIN_VALUES_STRIDE, Block_Size, PACKER_WIDTH_32_BITS, Lookup_Temperatures);
+					if (Is_Thermocouple_Enabled && ((Output_Format == MAIN_OUTPUT_FORMAT_NDJSON) || (Pass == 2))) PackerRoundAndPack(&Main_Cold_Junction_Voltages[i], 1, Block_Size, PACKER_WIDTH_32_BITS, Compensation_Voltages);
+				}
+				
+				if (Output_Format == MAIN_OUTPUT_FORMAT_NDJSON)
+				{
+					MainWriteStreamString("{\"adc_value\":");
+					MainWriteStreamJSONNumber(First_ADC_Value + i);
+					MainWriteStreamString(",\"thermistor_voltage\":");
+					MainWriteStreamJSONNumber(Values[i].Voltage_Divider_Output_Voltage);
+					MainWriteStreamString(",\"thermistor_resistance\":");
+					MainWriteStreamJSONNumber(Values[i].Thermistor_Resistance);
+					MainWriteStreamString(",\"thermistor_temperature\":");
+					MainWriteStreamJSONNumber(Values[i].Thermistor_Temperature);
+					MainWriteStreamString(",\"lookup_table_temperature\":");
+					MainWriteStreamJSONNumber(Lookup_Temperatures[i % MAIN_STREAM_BLOCK_SIZE]);
+					if (Is_Thermocouple_Enabled)
+					{
+						MainWriteStreamString(",\"cold_junction_compensation\":");
+						MainWriteStreamJSONNumber(Compensation_Voltages[i % MAIN_STREAM_BLOCK_SIZE]);
+					}
+					MainWriteStreamString("}\n");
+				}
+				else if (Pass == 0)
+				{
+					MainWriteStreamString("[");
+					MainWriteStreamJSONNumber(First_ADC_Value + i);
+					MainWriteStreamString(",");
+					MainWriteStreamJSONNumber(Values[i].Voltage_Divider_Output_Voltage);
+					MainWriteStreamString(",");
+					MainWriteStreamJSONNumber(Values[i].Thermistor_Resistance);
+					MainWriteStreamString(",");
+					MainWriteStreamJSONNumber(Values[i].Thermistor_Temperature);
+					MainWriteStreamString(First_ADC_Value + i + 1 < ADC_Resolution ? "],\n" : "]\n");
+				}
+				else
+				{
+					MainWriteStreamJSONNumber(Pass == 1 ? Lookup_Temperatures[i % MAIN_STREAM_BLOCK_SIZE] : Compensation_Voltages[i % MAIN_STREAM_BLOCK_SIZE]);
+					if (First_ADC_Value + i + 1 < ADC_Resolution) MainWriteStreamString(",");
+				}
+			}
+			TraceRecordSpan(TRACE_SPAN_FORMAT, Trace_Start_Time);
+		}
+	}
+	if (Output_Format == MAIN_OUTPUT_FORMAT_JSON) MainWriteStreamString("]}\n");
+	
+	MainFlushStreamOutput();
+}
+
+/** Tell how many temperatures a forward table range holds.
+ * @param Minimum_Temperature The range lowest temperature (Celsius).
+ * @param Maximum_Temperature The range highest temperature (Celsius).
+ * @param Temperature_Step The difference between two consecutive table temperatures (Celsius).
+ * @return The temperatures count, as a floating number so that the caller can check it before converting it to an integer.
+ */
+static double MainComputeForwardTemperaturesCount(double Minimum_Temperature, double Maximum_Temperature, double Temperature_Step)
+{
+	return floor((Maximum_Temperature - Minimum_Temperature) / Temperature_Step + 1e-9) + 1; // Add a small value to make sure that the maximum temperature is included despite rounding errors
+}
+
+/** Display the forward table (thermistor resistance, voltage divider output voltage and DAC value for each temperature of a range), followed by the DAC lookup table.
+ * @param Circuit_Variant The selected circuit variant (must be 1 or 2).
+ * @param Voltage_Divider_Bridge_Voltage Vcc voltage in volts.
+ * @param Voltage_Divider_Resistor The bridge resistor value in ohms.
+ * @param Thermistor_Beta_Coefficient Beta coefficient value.
+ * @param Thermistor_Reference_Resistance Thermistor R25 resistor value (ohms).
+ * @param DAC_Resolution The DAC resolution.
+ * @param Minimum_Temperature The range lowest temperature (Celsius).
+ * @param Maximum_Temperature The range highest temperature (Celsius).
+ * @param Temperature_Step The difference between two consecutive table temperatures (Celsius). The range must hold at most MAIN_MAXIMUM_FORWARD_TEMPERATURES_COUNT temperatures.
+ */
+static void MainDisplayForwardTable(int Circuit_Variant, double Voltage_Divider_Bridge_Voltage, double Voltage_Divider_Resistor, double Thermistor_Beta_Coefficient, double Thermistor_Reference_Resistance, unsigned int DAC_Resolution, double Minimum_Temperature, double Maximum_Temperature, double Temperature_Step)
+{
+	unsigned int i, Temperatures_Count, DAC_Value;
+	int j;
+	double Temperature, Thermistor_Resistance, Voltage;
+	
+	Temperatures_Count = (unsigned int) MainComputeForwardTemperaturesCount(Minimum_Temperature, Maximum_Temperature, Temperature_Step);
+	
+	printf("Thermistor temperature (Celsius)	Thermistor resistance (ohm)	Thermistor voltage (V)	DAC value\n");
+	for (i = 0; i < Temperatures_Count; i++)
+	{
+		Temperature = Minimum_Temperature + i * Temperature_Step;
+		Thermistor_Resistance = MainComputeThermistorResistanceFromTemperature(Thermistor_Beta_Coefficient, Thermistor_Reference_Resistance, Temperature);
+		Voltage = MainComputeVoltageDividerOutputVoltageFromResistance(Circuit_Variant, Voltage_Divider_Bridge_Voltage, Thermistor_Resistance, Voltage_Divider_Resistor);
+		DAC_Value = MainComputeADCValue(Voltage_Divider_Bridge_Voltage, DAC_Resolution, Voltage);
+		printf("%lf			%lf			%lf		%u\n", Temperature, Thermistor_Resistance, Voltage, DAC_Value);
+	}
+	
+	printf("\nDAC lookup table :\n");
+	i = 0;
+	while (i < Temperatures_Count)
+	{
+		for (j = 0; j < MAIN_LOOKUP_TABLE_COLUMNS_COUNT; j++)
+		{
+			// Stop displaying when there is no more data to display
+			if (i >= Temperatures_Count) break;
+			
+			Temperature = Minimum_Temperature + i * Temperature_Step;
+			Thermistor_Resistance = MainComputeThermistorResistanceFromTemperature(Thermistor_Beta_Coefficient, Thermistor_Reference_Resistance, Temperature);
+			Voltage = MainComputeVoltageDividerOutputVoltageFromResistance(Circuit_Variant, Voltage_Divider_Bridge_Voltage, Thermistor_Resistance, Voltage_Divider_Resistor);
+			printf("%5u, ", MainComputeADCValue(Voltage_Divider_Bridge_Voltage, DAC_Resolution, Voltage));
+			i++;
+		}
+		putchar('\n');
+	}
+}
+
+/** Compute how many Celsius degrees a single ADC step is worth at a given temperature, using the analytic derivative of the voltage divider output voltage.
+ * The thermistor resistance derivative is dRt/dT = -Beta * Rt / T^2 and both circuit variants output voltage derivative is |dVout/dRt| = Vcc * R / (R + Rt)^2, so the step is T^2 * (R + Rt)^2 / (Beta * R * Rt * (ADC_Resolution - 1)) for both variants, regardless of the Vcc voltage.
+ * @param Thermistor_Beta_Coefficient Beta coefficient value.
+ * @param Thermistor_Reference_Resistance Thermistor R25 resistor value (ohms).
+ * @param Voltage_Divider_Resistor The bridge resistor value in ohms.
+ * @param ADC_Resolution The ADC resolution (corresponding to the amount of ADC steps).
+ * @param Thermistor_Temperature The temperature to evaluate the step at (Celsius).
+ * @return The temperature difference between two consecutive ADC values (Celsius).
+ */
+static double MainComputeADCStepTemperature(double Thermistor_Beta_Coefficient, double Thermistor_Reference_Resistance, double Voltage_Divider_Resistor, unsigned int ADC_Resolution, double Thermistor_Temperature)
+{
+	double Kelvin_Temperature, Thermistor_Resistance, Sum;
+	
+	Kelvin_Temperature = THERMISTOR_KELVIN_OFFSET + Thermistor_Temperature;
+	Thermistor_Resistance = MainComputeThermistorResistanceFromTemperature(Thermistor_Beta_Coefficient, Thermistor_Reference_Resistance, Thermistor_Temperature);
+	Sum = Voltage_Divider_Resistor + Thermistor_Resistance;
+	
+	return Kelvin_Temperature * Kelvin_Temperature * Sum * Sum / (Thermistor_Beta_Coefficient * Voltage_Divider_Resistor * Thermistor_Resistance * (ADC_Resolution - 1));
+}
+
+/** Find the biggest temperature difference between two consecutive ADC values over a temperature range.
+ * @param Thermistor_Beta_Coefficient Beta coefficient value.
+ * @param Thermistor_Reference_Resistance Thermistor R25 resistor value (ohms).
+ * @param Voltage_Divider_Resistor The bridge resistor value in ohms.
+ * @param ADC_Resolution The ADC resolution (corresponding to the amount of ADC steps).
+ * @param Minimum_Temperature The range lowest temperature (Celsius).
+ * @param Maximum_Temperature The range highest temperature (Celsius).
+ * @return The worst-case ADC step over the range (Celsius).
+ */
+static double MainComputeWorstADCStepTemperature(double Thermistor_Beta_Coefficient, double Thermistor_Reference_Resistance, double Voltage_Divider_Resistor, unsigned int ADC_Resolution, double Minimum_Temperature, double Maximum_Temperature)
+{
+	int i;
+	double Step, Worst_Step = 0;
+	
+	for (i = 0; i < MAIN_PLANNER_RANGE_SAMPLES_COUNT; i++)
+	{
+		Step = MainComputeADCStepTemperature(Thermistor_Beta_Coefficient, Thermistor_Reference_Resistance, Voltage_Divider_Resistor, ADC_Resolution, Minimum_Temperature + (Maximum_Temperature - Minimum_Temperature) * i / (MAIN_PLANNER_RANGE_SAMPLES_COUNT - 1));
+		if (Step > Worst_Step) Worst_Step = Step;
+	}
+	
+	return Worst_Step;
+}
+
+/** Find the smallest ADC resolution and the E12 voltage divider resistor that reach the requested temperature resolution over a temperature range, then display the result.
+ * @param Thermistor_Beta_Coefficient Beta coefficient value.
+ * @param Thermistor_Reference_Resistance Thermistor R25 resistor value (ohms).
+ * @param Minimum_Temperature The range lowest temperature (Celsius).
+ * @param Maximum_Temperature The range highest temperature (Celsius).
+ * @param Target_Step The biggest allowed temperature difference between two consecutive ADC values (Celsius).
+ * @return 0 if a configuration was found,
+ * @return -1 if no configuration can reach the requested resolution.
+ */
+static int MainPlanHardware(double Thermistor_Beta_Coefficient, double Thermistor_Reference_Resistance, double Minimum_Temperature, double Maximum_Temperature, double Target_Step)
+{
+	int ADC_Bits;
+	unsigned int i, ADC_Resolution;
+	double Decade, Resistor, Step, Best_Resistor = 0, Best_Step;
+	
+	printf("ADC bits	Best resistor (ohm)	Worst-case step (Celsius)\n");
+	for (ADC_Bits = MAIN_PLANNER_MINIMUM_ADC_BITS; ADC_Bits <= MAIN_PLANNER_MAXIMUM_ADC_BITS; ADC_Bits++)
+	{
+		ADC_Resolution = 1U << ADC_Bits;
+		
+		// Try all standard resistor values for this resolution
+		Best_Step = INFINITY;
+		for (Decade = MAIN_PLANNER_MINIMUM_RESISTOR_DECADE; Decade <= MAIN_PLANNER_MAXIMUM_RESISTOR_DECADE; Decade *= 10.)
+		{
+			for (i = 0; i < sizeof(Main_E12_Series_Values) / sizeof(Main_E12_Series_Values[0]); i++)
+			{
+				Resistor = Decade * Main_E12_Series_Values[i];
+				Step = MainComputeWorstADCStepTemperature(Thermistor_Beta_Coefficient, Thermistor_Reference_Resistance, Resistor, ADC_Resolution, Minimum_Temperature, Maximum_Temperature);
+				if (Step < Best_Step)
+				{
+					Best_Step = Step;
+					Best_Resistor = Resistor;
+				}
+			}
+		}
+		printf("%d		%lf		%lf\n", ADC_Bits, Best_Resistor, Best_Step);
+		
+		// Stop at the first resolution that fulfills the requirement
+		if (Best_Step <= Target_Step)
+		{
+			printf("\nMinimal configuration : %d-bit ADC (resolution %u), %g ohm voltage divider resistor, worst-case step %lf Celsius, margin %lf Celsius.\n", ADC_Bits, ADC_Resolution, Best_Resistor, Best_Step, Target_Step - Best_Step);
+			return 0;
+		}
+	}
+	
+	printf("\nNo configuration up to %d bits can reach a %lf Celsius step over the [%lf; %lf] Celsius range.\n", MAIN_PLANNER_MAXIMUM_ADC_BITS, Target_Step, Minimum_Temperature, Maximum_Temperature);
+	return -1;
+}
+
+/** Find the minimum of a unimodal function using the golden-section search.
+ * @param Objective_Function The function to minimize.
+ * @param Pointer_Context The objective constant parameters.
+ * @param Lower_Bound The searched interval lowest value.
+ * @param Upper_Bound The searched interval highest value.
+ * @param Tolerance Stop when the searched interval becomes smaller than this value.
+ * @param Pointer_Evaluations_Count On output, contain how many times the objective has been evaluated.
+ * @return The variable value corresponding to the found minimum.
+ */
+static double MainMinimizeGoldenSection(TMainObjectiveFunction Objective_Function, void *Pointer_Context, double Lower_Bound, double Upper_Bound, double Tolerance, int *Pointer_Evaluations_Count)
+{
+	double Inverse_Golden_Ratio = (sqrt(5.) - 1.) / 2., Left_X, Right_X, Left_Value, Right_Value;
+	
+	// Place the two inner points, each iteration will reuse one of them so only a single evaluation is needed per iteration
+	Left_X = Upper_Bound - Inverse_Golden_Ratio * (Upper_Bound - Lower_Bound);
+	Right_X = Lower_Bound + Inverse_Golden_Ratio * (Upper_Bound - Lower_Bound);
+	Left_Value = Objective_Function(Pointer_Context, Left_X);
+	Right_Value = Objective_Function(Pointer_Context, Right_X);
+	*Pointer_Evaluations_Count = 2;
+	
+	while (Upper_Bound - Lower_Bound > Tolerance)
+	{
+		// The minimum is in the left part of the interval
+		if (Left_Value < Right_Value)
+		{
+			Upper_Bound = Right_X;
+			Right_X = Left_X;
+			Right_Value = Left_Value;
+			Left_X = Upper_Bound - Inverse_Golden_Ratio * (Upper_Bound - Lower_Bound);
+			Left_Value = Objective_Function(Pointer_Context, Left_X);
+		}
+		// The minimum is in the right part of the interval
+		else
+		{
+			Lower_Bound = Left_X;
+			Left_X = Right_X;
+			Left_Value = Right_Value;
+			Right_X = Lower_Bound + Inverse_Golden_Ratio * (Upper_Bound - Lower_Bound);
+			Right_Value = Objective_Function(Pointer_Context, Right_X);
+		}
+		(*Pointer_Evaluations_Count)++;
+	}
+	
+	return (Lower_Bound + Upper_Bound) / 2.;
+}
+
+/** The worst-case ADC step objective, evaluated for a voltage divider resistor natural logarithm (searching on the logarithm gives the same relative precision for all resistor decades).
+ * @param Pointer_Context A TMainWorstADCStepObjectiveContext structure.
+ * @param Logarithmic_Resistor The voltage divider resistor value natural logarithm.
+ * @return The worst-case ADC step over the range (Celsius).
+ */
+static double MainWorstADCStepObjective(void *Pointer_Context, double Logarithmic_Resistor)
+{
+	TMainWorstADCStepObjectiveContext *Pointer_Objective_Context = Pointer_Context;
+	
+	return MainComputeWorstADCStepTemperature(Pointer_Objective_Context->Thermistor_Beta_Coefficient, Pointer_Objective_Context->Thermistor_Reference_Resistance, exp(Logarithmic_Resistor), Pointer_Objective_Context->ADC_Resolution, Pointer_Objective_Context->Minimum_Temperature, Pointer_Objective_Context->Maximum_Temperature);
+}
+
+/** Find the voltage divider resistor value that minimizes the worst-case ADC step over a temperature range, then display the result.
+ * @param Thermistor_Beta_Coefficient Beta coefficient value.
+ * @param Thermistor_Reference_Resistance Thermistor R25 resistor value (ohms).
+ * @param ADC_Resolution The ADC resolution.
+ * @param Minimum_Temperature The range lowest temperature (Celsius).
+ * @param Maximum_Temperature The range highest temperature (Celsius).
+ */
+static void MainOptimizeVoltageDividerResistor(double Thermistor_Beta_Coefficient, double Thermistor_Reference_Resistance, unsigned int ADC_Resolution, double Minimum_Temperature, double Maximum_Temperature)
+{
+	TMainWorstADCStepObjectiveContext Context;
+	double Logarithmic_Resistor;
+	int Evaluations_Count;
+	
+	Context.Thermistor_Beta_Coefficient = Thermistor_Beta_Coefficient;
+	Context.Thermistor_Reference_Resistance = Thermistor_Reference_Resistance;
+	Context.ADC_Resolution = ADC_Resolution;
+	Context.Minimum_Temperature = Minimum_Temperature;
+	Context.Maximum_Temperature = Maximum_Temperature;
+	
+	Logarithmic_Resistor = MainMinimizeGoldenSection(MainWorstADCStepObjective, &Context, log(MAIN_OPTIMIZER_MINIMUM_RESISTOR), log(MAIN_OPTIMIZER_MAXIMUM_RESISTOR), MAIN_OPTIMIZER_TOLERANCE, &Evaluations_Count);
+	
+	printf("Optimal voltage divider resistor : %lf ohm.\n", exp(Logarithmic_Resistor));
+	printf("Worst-case step over the [%lf; %lf] Celsius range : %lf Celsius.\n", Minimum_Temperature, Maximum_Temperature, MainWorstADCStepObjective(&Context, Logarithmic_Resistor));
+	printf("Objective evaluations : %d.\n", Evaluations_Count);
+}
+
+/** Compute the biggest temperature error of a circuit over the operating range, when its ADC values are converted with the nominal lookup table.
+ * The ADC reference is the voltage divider supply, so the thermistor resistance is the voltage divider resistor value times a factor depending only on the ADC value. A resistors deviation is then an offset of the resistance logarithm, and no logarithm is computed per ADC value.
+ * @param Pointer_Problem The yield estimation problem.
+ * @param Pointer_Deviations The Beta, R25 and voltage divider resistor deviations, in standard deviations.
+ * @return The biggest absolute temperature error (Celsius), the search stops as soon as the error limit is exceeded.
+ */
+static double MainComputeYieldError(TMainYieldProblem *Pointer_Problem, const double *Pointer_Deviations)
+{
+	double Factors[MAIN_YIELD_PARAMETERS_COUNT], Logarithmic_Offset, Inverse_Beta, Error, Maximum_Error = 0;
+	unsigned int i;
+	
+	Pointer_Problem->Evaluations_Count++;
+	for (i = 0; i < MAIN_YIELD_PARAMETERS_COUNT; i++)
+	{
+		Factors[i] = 1. + Pointer_Problem->Standard_Deviations[i] * Pointer_Deviations[i];
+		if (Factors[i] <= 0) return HUGE_VAL; // Such a part can't work
+	}
+	Inverse_Beta = 1. / (Pointer_Problem->Thermistor_Beta_Coefficient * Factors[0]);
+	Logarithmic_Offset = log(Factors[2] / Factors[1]);
+	
+	for (i = 0; i < Pointer_Problem->Values_Count; i++)
+	{
+		Error = fabs(1. / ((Pointer_Problem->Pointer_Logarithmic_Resistances[i] + Logarithmic_Offset) * Inverse_Beta + 1. / (THERMISTOR_KELVIN_OFFSET + THERMISTOR_REFERENCE_TEMPERATURE)) - THERMISTOR_KELVIN_OFFSET - Pointer_Problem->Pointer_Table_Temperatures[i]);
+		if (Error > Maximum_Error)
+		{
+			Maximum_Error = Error;
+			if (Maximum_Error > Pointer_Problem->Error_Limit) break;
+		}
+	}
+	return Maximum_Error;
+}
+
+/** Find how far from the nominal parameters the circuits start failing in a direction of the parameters space.
+ * @param Pointer_Problem The yield estimation problem.
+ * @param Pointer_Direction The direction, a unit vector in standard deviations.
+ * @return The failure boundary distance (standard deviations), 0 if the nominal circuit fails,
+ * @return HUGE_VAL if no circuit fails up to MAIN_YIELD_MAXIMUM_DISTANCE.
+ */
+static double MainFindYieldFailureDistance(TMainYieldProblem *Pointer_Problem, const double *Pointer_Direction)
+{
+	double Deviations[MAIN_YIELD_PARAMETERS_COUNT], Lower_Distance = 0, Upper_Distance = MAIN_YIELD_MAXIMUM_DISTANCE, Distance;
+	int i;
+	
+	if (MainComputeYieldError(Pointer_Problem, (double [MAIN_YIELD_PARAMETERS_COUNT]) {0}) > Pointer_Problem->Error_Limit) return 0;
+	for (i = 0; i < MAIN_YIELD_PARAMETERS_COUNT; i++) Deviations[i] = Pointer_Direction[i] * Upper_Distance;
+	if (MainComputeYieldError(Pointer_Problem, Deviations) <= Pointer_Problem->Error_Limit) return HUGE_VAL;
+	
+	// The error grows with the deviation, so bisect the distance
+	while (Upper_Distance - Lower_Distance > MAIN_YIELD_DISTANCE_PRECISION)
+	{
+		Distance = (Lower_Distance + Upper_Distance) / 2.;
+		for (i = 0; i < MAIN_YIELD_PARAMETERS_COUNT; i++) Deviations[i] = Pointer_Direction[i] * Distance;
+		if (MainComputeYieldError(Pointer_Problem, Deviations) > Pointer_Problem->Error_Limit) Upper_Distance = Distance;
+		else Lower_Distance = Distance;
+	}
+	return Upper_Distance;
+}
+
+/** Draw a point of a normal distribution with unit variances.
+ * @param Pointer_Random_State The xorshift64* generator state.
+ * @param Pointer_Mean The distribution mean.
+ * @param Pointer_Point On output, contain the point.
+ */
+static void MainGenerateYieldPoint(uint64_t *Pointer_Random_State, const double *Pointer_Mean, double *Pointer_Point)
+{
+	double X, Y, Radius;
+	int i;
+	
+	// Get two gaussian numbers from each pair of uniform numbers with the Marsaglia polar method
+	for (i = 0; i < MAIN_YIELD_PARAMETERS_COUNT; i += 2)
+	{
+		do
+		{
+			X = 2. * MainGenerateRandomNumber(Pointer_Random_State) - 1.;
+			Y = 2. * MainGenerateRandomNumber(Pointer_Random_State) - 1.;
+			Radius = X * X + Y * Y;
+		} while ((Radius >= 1.) || (Radius == 0));
+		Radius = sqrt(-2. * log(Radius) / Radius);
+		Pointer_Point[i] = Pointer_Mean[i] + X * Radius;
+		if (i + 1 < MAIN_YIELD_PARAMETERS_COUNT) Pointer_Point[i + 1] = Pointer_Mean[i + 1] + Y * Radius;
+	}
+}
+
+/** Compute the importance sampling weight of a point drawn from a mixture of the nominal parameters distribution and of equally weighted normal distributions with unit variances, this is the nominal parameters density divided by the mixture density.
+ * @param Pointer_Means The shifted distributions means, MAIN_YIELD_PARAMETERS_COUNT values per distribution.
+ * @param Distributions_Count How many shifted distributions the mixture has.
+ * @param Nominal_Share The nominal distribution weight in the mixture, the shifted distributions share the rest.
+ * @param Pointer_Point The point.
+ * @return The point weight.
+ */
+static double MainComputeYieldWeight(const double *Pointer_Means, int Distributions_Count, double Nominal_Share, const double *Pointer_Point)
+{
+	double Sum = 0, Exponent;
+	int i, j;
+	
+	for (i = 0; i < Distributions_Count; i++)
+	{
+		Exponent = 0;
+		for (j = 0; j < MAIN_YIELD_PARAMETERS_COUNT; j++) Exponent += Pointer_Means[i * MAIN_YIELD_PARAMETERS_COUNT + j] * (Pointer_Point[j] - Pointer_Means[i * MAIN_YIELD_PARAMETERS_COUNT + j] / 2.);
+		Sum += exp(Exponent);
+	}
+	return 1. / (Nominal_Share + (1. - Nominal_Share) * Sum / Distributions_Count);
+}
+
+/** Compute the nominal lookup table of the ADC values converting to the operating range.
+ * @param Pointer_Configuration The nominal circuit, the ADC resolution included.
+ * @param Minimum_Temperature The operating range lowest temperature (Celsius).
+ * @param Maximum_Temperature The operating range highest temperature (Celsius).
+ * @param Pointer_Problem On output, contain the operating range ADC values. The arrays are allocated from the main arena.
+ * @return 0 on success,
+ * @return -1 if no ADC value converts to the operating range,
+ * @return -2 if the arrays could not be allocated.
+ */
+static int MainPrepareYieldProblem(const TMainConfiguration *Pointer_Configuration, double Minimum_Temperature, double Maximum_Temperature, TMainYieldProblem *Pointer_Problem)
+{
+	double *Pointer_Logarithmic_Resistances, *Pointer_Table_Temperatures, Resistance, Temperature;
+	unsigned int ADC_Value, Count = 0;
+	
+	Pointer_Logarithmic_Resistances = ArenaAllocate(&Main_Arena, Pointer_Configuration->ADC_Resolution * sizeof(double));
+	Pointer_Table_Temperatures = ArenaAllocate(&Main_Arena, Pointer_Configuration->ADC_Resolution * sizeof(double));
+	if ((Pointer_Logarithmic_Resistances == NULL) || (Pointer_Table_Temperatures == NULL)) return -2;
+	
+	// The lowest and highest ADC values do not correspond to a finite resistance (the comparison does not wrap around when the resolution is smaller than 2)
+	for (ADC_Value = 1; ADC_Value + 1 < Pointer_Configuration->ADC_Resolution; ADC_Value++)
+	{
+		Resistance = ThermistorComputeResistance(Pointer_Configuration->Circuit_Variant, Pointer_Configuration->Voltage_Divider_Bridge_Voltage, ThermistorComputeVoltageDividerOutputVoltage(Pointer_Configuration->Voltage_Divider_Bridge_Voltage, Pointer_Configuration->ADC_Resolution, ADC_Value), Pointer_Configuration->Voltage_Divider_Resistor);
+		Temperature = ThermistorComputeTemperature(Pointer_Configuration->Thermistor_Beta_Coefficient, Pointer_Configuration->Thermistor_Reference_Resistance, Resistance);
+		if ((Temperature < Minimum_Temperature) || (Temperature > Maximum_Temperature)) continue;
+		
+		Pointer_Logarithmic_Resistances[Count] = log(Resistance / Pointer_Configuration->Thermistor_Reference_Resistance);
+		Pointer_Table_Temperatures[Count] = (double) lrint(Temperature); // The firmware stores the rounded temperatures
+		Count++;
+	}
+	if (Count == 0) return -1;
+	
+	Pointer_Problem->Pointer_Logarithmic_Resistances = Pointer_Logarithmic_Resistances;
+	Pointer_Problem->Pointer_Table_Temperatures = Pointer_Table_Temperatures;
+	Pointer_Problem->Values_Count = Count;
+	Pointer_Problem->Thermistor_Beta_Coefficient = Pointer_Configuration->Thermistor_Beta_Coefficient;
+	Pointer_Problem->Evaluations_Count = 0;
+	return 0;
+}
+
+/** Estimate the probability that a circuit built with toleranced parts converts an ADC value of the operating range with an error bigger than a limit, when the firmware uses the nominal lookup table, then display the result.
+ * Such failures are too rare for a plain Monte Carlo simulation, so the circuits are drawn around the worst-case corners of the parameters space instead. The failure boundary is first searched in the direction of each corner, then the cross-entropy method moves a normal distribution from each boundary point toward the most likely failures. The probability is finally estimated by importance sampling from the mixture of these distributions and of the nominal one, so that the failures no corner points to are still counted.
+ * @param Pointer_Problem The yield estimation problem.
+ * @param Is_Statistics_Display_Enabled Set to 1 to display the circuit evaluations count on the standard error output.
+ */
+static void MainEstimateYield(TMainYieldProblem *Pointer_Problem, int Is_Statistics_Display_Enabled)
+{
+	static const char Signs[2] = {'+', '-'};
+	double Distances[MAIN_YIELD_CORNERS_COUNT], Means[MAIN_YIELD_CORNERS_COUNT * MAIN_YIELD_PARAMETERS_COUNT], Direction[MAIN_YIELD_PARAMETERS_COUNT], Point[MAIN_YIELD_PARAMETERS_COUNT], Sums[MAIN_YIELD_PARAMETERS_COUNT], *Pointer_Mean, Nearest_Distance = HUGE_VAL, Weight, Weights_Sum, Weighted_Sum = 0, Squared_Weighted_Sum = 0, Probability, Standard_Error, Half_Width, Start_Time;
+	int Corner, Distributions_Count = 0, Nominal_Samples_Count, Iteration, i, j;
+	uint64_t Random_State = MAIN_YIELD_RANDOM_SEED;
+	
+	Start_Time = MainGetTime();
+	
+	// Find the failure boundary toward each corner
+	printf("Worst-case corners :\n");
+	printf("Beta	R25	Resistor	Failure distance (standard deviations)\n");
+	for (Corner = 0; Corner < MAIN_YIELD_CORNERS_COUNT; Corner++)
+	{
+		for (i = 0; i < MAIN_YIELD_PARAMETERS_COUNT; i++) Direction[i] = ((Corner >> i) & 1 ? -1. : 1.) / sqrt(MAIN_YIELD_PARAMETERS_COUNT);
+		Distances[Corner] = MainFindYieldFailureDistance(Pointer_Problem, Direction);
+		if (Distances[Corner] < Nearest_Distance) Nearest_Distance = Distances[Corner];
+		
+		printf("%c	%c	%c		", Signs[Corner & 1], Signs[(Corner >> 1) & 1], Signs[(Corner >> 2) & 1]);
+		if (Distances[Corner] == HUGE_VAL) printf("> %g\n", MAIN_YIELD_MAXIMUM_DISTANCE);
+		else printf("%.4f\n", Distances[Corner]);
+	}
+	if (Nearest_Distance == HUGE_VAL)
+	{
+		printf("\nFailure probability : negligible, no corner fails within %g standard deviations.\n", MAIN_YIELD_MAXIMUM_DISTANCE);
+		return;
+	}
+	
+	// Start a sampling distribution at each boundary point, and move it toward the failures that weigh the most in the probability
+	for (Corner = 0; Corner < MAIN_YIELD_CORNERS_COUNT; Corner++)
+	{
+		if (Distances[Corner] == HUGE_VAL) continue;
+		
+		Pointer_Mean = &Means[Distributions_Count * MAIN_YIELD_PARAMETERS_COUNT];
+		for (i = 0; i < MAIN_YIELD_PARAMETERS_COUNT; i++) Pointer_Mean[i] = ((Corner >> i) & 1 ? -1. : 1.) / sqrt(MAIN_YIELD_PARAMETERS_COUNT) * Distances[Corner];
+		for (Iteration = 0; Iteration < MAIN_YIELD_ADAPTATION_ITERATIONS_COUNT; Iteration++)
+		{
+			// The new mean is the failures mean, weighted by the likelihood ratio of the nominal and the current distributions
+			Weights_Sum = 0;
+			memset(Sums, 0, sizeof(Sums));
+			for (j = 0; j < MAIN_YIELD_ADAPTATION_SAMPLES_COUNT; j++)
+			{
+				MainGenerateYieldPoint(&Random_State, Pointer_Mean, Point);
+				if (MainComputeYieldError(Pointer_Problem, Point) <= Pointer_Problem->Error_Limit) continue;
+				Weight = MainComputeYieldWeight(Pointer_Mean, 1, 0, Point);
+				Weights_Sum += Weight;
+				for (i = 0; i < MAIN_YIELD_PARAMETERS_COUNT; i++) Sums[i] += Weight * Point[i];
+			}
+			if (Weights_Sum <= 0) break;
+			for (i = 0; i < MAIN_YIELD_PARAMETERS_COUNT; i++) Pointer_Mean[i] = Sums[i] / Weights_Sum;
+		}
+		Distributions_Count++;
+	}
+	
+	// Draw the nominal distribution share of the samples first, then the same amount of samples from each shifted distribution, and weight them by the nominal density divided by the mixture density
+	Nominal_Samples_Count = (int) (MAIN_YIELD_SAMPLES_COUNT * MAIN_YIELD_NOMINAL_SAMPLES_SHARE);
+	for (j = 0; j < MAIN_YIELD_SAMPLES_COUNT; j++)
+	{
+		if (j < Nominal_Samples_Count) MainGenerateYieldPoint(&Random_State, (double [MAIN_YIELD_PARAMETERS_COUNT]) {0}, Point);
+		else MainGenerateYieldPoint(&Random_State, &Means[((j - Nominal_Samples_Count) % Distributions_Count) * MAIN_YIELD_PARAMETERS_COUNT], Point);
+		if (MainComputeYieldError(Pointer_Problem, Point) <= Pointer_Problem->Error_Limit) continue;
+		Weight = MainComputeYieldWeight(Means, Distributions_Count, MAIN_YIELD_NOMINAL_SAMPLES_SHARE, Point);
+		Weighted_Sum += Weight;
+		Squared_Weighted_Sum += Weight * Weight;
+	}
+	Probability = Weighted_Sum / MAIN_YIELD_SAMPLES_COUNT;
+	Standard_Error = sqrt(fmax(Squared_Weighted_Sum / MAIN_YIELD_SAMPLES_COUNT - Probability * Probability, 0) / (MAIN_YIELD_SAMPLES_COUNT - 1));
+	Half_Width = 1.96 * Standard_Error;
+	
+	printf("\nFailure probability : %.4e (95%% confidence interval [%.4e; %.4e]).\n", Probability, fmax(Probability - Half_Width, 0), fmin(Probability + Half_Width, 1));
+	printf("Yield : %.8f %%.\n", (1. - Probability) * 100.);
+	printf("Importance sampling : %d samples drawn around the nominal parameters and %d corner(s)", MAIN_YIELD_SAMPLES_COUNT, Distributions_Count);
+	if ((Probability > 0) && (Standard_Error > 0)) printf(", plain Monte Carlo would need about %.3g samples for the same precision.\n", Probability * (1. - Probability) / (Standard_Error * Standard_Error));
+	else printf(".\n");
+	
+	if (Is_Statistics_Display_Enabled) fprintf(stderr, "Yield estimation : %llu circuit evaluations in %.3f s.\n", Pointer_Problem->Evaluations_Count, MainGetTime() - Start_Time);
+}
+
+/** Tell how much memory the autotuner needs.
+ * @param Workers_Count The biggest amount of threads the autotuner tries.
+ * @return The arena size in bytes.
+ */
+static size_t MainGetTunerMemorySize(unsigned int Workers_Count)
+{
+	// The benchmark table, and the double buffers of the formatters with the biggest rows count
+	return MAIN_TUNER_ADC_RESOLUTION * sizeof(TMainComputedValues) + Workers_Count * 2 * (MAIN_FORMATTER_BUFFER_SIZE(Main_Tuner_Formatter_Rows_Counts[MAIN_TUNER_SETTING_VALUES_COUNT - 1]) + 64) + 1024;
+}
+
+/** Time the values computation and the detail table output with all the settings of a grid, and save the fastest settings of this machine to the tuning profile. The Values array is allocated from the arena.
+ * @param Pointer_Configuration The circuit to compute the benchmark table with, its ADC resolution is not used.
+ * @param Online_CPUs_Count The workers counts are tried up to this value.
+ * @return 0 on success,
+ * @return -1 if an error occurred.
+ */
+static int MainTuneSettings(const TMainConfiguration *Pointer_Configuration, unsigned int Online_CPUs_Count)
+{
+	static double Compute_Times[MAIN_TUNER_MAXIMUM_WORKERS_COUNTS][MAIN_TUNER_SETTING_VALUES_COUNT], Output_Times[MAIN_TUNER_MAXIMUM_WORKERS_COUNTS][MAIN_TUNER_SETTING_VALUES_COUNT];
+	TMainConfiguration Configuration = *Pointer_Configuration;
+	unsigned int i, j, Workers_Counts[MAIN_TUNER_MAXIMUM_WORKERS_COUNTS], Workers_Counts_Count = 0, Repetition, Best_Compute_Indexes[MAIN_TUNER_MAXIMUM_WORKERS_COUNTS], Best_Output_Indexes[MAIN_TUNER_MAXIMUM_WORKERS_COUNTS], Best_Workers_Index = 0;
+	double Start_Time, Elapsed_Time;
+	int Saved_Output, Null_Output;
+	char String_File_Name[MAIN_WRITER_MAXIMUM_PATH_LENGTH];
+	TProfile Profile;
+	
+	Values = ArenaAllocate(&Main_Arena, MAIN_TUNER_ADC_RESOLUTION * sizeof(TMainComputedValues));
+	if (Values == NULL)
+	{
+		printf("Error : failed to allocate the benchmark table.\n");
+		return -1;
+	}
+	Configuration.ADC_Resolution = MAIN_TUNER_ADC_RESOLUTION;
+	
+	// Try the powers of two up to the online CPUs count, and the online CPUs count
+	if (Online_CPUs_Count > MAIN_MAXIMUM_WORKERS_COUNT) Online_CPUs_Count = MAIN_MAXIMUM_WORKERS_COUNT;
+	for (i = 1; i < Online_CPUs_Count; i *= 2) Workers_Counts[Workers_Counts_Count++] = i;
+	Workers_Counts[Workers_Counts_Count++] = Online_CPUs_Count;
+	
+	// Time the values computation
+	printf("Values computation (%d values) :\n", MAIN_TUNER_ADC_RESOLUTION);
+	printf("Workers	Minimum values per worker	Time (ms)\n");
+	for (i = 0; i < Workers_Counts_Count; i++)
+	{
+		Best_Compute_Indexes[i] = 0;
+		for (j = 0; j < MAIN_TUNER_SETTING_VALUES_COUNT; j++)
+		{
+			Main_Worker_Minimum_Values_Count = Main_Tuner_Worker_Minimum_Values_Counts[j];
+			Compute_Times[i][j] = HUGE_VAL;
+			for (Repetition = 0; Repetition < MAIN_TUNER_REPETITIONS_COUNT; Repetition++)
+			{
+				Start_Time = MainGetTime();
+				MainComputeValues(&Configuration, NULL, 0, MAIN_TUNER_ADC_RESOLUTION, Workers_Counts[i], 0);
+				Elapsed_Time = MainGetTime() - Start_Time;
+				if (Elapsed_Time < Compute_Times[i][j]) Compute_Times[i][j] = Elapsed_Time;
+			}
+			if (Compute_Times[i][j] < Compute_Times[i][Best_Compute_Indexes[i]]) Best_Compute_Indexes[i] = j;
+			printf("%u	%u	%.3f\n", Workers_Counts[i], Main_Tuner_Worker_Minimum_Values_Counts[j], Compute_Times[i][j] * 1000.);
+			fflush(stdout);
+		}
+	}
+	
+	// Time the detail table output, the table is written to the null device so the storage speed does not matter
+	fflush(stdout);
+	Saved_Output = dup(STDOUT_FILENO);
+	if (Saved_Output < 0)
+	{
+		printf("Error : could not duplicate the standard output (%s).\n", strerror(errno));
+		return -1;
+	}
+	Null_Output = open("/dev/null", O_WRONLY);
+	if ((Null_Output < 0) || (dup2(Null_Output, STDOUT_FILENO) < 0))
+	{
+		printf("Error : could not redirect the standard output to the null device (%s).\n", strerror(errno));
+		if (Null_Output >= 0) close(Null_Output);
+		close(Saved_Output);
+		return -1;
+	}
+	close(Null_Output);
+	for (i = 0; i < Workers_Counts_Count; i++)
+	{
+		Best_Output_Indexes[i] = 0;
+		for (j = 0; j < MAIN_TUNER_SETTING_VALUES_COUNT; j++)
+		{
+			// A single worker writes the rows with printf(), the formatter rows count does not matter
+			if ((Workers_Counts[i] == 1) && (j > 0))
+			{
+				Output_Times[i][j] = Output_Times[i][0];
+				continue;
+			}
+			
+			Main_Formatter_Rows_Count = Main_Tuner_Formatter_Rows_Counts[j];
+			Output_Times[i][j] = HUGE_VAL;
+			for (Repetition = 0; Repetition < MAIN_TUNER_REPETITIONS_COUNT; Repetition++)
+			{
+				Start_Time = MainGetTime();
+				MainDisplayDetailTable(0, MAIN_TUNER_ADC_RESOLUTION, Workers_Counts[i]);
+				fflush(stdout);
+				Elapsed_Time = MainGetTime() - Start_Time;
+				if (Elapsed_Time < Output_Times[i][j]) Output_Times[i][j] = Elapsed_Time;
+			}
+			if (Output_Times[i][j] < Output_Times[i][Best_Output_Indexes[i]]) Best_Output_Indexes[i] = j;
+		}
+	}
+	dup2(Saved_Output, STDOUT_FILENO);
+	close(Saved_Output);
+	
+	printf("\nDetail table output (%d rows) :\n", MAIN_TUNER_ADC_RESOLUTION);
+	printf("Workers	Formatter rows	Time (ms)\n");
+	for (i = 0; i < Workers_Counts_Count; i++)
+	{
+		for (j = 0; j < MAIN_TUNER_SETTING_VALUES_COUNT; j++) printf("%u	%u	%.3f\n", Workers_Counts[i], Main_Tuner_Formatter_Rows_Counts[j], Output_Times[i][j] * 1000.);
+	}
+	
+	// The same workers count computes and formats the table, so keep the one giving the fastest whole run
+	for (i = 1; i < Workers_Counts_Count; i++)
+	{
+		if (Compute_Times[i][Best_Compute_Indexes[i]] + Output_Times[i][Best_Output_Indexes[i]] < Compute_Times[Best_Workers_Index][Best_Compute_Indexes[Best_Workers_Index]] + Output_Times[Best_Workers_Index][Best_Output_Indexes[Best_Workers_Index]]) Best_Workers_Index = i;
+	}
+	Profile.Online_CPUs_Count = Online_CPUs_Count;
+	Profile.Workers_Count = Workers_Counts[Best_Workers_Index];
+	Profile.Worker_Minimum_Values_Count = Main_Tuner_Worker_Minimum_Values_Counts[Best_Compute_Indexes[Best_Workers_Index]];
+	Profile.Formatter_Rows_Count = Main_Tuner_Formatter_Rows_Counts[Best_Output_Indexes[Best_Workers_Index]];
+	printf("\nFastest settings : %u worker(s), %u minimum values per worker, %u formatter rows.\n", Profile.Workers_Count, Profile.Worker_Minimum_Values_Count, Profile.Formatter_Rows_Count);
+	
+	if (ProfileSave(&Profile, String_File_Name, sizeof(String_File_Name)) != 0)
+	{
+		printf("Error : failed to save the tuning profile to \"%s\".\n", String_File_Name);
+		return -1;
+	}
+	printf("Tuning profile saved to \"%s\", the next runs use these settings.\n", String_File_Name);
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Entry point
+//-------------------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+	unsigned int i, ADC_Resolution = 256, Conversion_Channels_Count = 1, Decimation_Factor = 1, Fraction_Bits = 0;
+	int Circuit_Variant = 1, Parameter, j, Is_Planner_Enabled = 0, Is_Optimizer_Enabled = 0, Is_Thermocouple_Enabled = 0, Is_Forward_Table_Enabled = 0, Is_Forward_Stream_Enabled = 0, Is_Conversion_Enabled = 0, Median_Window_Size = 1, Is_Expression_Enabled = 0, Expression_Error_Index, Is_Compiled_Converter_Enabled = 0;
+	double Voltage_Divider_Bridge_Voltage = 3.3, Voltage_Divider_Resistor = 10000., Thermistor_Beta_Coefficient = 4300., Thermistor_Reference_Resistance = 10000., Planner_Minimum_Temperature, Planner_Maximum_Temperature, Planner_Target_Step, Optimizer_Minimum_Temperature, Optimizer_Maximum_Temperature, Forward_Minimum_Temperature, Forward_Maximum_Temperature, Forward_Temperature_Step, Low_Pass_Coefficient = 1.;
+	TThermocoupleType Thermocouple_Type = THERMOCOUPLE_TYPE_K;
+	static TExpressionProgram Expression_Program;
+	TConverterFunction Conversion_Function = MainConvertADCValues;
+	double *Pointer_Temperatures;
+	static TMainConfiguration Emitter_Configurations[MAIN_EMITTER_MAXIMUM_CONFIGURATIONS_COUNT];
+	int Emitter_Configurations_Count = 0, Is_Family_Encoding_Enabled = 0;
+	TMainConfiguration *Pointer_Configuration;
+	char *Pointer_String_Binary_File_Name = NULL, *Pointer_String_Tables_Directory = NULL;
+	size_t Arena_Size, Arena_Mark;
+	TMainConfiguration Configuration;
+	unsigned int Workers_Count, Count;
+	int Is_Statistics_Display_Enabled = 0, Is_Plan_Valid;
+	long Online_CPUs_Count;
+	size_t Memory_Budget = SIZE_MAX;
+	double Memory_Budget_Value, Generator_Size, Simulator_Sample_Period;
+	int Is_Generator_Enabled = 0, Generator_Size_Offset, Is_Tuner_Enabled = 0, Is_Profile_Loaded;
+	TProfile Profile;
+	int Is_Yield_Enabled = 0, Yield_Result, Streaming_Result;
+	double Yield_Minimum_Temperature, Yield_Maximum_Temperature, Yield_Tolerances[MAIN_YIELD_PARAMETERS_COUNT];
+	TMainYieldProblem Yield_Problem;
+	TMainGeneratorParameters Generator_Parameters;
+	TMainExecutionPlan Plan;
+	TMainOutputFormat Output_Format = MAIN_OUTPUT_FORMAT_TEXT;
+	TMainFractionalConversionMethod Fractional_Conversion_Method = MAIN_FRACTIONAL_CONVERSION_METHOD_INTERPOLATION;
+	char *Pointer_String_Expression = NULL;
+	
+	// Do not add noise to the generated values by default
+	Generator_Parameters.Noise_Standard_Deviation = 0.;
+	
+	// Use all CPUs by default
+	Online_CPUs_Count = sysconf(_SC_NPROCESSORS_ONLN);
+	Workers_Count = Online_CPUs_Count > 0 ? (unsigned int) Online_CPUs_Count : 1;
+	
+	// Use the autotuner settings when they were found on this machine, the options can still change them
+	Is_Profile_Loaded = (ProfileLoad(&Profile) == 0) && (Profile.Online_CPUs_Count == Workers_Count);
+	if (Is_Profile_Loaded && ((Profile.Workers_Count > MAIN_MAXIMUM_WORKERS_COUNT) || (Profile.Worker_Minimum_Values_Count > MAIN_MAXIMUM_ADC_RESOLUTION) || (Profile.Formatter_Rows_Count > MAIN_MAXIMUM_FORMATTER_ROWS_COUNT))) Is_Profile_Loaded = 0; // Do not use a hand-edited profile that could overflow the buffers computations
+	if (Is_Profile_Loaded)
+	{
+		Workers_Count = Profile.Workers_Count;
+		Main_Worker_Minimum_Values_Count = Profile.Worker_Minimum_Values_Count;
+		Main_Formatter_Rows_Count = Profile.Formatter_Rows_Count;
+	}
+	
+	// Extract parameters
+	while (1)
+	{
+		Parameter = getopt(argc, argv, "AB:FJ:M:R:ST:W:Y:a:b:c:d:e:f:g:hi:jk:l:m:n:o:p:q:r:s:t:v:w:x:y");
+		if (Parameter == -1) break;
+		
+		switch (Parameter)
+		{
+			case 'A':
+				Is_Tuner_Enabled = 1;
+				break;
+				
+			case 'B':
+				if (sscanf(optarg, "%lf", &Thermistor_Beta_Coefficient) != 1)
+				{
+					printf("Error : invalid thermistor beta coefficient value.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 'F':
+				Is_Forward_Stream_Enabled = 1;
+				break;
+				
+			case 'J':
+				if (strcmp(optarg, "json") == 0) Output_Format = MAIN_OUTPUT_FORMAT_JSON;
+				else if (strcmp(optarg, "ndjson") == 0) Output_Format = MAIN_OUTPUT_FORMAT_NDJSON;
+				else
+				{
+					printf("Error : invalid output format, it must be json or ndjson.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 'M':
+				if ((MainParseBytesCount(optarg, &Memory_Budget_Value) != 0) || (Memory_Budget_Value >= (double) SIZE_MAX))
+				{
+					printf("Error : invalid memory budget, it must be a positive bytes count, optionally followed by the k, M or G unit.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				Memory_Budget = (size_t) Memory_Budget_Value;
+				break;
+				
+			case 'R':
+				if (sscanf(optarg, "%lf", &Thermistor_Reference_Resistance) != 1)
+				{
+					printf("Error : invalid thermistor reference resistance (R25) value.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				break;
+			
+			case 'S':
+				Is_Statistics_Display_Enabled = 1;
+				break;
+				
+			case 'T':
+				Main_Pointer_String_Trace_File_Name = optarg;
+				break;
+				
+			case 'W':
+				Pointer_String_Tables_Directory = optarg;
+				break;
+				
+			case 'Y':
+				if (sscanf(optarg, "%lf:%lf:%lf:%lf:%lf:%lf", &Yield_Minimum_Temperature, &Yield_Maximum_Temperature, &Yield_Problem.Error_Limit, &Yield_Tolerances[0], &Yield_Tolerances[1], &Yield_Tolerances[2]) != 6)
+				{
+					printf("Error : invalid yield estimation parameters, they must be formatted like Tmin:Tmax:limit:Btol:R25tol:Rtol.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				if ((Yield_Minimum_Temperature >= Yield_Maximum_Temperature) || (Yield_Minimum_Temperature <= -THERMISTOR_KELVIN_OFFSET) || !(Yield_Problem.Error_Limit > 0))
+				{
+					printf("Error : the yield estimation range minimum temperature must be above absolute zero and lower than the maximum temperature, and the error limit must be positive.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				for (i = 0; i < MAIN_YIELD_PARAMETERS_COUNT; i++)
+				{
+					if (!(Yield_Tolerances[i] >= 0) || (Yield_Tolerances[i] >= 100))
+					{
+						printf("Error : the yield estimation tolerances must be in range [0; 100[ percent.\n\n");
+						MainDisplayProgramUsage(argv[0]);
+						return EXIT_FAILURE;
+					}
+					Yield_Problem.Standard_Deviations[i] = Yield_Tolerances[i] / 300.; // The tolerance is three standard deviations
+				}
+				Is_Yield_Enabled = 1;
+				break;
+				
+			case 'a':
+				if (sscanf(optarg, "%u", &ADC_Resolution) != 1)
+				{
+					printf("Error : invalid ADC resolution value.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				if (ADC_Resolution < MAIN_MINIMUM_ADC_RESOLUTION)
+				{
+					printf("Error : minimum allowed ADC resolution is %u.\n", MAIN_MINIMUM_ADC_RESOLUTION);
+					return EXIT_FAILURE;
+				}
+				// Make sure the results array has enough room
+				if (ADC_Resolution > MAIN_MAXIMUM_ADC_RESOLUTION)
+				{
+					printf("Error : maximum allowed ADC resolution is %u.\n", MAIN_MAXIMUM_ADC_RESOLUTION);
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 'b':
+				Pointer_String_Binary_File_Name = optarg;
+				break;
+				
+			case 'c':
+				if (sscanf(optarg, "%d", &Circuit_Variant) != 1)
+				{
+					printf("Error : invalid circuit variant value.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				if ((Circuit_Variant < 1) || (Circuit_Variant > 2))
+				{
+					printf("Error : circuit variant value must be 1 or 2.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 'd':
+				if ((sscanf(optarg, "%u", &Decimation_Factor) != 1) || (Decimation_Factor < 1))
+				{
+					printf("Error : invalid decimation factor value.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 'e':
+				if (ExpressionCompile(optarg, &Expression_Program, &Expression_Error_Index) != 0)
+				{
+					printf("Error : invalid or too complex expression, parsing failed at character %d :\n%s\n%*s^\n\n", Expression_Error_Index + 1, optarg, Expression_Error_Index, "");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				Is_Expression_Enabled = 1;
+				Pointer_String_Expression = optarg;
+				break;
+				
+			case 'f':
+				if (sscanf(optarg, "%lf:%lf:%lf", &Forward_Minimum_Temperature, &Forward_Maximum_Temperature, &Forward_Temperature_Step) != 3)
+				{
+					printf("Error : invalid forward table parameters, they must be formatted like Tmin:Tmax:step.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				if ((Forward_Minimum_Temperature > Forward_Maximum_Temperature) || (Forward_Minimum_Temperature <= -THERMISTOR_KELVIN_OFFSET) || (Forward_Temperature_Step <= 0))
+				{
+					printf("Error : the forward table minimum temperature must be above absolute zero and not greater than the maximum temperature, and the step must be positive.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				// The comparison is written so that a NaN count is rejected too
+				if (!(MainComputeForwardTemperaturesCount(Forward_Minimum_Temperature, Forward_Maximum_Temperature, Forward_Temperature_Step) <= MAIN_MAXIMUM_FORWARD_TEMPERATURES_COUNT))
+				{
+					printf("Error : the forward table can't have more than %u temperatures.\n\n", MAIN_MAXIMUM_FORWARD_TEMPERATURES_COUNT);
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				Is_Forward_Table_Enabled = 1;
+				break;
+				
+			case 'g':
+				Generator_Size_Offset = 0;
+				if ((sscanf(optarg, "%lf:%lf:%u:%lf:%n", &Generator_Parameters.Start_Temperature, &Generator_Parameters.End_Temperature, &Generator_Parameters.Channels_Count, &Generator_Parameters.Sample_Rate, &Generator_Size_Offset) != 4) || (Generator_Size_Offset == 0) || (MainParseBytesCount(&optarg[Generator_Size_Offset], &Generator_Size) != 0))
+				{
+					printf("Error : invalid generator parameters, they must be formatted like Tmin:Tmax:channels:rate:size.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				if ((Generator_Parameters.Start_Temperature > Generator_Parameters.End_Temperature) || (Generator_Parameters.Start_Temperature <= -THERMISTOR_KELVIN_OFFSET) || (Generator_Parameters.Channels_Count < 1) || (Generator_Parameters.Channels_Count > MAIN_CONVERSION_MAXIMUM_CHANNELS_COUNT) || !(Generator_Parameters.Sample_Rate > 0))
+				{
+					printf("Error : the generator minimum temperature must be above absolute zero and not greater than the maximum temperature, the channels count must be in range [1; %d] and the sample rate must be positive.\n\n", MAIN_CONVERSION_MAXIMUM_CHANNELS_COUNT);
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				Generator_Parameters.Trajectory = MAIN_GENERATOR_TRAJECTORY_SINE;
+				Generator_Parameters.Maximum_Samples_Count = ULLONG_MAX;
+				Generator_Parameters.Maximum_Size = (unsigned long long) Generator_Size;
+				Is_Generator_Enabled = 1;
+				break;
+				
+			case 'h':
+				MainDisplayBanner();
+				MainDisplayProgramUsage(argv[0]);
+				return EXIT_SUCCESS;
+				
+			case 'i':
+				if (strcmp(optarg, "interpolation") == 0) Fractional_Conversion_Method = MAIN_FRACTIONAL_CONVERSION_METHOD_INTERPOLATION;
+				else if (strcmp(optarg, "model") == 0) Fractional_Conversion_Method = MAIN_FRACTIONAL_CONVERSION_METHOD_MODEL;
+				else if (strcmp(optarg, "fastest") == 0) Fractional_Conversion_Method = MAIN_FRACTIONAL_CONVERSION_METHOD_FASTEST;
+				else
+				{
+					printf("Error : invalid fractional conversion method, it must be interpolation, model or fastest.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 'j':
+				Is_Compiled_Converter_Enabled = 1;
+				break;
+				
+			case 'k':
+				if ((optarg[0] == 0) || (optarg[1] != 0) || (ThermocoupleGetTypeFromLetter(optarg[0], &Thermocouple_Type) != 0))
+				{
+					printf("Error : unsupported thermocouple type.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				Is_Thermocouple_Enabled = 1;
+				break;
+				
+			case 'l':
+				if ((sscanf(optarg, "%lf", &Low_Pass_Coefficient) != 1) || !(Low_Pass_Coefficient > 0) || (Low_Pass_Coefficient > 1))
+				{
+					printf("Error : invalid low-pass filter coefficient value, it must be in range ]0; 1].\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 'm':
+				if ((sscanf(optarg, "%d", &Median_Window_Size) != 1) || (Median_Window_Size < 1) || (Median_Window_Size > MAIN_CONVERSION_MAXIMUM_MEDIAN_WINDOW_SIZE) || ((Median_Window_Size & 1) == 0))
+				{
+					printf("Error : invalid median filter window size, it must be an odd number up to %d.\n\n", MAIN_CONVERSION_MAXIMUM_MEDIAN_WINDOW_SIZE);
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 'n':
+				if ((sscanf(optarg, "%lf", &Generator_Parameters.Noise_Standard_Deviation) != 1) || !(Generator_Parameters.Noise_Standard_Deviation >= 0))
+				{
+					printf("Error : invalid generator noise value, it must be a positive or zero number of ADC steps.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 'o':
+				if (sscanf(optarg, "%lf:%lf", &Optimizer_Minimum_Temperature, &Optimizer_Maximum_Temperature) != 2)
+				{
+					printf("Error : invalid optimizer parameters, they must be formatted like Tmin:Tmax.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				if ((Optimizer_Minimum_Temperature >= Optimizer_Maximum_Temperature) || (Optimizer_Minimum_Temperature <= -THERMISTOR_KELVIN_OFFSET))
+				{
+					printf("Error : the optimizer range minimum temperature must be above absolute zero and lower than the maximum temperature.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				Is_Optimizer_Enabled = 1;
+				break;
+				
+			case 'p':
+				if (sscanf(optarg, "%lf:%lf:%lf", &Planner_Minimum_Temperature, &Planner_Maximum_Temperature, &Planner_Target_Step) != 3)
+				{
+					printf("Error : invalid planner parameters, they must be formatted like Tmin:Tmax:step.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				if ((Planner_Minimum_Temperature >= Planner_Maximum_Temperature) || (Planner_Minimum_Temperature <= -THERMISTOR_KELVIN_OFFSET) || (Planner_Target_Step <= 0))
+				{
+					printf("Error : the planner range minimum temperature must be above absolute zero and lower than the maximum temperature, and the step must be positive.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				Is_Planner_Enabled = 1;
+				break;
+				
+			case 'q':
+				if ((sscanf(optarg, "%u", &Fraction_Bits) != 1) || (Fraction_Bits < 1) || (Fraction_Bits > MAIN_CONVERSION_MAXIMUM_FRACTION_BITS))
+				{
+					printf("Error : invalid fractional bits count, it must be in range [1; %d].\n\n", MAIN_CONVERSION_MAXIMUM_FRACTION_BITS);
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 'r':
+				if (sscanf(optarg, "%lf", &Voltage_Divider_Resistor) != 1)
+				{
+					printf("Error : invalid voltage divider resistor value.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 's':
+				if (sscanf(optarg, "%u:%llu:%lf:%lf:%lf:%lf", &Generator_Parameters.Channels_Count, &Generator_Parameters.Maximum_Samples_Count, &Simulator_Sample_Period, &Generator_Parameters.Time_Constant, &Generator_Parameters.Start_Temperature, &Generator_Parameters.End_Temperature) != 6)
+				{
+					printf("Error : invalid simulator parameters, they must be formatted like channels:steps:period:tau:Tstart:Tend.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				if ((Generator_Parameters.Channels_Count < 1) || (Generator_Parameters.Channels_Count > MAIN_CONVERSION_MAXIMUM_CHANNELS_COUNT) || (Generator_Parameters.Maximum_Samples_Count < 1) || !(Simulator_Sample_Period > 0) || !(Generator_Parameters.Time_Constant > 0) || (Generator_Parameters.Start_Temperature <= -THERMISTOR_KELVIN_OFFSET) || (Generator_Parameters.End_Temperature <= -THERMISTOR_KELVIN_OFFSET))
+				{
+					printf("Error : the simulator channels count must be in range [1; %d], the steps count, the period and the time constant must be positive, and the temperatures must be above absolute zero.\n\n", MAIN_CONVERSION_MAXIMUM_CHANNELS_COUNT);
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				Generator_Parameters.Trajectory = MAIN_GENERATOR_TRAJECTORY_TRANSIENT;
+				Generator_Parameters.Sample_Rate = 1. / Simulator_Sample_Period;
+				Generator_Parameters.Maximum_Size = ULLONG_MAX;
+				Is_Generator_Enabled = 1;
+				break;
+				
+			case 't':
+				if (Emitter_Configurations_Count >= MAIN_EMITTER_MAXIMUM_CONFIGURATIONS_COUNT)
+				{
+					printf("Error : too many configurations, the maximum is %d.\n", MAIN_EMITTER_MAXIMUM_CONFIGURATIONS_COUNT);
+					return EXIT_FAILURE;
+				}
+				Pointer_Configuration = &Emitter_Configurations[Emitter_Configurations_Count];
+				if (sscanf(optarg, "%d:%lf:%lf:%lf:%lf:%u", &Pointer_Configuration->Circuit_Variant, &Pointer_Configuration->Thermistor_Beta_Coefficient, &Pointer_Configuration->Thermistor_Reference_Resistance, &Pointer_Configuration->Voltage_Divider_Resistor, &Pointer_Configuration->Voltage_Divider_Bridge_Voltage, &Pointer_Configuration->ADC_Resolution) != 6)
+				{
+					printf("Error : invalid configuration, it must be formatted like circuit:beta:R25:resistor:Vcc:resolution.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				if ((Pointer_Configuration->Circuit_Variant < 1) || (Pointer_Configuration->Circuit_Variant > 2) || (Pointer_Configuration->ADC_Resolution < MAIN_MINIMUM_ADC_RESOLUTION) || (Pointer_Configuration->ADC_Resolution > MAIN_MAXIMUM_ADC_RESOLUTION))
+				{
+					printf("Error : the configuration circuit variant must be 1 or 2 and the resolution must be in range [%u; %u].\n\n", MAIN_MINIMUM_ADC_RESOLUTION, MAIN_MAXIMUM_ADC_RESOLUTION);
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				Emitter_Configurations_Count++;
+				break;
+				
+			case 'v':
+				if (sscanf(optarg, "%lf", &Voltage_Divider_Bridge_Voltage) != 1)
+				{
+					printf("Error : invalid voltage divider bridge voltage value.\n\n");
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 'w':
+				if ((sscanf(optarg, "%u", &Workers_Count) != 1) || (Workers_Count < 1) || (Workers_Count > MAIN_MAXIMUM_WORKERS_COUNT))
+				{
+					printf("Error : invalid workers count, it must be in range [1; %d].\n\n", MAIN_MAXIMUM_WORKERS_COUNT);
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				break;
+				
+			case 'x':
+				if ((sscanf(optarg, "%u", &Conversion_Channels_Count) != 1) || (Conversion_Channels_Count < 1) || (Conversion_Channels_Count > MAIN_CONVERSION_MAXIMUM_CHANNELS_COUNT))
+				{
+					printf("Error : invalid conversion channels count, it must be in range [1; %d].\n\n", MAIN_CONVERSION_MAXIMUM_CHANNELS_COUNT);
+					MainDisplayProgramUsage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				Is_Conversion_Enabled = 1;
+				break;
+				
+			case 'y':
+				Is_Family_Encoding_Enabled = 1;
+				break;
+				
+			case '?':
+				putchar('\n');
+				MainDisplayProgramUsage(argv[0]);
+				return EXIT_FAILURE;
+			
+			default:
+				break;
+		}
+	}
+	
+	// The tables files are written only for the -t configurations
+	if ((Pointer_String_Tables_Directory != NULL) && (Emitter_Configurations_Count == 0))
+	{
+		printf("Error : the tables files directory needs at least one configuration given with -t.\n\n");
+		MainDisplayProgramUsage(argv[0]);
+		return EXIT_FAILURE;
+	}
+	
+	// Record the threads activity from now on when requested, the trace is written when the program exits
+	if (Main_Pointer_String_Trace_File_Name != NULL)
+	{
+		if (TraceInitialize() != 0)
+		{
+			printf("Error : failed to allocate the execution trace buffers.\n");
+			return EXIT_FAILURE;
+		}
+		atexit(MainWriteTrace);
+	}
+	
+	// Stream the forward conversion when requested, do not display the banner to keep the output easy to process
+	if (Is_Forward_Stream_Enabled)
+	{
+		if (MainStreamForwardConversion(Circuit_Variant, Voltage_Divider_Bridge_Voltage, Voltage_Divider_Resistor, Thermistor_Beta_Coefficient, Thermistor_Reference_Resistance, ADC_Resolution) != 0) return EXIT_FAILURE;
+		return EXIT_SUCCESS;
+	}
+	
+	// Report the peak memory usage of all modes
+	if (Is_Statistics_Display_Enabled)
+	{
+		atexit(MainDisplayPeakMemoryUsage);
+		if (Is_Profile_Loaded) fprintf(stderr, "Tuning profile : %u worker(s) by default, %u minimum values per worker, %u formatter rows.\n", Profile.Workers_Count, Main_Worker_Minimum_Values_Count, Main_Formatter_Rows_Count);
+	}
+	
+	// Benchmark the settings and save the fastest ones when requested, no table is computed in this mode
+	if (Is_Tuner_Enabled)
+	{
+		Workers_Count = Online_CPUs_Count > 0 ? (unsigned int) Online_CPUs_Count : 1;
+		if (Workers_Count > MAIN_MAXIMUM_WORKERS_COUNT) Workers_Count = MAIN_MAXIMUM_WORKERS_COUNT;
+		Arena_Size = MainGetTunerMemorySize(Workers_Count);
+		if (ArenaCreate(&Main_Arena, Arena_Size) != 0)
+		{
+			printf("Error : failed to allocate %zu bytes of memory.\n", Arena_Size);
+			return EXIT_FAILURE;
+		}
+		
+		MainDisplayBanner();
+		Configuration.Circuit_Variant = Circuit_Variant;
+		Configuration.Thermistor_Beta_Coefficient = Thermistor_Beta_Coefficient;
+		Configuration.Thermistor_Reference_Resistance = Thermistor_Reference_Resistance;
+		Configuration.Voltage_Divider_Resistor = Voltage_Divider_Resistor;
+		Configuration.Voltage_Divider_Bridge_Voltage = Voltage_Divider_Bridge_Voltage;
+		if (MainTuneSettings(&Configuration, Workers_Count) != 0) return EXIT_FAILURE;
+		return EXIT_SUCCESS;
+	}
+	
+	// Estimate the yield of the circuit when requested, no table is computed in this mode
+	if (Is_Yield_Enabled)
+	{
+		Arena_Size = 2 * ADC_Resolution * sizeof(double) + 1024;
+		if (ArenaCreate(&Main_Arena, Arena_Size) != 0)
+		{
+			printf("Error : failed to allocate %zu bytes of memory.\n", Arena_Size);
+			return EXIT_FAILURE;
+		}
+		
+		Configuration.Circuit_Variant = Circuit_Variant;
+		Configuration.Thermistor_Beta_Coefficient = Thermistor_Beta_Coefficient;
+		Configuration.Thermistor_Reference_Resistance = Thermistor_Reference_Resistance;
+		Configuration.Voltage_Divider_Resistor = Voltage_Divider_Resistor;
+		Configuration.Voltage_Divider_Bridge_Voltage = Voltage_Divider_Bridge_Voltage;
+		Configuration.ADC_Resolution = ADC_Resolution;
+		if (ADC_Resolution < MAIN_YIELD_MINIMUM_ADC_RESOLUTION)
+		{
+			printf("Error : the yield estimation needs an ADC resolution of at least %u.\n\n", MAIN_YIELD_MINIMUM_ADC_RESOLUTION);
+			MainDisplayProgramUsage(argv[0]);
+			return EXIT_FAILURE;
+		}
+		Yield_Result = MainPrepareYieldProblem(&Configuration, Yield_Minimum_Temperature, Yield_Maximum_Temperature, &Yield_Problem);
+		if (Yield_Result == -2)
+		{
+			printf("Error : failed to allocate the operating range tables.\n");
+			return EXIT_FAILURE;
+		}
+		if (Yield_Result != 0)
+		{
+			printf("Error : no ADC value corresponds to the [%lf; %lf] Celsius range.\n", Yield_Minimum_Temperature, Yield_Maximum_Temperature);
+			return EXIT_FAILURE;
+		}
+		
+		MainDisplayBanner();
+		printf("Operating range : [%lf; %lf] Celsius, %u ADC values.\n", Yield_Minimum_Temperature, Yield_Maximum_Temperature, Yield_Problem.Values_Count);
+		printf("Tolerances (3 standard deviations) : Beta %lf %%, R25 %lf %%, resistor %lf %%.\n", Yield_Tolerances[0], Yield_Tolerances[1], Yield_Tolerances[2]);
+		printf("Error limit : %lf Celsius.\n\n", Yield_Problem.Error_Limit);
+		MainEstimateYield(&Yield_Problem, Is_Statistics_Display_Enabled);
+		return EXIT_SUCCESS;
+	}
+	
+	// Generate synthetic ADC values when requested, do not display the banner so the output can be given to the conversion mode
+	if (Is_Generator_Enabled)
+	{
+		// Run only the generator threads that fit in the memory budget
+		Arena_Size = MainGetGeneratorMemorySize(Generator_Parameters.Channels_Count);
+		if (Memory_Budget != SIZE_MAX)
+		{
+			if ((Memory_Budget < MAIN_MEMORY_PLANNER_BASE_SIZE) || ((Memory_Budget - MAIN_MEMORY_PLANNER_BASE_SIZE) / Arena_Size == 0))
+			{
+				printf("Error : the generator buffers do not fit in the memory budget of %zu bytes.\n", Memory_Budget);
+				return EXIT_FAILURE;
+			}
+			if (Workers_Count > (Memory_Budget - MAIN_MEMORY_PLANNER_BASE_SIZE) / Arena_Size) Workers_Count = (unsigned int) ((Memory_Budget - MAIN_MEMORY_PLANNER_BASE_SIZE) / Arena_Size);
+		}
+		if (Workers_Count > MAIN_MAXIMUM_WORKERS_COUNT) Workers_Count = MAIN_MAXIMUM_WORKERS_COUNT;
+		Arena_Size *= Workers_Count;
+		if (ArenaCreate(&Main_Arena, Arena_Size) != 0)
+		{
+			printf("Error : failed to allocate %zu bytes of memory.\n", Arena_Size);
+			return EXIT_FAILURE;
+		}
+		
+		Configuration.Circuit_Variant = Circuit_Variant;
+		Configuration.Thermistor_Beta_Coefficient = Thermistor_Beta_Coefficient;
+		Configuration.Thermistor_Reference_Resistance = Thermistor_Reference_Resistance;
+		Configuration.Voltage_Divider_Resistor = Voltage_Divider_Resistor;
+		Configuration.Voltage_Divider_Bridge_Voltage = Voltage_Divider_Bridge_Voltage;
+		Configuration.ADC_Resolution = ADC_Resolution;
+		Generator_Parameters.Pointer_Configuration = &Configuration;
+		if (MainGenerateADCValues(&Generator_Parameters, Workers_Count, Is_Statistics_Display_Enabled) != 0) return EXIT_FAILURE;
+		return EXIT_SUCCESS;
+	}
+	
+	// The fixed-point ADC values must fit in the conversion input values, and the specialized conversion functions convert only integer ADC values
+	if (Is_Conversion_Enabled && (Fraction_Bits > 0))
+	{
+		if (Is_Compiled_Converter_Enabled)
+		{
+			printf("Error : the fixed-point ADC values conversion can't use the specialized conversion function.\n\n");
+			MainDisplayProgramUsage(argv[0]);
+			return EXIT_FAILURE;
+		}
+		if (((unsigned long long) (ADC_Resolution - 1) << Fraction_Bits) > UINT_MAX)
+		{
+			printf("Error : the ADC resolution is too high for %u fractional bits.\n\n", Fraction_Bits);
+			MainDisplayProgramUsage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	
+	// The tables too big to be folded in a compiled function use the generic conversion, do not keep a temperatures copy for them
+	if (ADC_Resolution > CONVERTER_MAXIMUM_TABLE_ENTRIES_COUNT) Is_Compiled_Converter_Enabled = 0;
+	
+	// Find how the table computation fits in the memory budget, the plan is checked only by the modes that compute the table
+	Is_Plan_Valid = MainPlanExecution(Memory_Budget, ADC_Resolution, Workers_Count, Is_Conversion_Enabled, Is_Thermocouple_Enabled, Is_Compiled_Converter_Enabled, (Output_Format != MAIN_OUTPUT_FORMAT_TEXT) && !Is_Conversion_Enabled, &Plan) == 0;
+	
+	// Map all the memory needed by the table computation or the emitter at once (the table computation needs what the plan tells, the emitter needs two tables and a packed table at most per configuration)
+	Arena_Size = Is_Plan_Valid ? Plan.Arena_Size : 1024;
+	if (Pointer_String_Tables_Directory == NULL) // The tables files writer uses its own buffers
+	{
+		for (j = 0; j < Emitter_Configurations_Count; j++) Arena_Size += (size_t) Emitter_Configurations[j].ADC_Resolution * (2 * sizeof(int) + 3) + 1024;
+		if ((Emitter_Configurations_Count > 0) && (Memory_Budget != SIZE_MAX) && ((Memory_Budget < MAIN_MEMORY_PLANNER_BASE_SIZE) || (Arena_Size > Memory_Budget - MAIN_MEMORY_PLANNER_BASE_SIZE)))
+		{
+			printf("Error : the configurations tables do not fit in the memory budget, write them to files with -W instead.\n");
+			return EXIT_FAILURE;
+		}
+	}
+	if (ArenaCreate(&Main_Arena, Arena_Size) != 0)
+	{
+		printf("Error : failed to allocate %zu bytes of memory.\n", Arena_Size);
+		return EXIT_FAILURE;
+	}
+	
+	// Emit the configurations tables when requested, do not display the banner to keep the output compilable
+	if (Emitter_Configurations_Count > 0)
+	{
+		if (Pointer_String_Tables_Directory != NULL)
+		{
+			if (MainWriteTablesFiles(Emitter_Configurations, Emitter_Configurations_Count, Pointer_String_Tables_Directory, Memory_Budget, Is_Statistics_Display_Enabled) != 0) return EXIT_FAILURE;
+		}
+		else if (Is_Family_Encoding_Enabled)
+		{
+			if (MainEmitFamilyTables(Emitter_Configurations, Emitter_Configurations_Count) != 0) return EXIT_FAILURE;
+		}
+		else if (MainEmitTables(Emitter_Configurations, Emitter_Configurations_Count) != 0) return EXIT_FAILURE;
+		return EXIT_SUCCESS;
+	}
+	
+	// Do not display the banner in conversion mode or when the binary values are written to the standard output, to keep the output easy to process
+	if (!Is_Conversion_Enabled && (Output_Format == MAIN_OUTPUT_FORMAT_TEXT) && ((Pointer_String_Binary_File_Name == NULL) || (strcmp(Pointer_String_Binary_File_Name, "-") != 0))) MainDisplayBanner();
+	
+	// Display the forward table when requested, the ADC lookup table is not computed in this mode
+	if (Is_Forward_Table_Enabled)
+	{
+		MainDisplayForwardTable(Circuit_Variant, Voltage_Divider_Bridge_Voltage, Voltage_Divider_Resistor, Thermistor_Beta_Coefficient, Thermistor_Reference_Resistance, ADC_Resolution, Forward_Minimum_Temperature, Forward_Maximum_Temperature, Forward_Temperature_Step);
+		return EXIT_SUCCESS;
+	}
+	
+	// Plan the hardware when requested, no table is computed in this mode
+	if (Is_Planner_Enabled)
+	{
+		if (MainPlanHardware(Thermistor_Beta_Coefficient, Thermistor_Reference_Resistance, Planner_Minimum_Temperature, Planner_Maximum_Temperature, Planner_Target_Step) != 0) return EXIT_FAILURE;
+		return EXIT_SUCCESS;
+	}
+	
+	// Optimize the voltage divider resistor when requested, no table is computed in this mode
+	if (Is_Optimizer_Enabled)
+	{
+		MainOptimizeVoltageDividerResistor(Thermistor_Beta_Coefficient, Thermistor_Reference_Resistance, ADC_Resolution, Optimizer_Minimum_Temperature, Optimizer_Maximum_Temperature);
+		return EXIT_SUCCESS;
+	}
+	
+	if (!Is_Plan_Valid)
+	{
+		printf("Error : the table does not fit in the memory budget of %zu bytes.\n", Memory_Budget);
+		return EXIT_FAILURE;
+	}
+	if (Is_Statistics_Display_Enabled) MainDisplayExecutionPlan(&Plan, ADC_Resolution);
+	
+	Configuration.Circuit_Variant = Circuit_Variant;
+	Configuration.Thermistor_Beta_Coefficient = Thermistor_Beta_Coefficient;
+	Configuration.Thermistor_Reference_Resistance = Thermistor_Reference_Resistance;
+	Configuration.Voltage_Divider_Resistor = Voltage_Divider_Resistor;
+	Configuration.Voltage_Divider_Bridge_Voltage = Voltage_Divider_Bridge_Voltage;
+	Configuration.ADC_Resolution = ADC_Resolution;
+	
+	// Serialize the table when requested, the JSON formats are always streamed
+	if ((Output_Format != MAIN_OUTPUT_FORMAT_TEXT) && !Is_Conversion_Enabled)
+	{
+		if (Pointer_String_Binary_File_Name != NULL)
+		{
+			printf("Error : the JSON output formats can't be combined with the binary values output.\n");
+			return EXIT_FAILURE;
+		}
+		Values = ArenaAllocate(&Main_Arena, Plan.Chunk_Values_Count * sizeof(TMainComputedValues));
+		if (Is_Thermocouple_Enabled) Main_Cold_Junction_Voltages = ArenaAllocate(&Main_Arena, Plan.Chunk_Values_Count * sizeof(double));
+		if ((Values == NULL) || (Is_Thermocouple_Enabled && (Main_Cold_Junction_Voltages == NULL)))
+		{
+			printf("Error : failed to allocate the values buffers.\n");
+			return EXIT_FAILURE;
+		}
+		MainWriteJSONTables(&Configuration, Pointer_String_Expression, Is_Expression_Enabled ? &Expression_Program : NULL, &Plan, Output_Format, Is_Thermocouple_Enabled, Thermocouple_Type);
+		return EXIT_SUCCESS;
+	}
+	
+	// Display the tables chunk by chunk when the whole table does not fit in the budget
+	if (Plan.Is_Streaming_Enabled)
+	{
+		Values = ArenaAllocate(&Main_Arena, Plan.Chunk_Values_Count * sizeof(TMainComputedValues));
+		if (Is_Thermocouple_Enabled) Main_Cold_Junction_Voltages = ArenaAllocate(&Main_Arena, Plan.Chunk_Values_Count * sizeof(double));
+		if ((Values == NULL) || (Is_Thermocouple_Enabled && (Main_Cold_Junction_Voltages == NULL)))
+		{
+			printf("Error : failed to allocate the values buffers.\n");
+			return EXIT_FAILURE;
+		}
+		Streaming_Result = MainDisplayStreamedTables(&Configuration, Is_Expression_Enabled ? &Expression_Program : NULL, &Plan, Pointer_String_Binary_File_Name, Is_Thermocouple_Enabled, Thermocouple_Type, Is_Statistics_Display_Enabled);
+		if (Streaming_Result == -1)
+		{
+			fprintf(stderr, "Error : failed to write the binary values to \"%s\".\n", Pointer_String_Binary_File_Name);
+			return EXIT_FAILURE;
+		}
+		if (Streaming_Result == -2)
+		{
+			fprintf(stderr, "Error : failed to write the detail table.\n");
+			return EXIT_FAILURE;
+		}
+		return EXIT_SUCCESS;
+	}
+	
+	// Keep only the temperatures when the whole table does not fit in the budget, the values are computed by chunks to fill them
+	if (Plan.Is_Temperature_Only_Retained)
+	{
+		Main_Temperatures = ArenaAllocate(&Main_Arena, ADC_Resolution * sizeof(double));
+		Values = ArenaAllocate(&Main_Arena, Plan.Chunk_Values_Count * sizeof(TMainComputedValues));
+		if ((Main_Temperatures == NULL) || (Values == NULL))
+		{
+			printf("Error : failed to allocate the values buffers.\n");
+			return EXIT_FAILURE;
+		}
+		for (i = 0; i < ADC_Resolution; i += Plan.Chunk_Values_Count)
+		{
+			Count = ADC_Resolution - i < Plan.Chunk_Values_Count ? ADC_Resolution - i : Plan.Chunk_Values_Count;
+			MainComputeValues(&Configuration, Is_Expression_Enabled ? &Expression_Program : NULL, i, i + Count, Plan.Workers_Count, Is_Statistics_Display_Enabled && (i == 0));
+			for (j = 0; j < (int) Count; j++) Main_Temperatures[i + j] = Values[j].Thermistor_Temperature;
+		}
+		Conversion_Function = MainConvertADCValuesFromTemperatures;
+	}
+	else
+	{
+		// Allocate the results buffers
+		Values = ArenaAllocate(&Main_Arena, ADC_Resolution * sizeof(TMainComputedValues));
+		if (Is_Thermocouple_Enabled) Main_Cold_Junction_Voltages = ArenaAllocate(&Main_Arena, ADC_Resolution * sizeof(double));
+		if ((Values == NULL) || (Is_Thermocouple_Enabled && (Main_Cold_Junction_Voltages == NULL)))
+		{
+			printf("Error : failed to allocate the values buffers.\n");
+			return EXIT_FAILURE;
+		}
+		
+		// Compute values
+		MainComputeValues(&Configuration, Is_Expression_Enabled ? &Expression_Program : NULL, 0, ADC_Resolution, Plan.Workers_Count, Is_Statistics_Display_Enabled);
+	}
+	
+	// Convert the standard input ADC values when requested
+	if (Is_Conversion_Enabled)
+	{
+		// Try to get a conversion function specialized for this table
+		if (Is_Compiled_Converter_Enabled && Plan.Is_Temperature_Only_Retained)
+		{
+			Conversion_Function = ConverterGetFunction(Main_Temperatures, ADC_Resolution);
+			if (Conversion_Function == NULL)
+			{
+				fprintf(stderr, "Warning : could not build the specialized conversion function, using the generic one.\n");
+				Conversion_Function = MainConvertADCValuesFromTemperatures;
+			}
+		}
+		else if (Is_Compiled_Converter_Enabled)
+		{
+			Arena_Mark = Main_Arena.Used_Size;
+			Pointer_Temperatures = ArenaAllocate(&Main_Arena, ADC_Resolution * sizeof(double));
+			if (Pointer_Temperatures != NULL)
+			{
+				for (i = 0; i < ADC_Resolution; i++) Pointer_Temperatures[i] = Values[i].Thermistor_Temperature;
+				Conversion_Function = ConverterGetFunction(Pointer_Temperatures, ADC_Resolution);
+				ArenaReset(&Main_Arena, Arena_Mark);
+			}
+			else Conversion_Function = NULL;
+			
+			if (Conversion_Function == NULL)
+			{
+				fprintf(stderr, "Warning : could not build the specialized conversion function, using the generic one.\n");
+				Conversion_Function = MainConvertADCValues;
+			}
+		}
+		
+		// Convert the fixed-point ADC values with the fastest fractional conversion function
+		if (Fraction_Bits > 0)
+		{
+			Main_Fractional_Conversion.Pointer_Configuration = &Configuration;
+			Main_Fractional_Conversion.Pointer_Expression_Program = Is_Expression_Enabled ? &Expression_Program : NULL;
+			if (Plan.Is_Temperature_Only_Retained)
+			{
+				Main_Fractional_Conversion.Pointer_Table = Main_Temperatures;
+				Main_Fractional_Conversion.Table_Stride = 1;
+			}
+			else
+			{
+				Main_Fractional_Conversion.Pointer_Table = &Values[0].Thermistor_Temperature;
+				Main_Fractional_Conversion.Table_Stride = MAIN_VALUES_STRIDE;
+			}
+			Main_Fractional_Conversion.Fraction_Bits = Fraction_Bits;
+			Conversion_Function = MainSelectFractionalConversionFunction(Fractional_Conversion_Method, Conversion_Channels_Count, Is_Statistics_Display_Enabled);
+		}
+		
+		if (MainStreamConversion(ADC_Resolution, Fraction_Bits, Conversion_Channels_Count, Median_Window_Size, Low_Pass_Coefficient, Decimation_Factor, Conversion_Function) != 0) return EXIT_FAILURE;
+		return EXIT_SUCCESS;
+	}
+	
+	// Write the binary values when requested, only them are written when the standard output is used
+	if (Pointer_String_Binary_File_Name != NULL)
+	{
+		if (MainWriteBinaryValues(Pointer_String_Binary_File_Name, ADC_Resolution) != 0)
+		{
+			fprintf(stderr, "Error : failed to write the binary values to \"%s\".\n", Pointer_String_Binary_File_Name);
+			return EXIT_FAILURE;
+		}
+		if (strcmp(Pointer_String_Binary_File_Name, "-") == 0) return EXIT_SUCCESS;
+	}
+	
+	// Display results
+	printf("ADC value	Thermistor voltage (V)	Thermistor resistance (ohm)	Thermistor temperature (Celsius)\n");
+	if (MainDisplayDetailTable(0, ADC_Resolution, Plan.Workers_Count) != 0)
+	{
+		fprintf(stderr, "Error : failed to write the detail table.\n");
+		return EXIT_FAILURE;
+	}
+	
+	// Display ADC table
+	printf("\nADC lookup table :\n");
+	MainDisplayRoundedNumbers(&Values[0].Thermistor_Temperature, MAIN_VALUES_STRIDE, ADC_Resolution, 0, ADC_Resolution, "%4d, ");
+	
+	// Display thermocouple cold-junction compensation table
+	if (Is_Thermocouple_Enabled)
+	{
+		for (i = 0; i < ADC_Resolution; i++) Main_Cold_Junction_Voltages[i] = Values[i].Thermistor_Temperature;
+		ThermocoupleComputeVoltages(Thermocouple_Type, Main_Cold_Junction_Voltages, Main_Cold_Junction_Voltages, ADC_Resolution);
+		for (i = 0; i < ADC_Resolution; i++) Main_Cold_Junction_Voltages[i] *= 1000.; // Convert to microvolts
+		
+		printf("\nType %c thermocouple cold-junction compensation table (microvolts) :\n", ThermocoupleGetTypeLetter(Thermocouple_Type));
+		MainDisplayRoundedNumbers(Main_Cold_Junction_Voltages, 1, ADC_Resolution, 0, ADC_Resolution, "%6d, ");
+	}
+	
+	// The tables are buffered, make sure they reached the standard output
+	if (fflush(stdout) != 0)
+	{
+		fprintf(stderr, "Error : failed to write the tables.\n");
+		return EXIT_FAILURE;
+	}
 	return EXIT_SUCCESS;
 }
@@ -0,0 +1,170 @@
+/** @file Packer.c
+ * See Packer.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <limits.h>
+#include <math.h>
+#include "Packer.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+	#include <immintrin.h>
+	#define PACKER_IS_SIMD_KERNEL_AVAILABLE 1
+#else
+	#define PACKER_IS_SIMD_KERNEL_AVAILABLE 0
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Get a packed integers size range.
+ * @param Width The packed integers size.
+ * @param Pointer_Minimum On output, contain the smallest integer.
+ * @param Pointer_Maximum On output, contain the biggest integer.
+ */
+static void PackerGetRange(TPackerWidth Width, double *Pointer_Minimum, double *Pointer_Maximum)
+{
+	switch (Width)
+	{
+		case PACKER_WIDTH_8_BITS:
+			*Pointer_Minimum = SCHAR_MIN;
+			*Pointer_Maximum = SCHAR_MAX;
+			break;
+			
+		case PACKER_WIDTH_16_BITS:
+			*Pointer_Minimum = SHRT_MIN;
+			*Pointer_Maximum = SHRT_MAX;
+			break;
+			
+		default:
+			*Pointer_Minimum = INT_MIN;
+			*Pointer_Maximum = INT_MAX;
+			break;
+	}
+}
+
+/** The portable kernel, see PackerRoundAndPack() for the parameters. */
+static void PackerRoundAndPackScalar(const double *Pointer_Numbers, unsigned int Stride, unsigned int Count, TPackerWidth Width, void *Pointer_Packed_Integers)
+{
+	unsigned int i;
+	double Number, Minimum, Maximum;
+	long Integer;
+	
+	PackerGetRange(Width, &Minimum, &Maximum);
+	for (i = 0; i < Count; i++)
+	{
+		// Saturate before rounding, the range limits are integers so the result is the same
+		Number = *Pointer_Numbers;
+		if (isnan(Number)) Number = 0;
+		else if (Number < Minimum) Number = Minimum;
+		else if (Number > Maximum) Number = Maximum;
+		Integer = lrint(Number);
+		
+		if (Width == PACKER_WIDTH_8_BITS) ((signed char *) Pointer_Packed_Integers)[i] = (signed char) Integer;
+		else if (Width == PACKER_WIDTH_16_BITS) ((signed short *) Pointer_Packed_Integers)[i] = (signed short) Integer;
+		else ((int *) Pointer_Packed_Integers)[i] = (int) Integer;
+		Pointer_Numbers += Stride;
+	}
+}
+
+#if PACKER_IS_SIMD_KERNEL_AVAILABLE
+/** Load two numbers.
+ * @param Pointer_Numbers The first number.
+ * @param Stride How many doubles are between the two numbers.
+ * @return The numbers.
+ */
+static inline __attribute__((target("sse4.1"))) __m128d PackerLoadNumbers(const double *Pointer_Numbers, unsigned int Stride)
+{
+	if (Stride == 1) return _mm_loadu_pd(Pointer_Numbers);
+	return _mm_loadh_pd(_mm_load_sd(Pointer_Numbers), Pointer_Numbers + Stride);
+}
+
+/** Round and saturate two numbers to 32-bit integers.
+ * @param Numbers The numbers.
+ * @param Minimum The range lowest integer, in both lanes.
+ * @param Maximum The range highest integer, in both lanes.
+ * @return The integers in the two low lanes.
+ */
+static inline __attribute__((target("sse4.1"))) __m128i PackerRoundNumbers(__m128d Numbers, __m128d Minimum, __m128d Maximum)
+{
+	// Clear NaN values, then saturate (the range limits are integers, so saturating before rounding gives the same result)
+	Numbers = _mm_and_pd(Numbers, _mm_cmpord_pd(Numbers, Numbers));
+	Numbers = _mm_min_pd(_mm_max_pd(Numbers, Minimum), Maximum);
+	
+	// Round with the current rounding mode like lrint() does, the conversion is then exact
+	return _mm_cvtpd_epi32(_mm_round_pd(Numbers, _MM_FROUND_CUR_DIRECTION));
+}
+
+/** The SSE4.1 kernel, packing 8 numbers per iteration, see PackerRoundAndPack() for the parameters. */
+static __attribute__((target("sse4.1"))) void PackerRoundAndPackSSE41(const double *Pointer_Numbers, unsigned int Stride, unsigned int Count, TPackerWidth Width, void *Pointer_Packed_Integers)
+{
+	unsigned int i;
+	double Minimum, Maximum;
+	__m128d Minimums, Maximums;
+	__m128i Low_Integers, High_Integers, Packed_Integers;
+	
+	PackerGetRange(Width, &Minimum, &Maximum);
+	Minimums = _mm_set1_pd(Minimum);
+	Maximums = _mm_set1_pd(Maximum);
+	
+	for (i = 0; i + 8 <= Count; i += 8)
+	{
+		Low_Integers = _mm_unpacklo_epi64(PackerRoundNumbers(PackerLoadNumbers(Pointer_Numbers, Stride), Minimums, Maximums), PackerRoundNumbers(PackerLoadNumbers(Pointer_Numbers + 2 * Stride, Stride), Minimums, Maximums));
+		High_Integers = _mm_unpacklo_epi64(PackerRoundNumbers(PackerLoadNumbers(Pointer_Numbers + 4 * Stride, Stride), Minimums, Maximums), PackerRoundNumbers(PackerLoadNumbers(Pointer_Numbers + 6 * Stride, Stride), Minimums, Maximums));
+		Pointer_Numbers += 8 * Stride;
+		
+		// The integers are already in range, so the saturating packing instructions only narrow them
+		if (Width == PACKER_WIDTH_8_BITS)
+		{
+			Packed_Integers = _mm_packs_epi16(_mm_packs_epi32(Low_Integers, High_Integers), _mm_setzero_si128());
+			_mm_storel_epi64((__m128i *) ((signed char *) Pointer_Packed_Integers + i), Packed_Integers);
+		}
+		else if (Width == PACKER_WIDTH_16_BITS) _mm_storeu_si128((__m128i *) ((signed short *) Pointer_Packed_Integers + i), _mm_packs_epi32(Low_Integers, High_Integers));
+		else
+		{
+			_mm_storeu_si128((__m128i *) ((int *) Pointer_Packed_Integers + i), Low_Integers);
+			_mm_storeu_si128((__m128i *) ((int *) Pointer_Packed_Integers + i + 4), High_Integers);
+		}
+	}
+	
+	// Pack the remaining numbers
+	PackerRoundAndPackScalar(Pointer_Numbers, Stride, Count - i, Width, (char *) Pointer_Packed_Integers + (size_t) i * Width);
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+void PackerRoundAndPack(const double *Pointer_Numbers, unsigned int Stride, unsigned int Count, TPackerWidth Width, void *Pointer_Packed_Integers)
+{
+	#if PACKER_IS_SIMD_KERNEL_AVAILABLE
+		if (__builtin_cpu_supports("sse4.1"))
+		{
+			PackerRoundAndPackSSE41(Pointer_Numbers, Stride, Count, Width, Pointer_Packed_Integers);
+			return;
+		}
+	#endif
+	PackerRoundAndPackScalar(Pointer_Numbers, Stride, Count, Width, Pointer_Packed_Integers);
+}
+
+TPackerWidth PackerGetNarrowestWidth(const int *Pointer_Integers, unsigned int Count)
+{
+	unsigned int i;
+	int Minimum = 0, Maximum = 0;
+	
+	for (i = 0; i < Count; i++)
+	{
+		if (Pointer_Integers[i] < Minimum) Minimum = Pointer_Integers[i];
+		if (Pointer_Integers[i] > Maximum) Maximum = Pointer_Integers[i];
+	}
+	
+	if ((Minimum >= SCHAR_MIN) && (Maximum <= SCHAR_MAX)) return PACKER_WIDTH_8_BITS;
+	if ((Minimum >= SHRT_MIN) && (Maximum <= SHRT_MAX)) return PACKER_WIDTH_16_BITS;
+	return PACKER_WIDTH_32_BITS;
+}
+
+const char *PackerGetTypeName(TPackerWidth Width)
+{
+	if (Width == PACKER_WIDTH_8_BITS) return "signed char";
+	if (Width == PACKER_WIDTH_16_BITS) return "signed short";
+	return "signed int";
+}
@@ -0,0 +1,45 @@
+/** @file Packer.h
+ * Round temperatures to integers and pack them into 8-bit, 16-bit or 32-bit signed integer arrays, with a SIMD kernel when the processor supports it.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_PACKER_H
+#define H_PACKER_H
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** All packed integer sizes. */
+typedef enum
+{
+	PACKER_WIDTH_8_BITS = 1, //!< signed char values.
+	PACKER_WIDTH_16_BITS = 2, //!< signed short values.
+	PACKER_WIDTH_32_BITS = 4 //!< int values.
+} TPackerWidth;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Round numbers to the nearest integers, the same way lrint() does (using the current rounding mode), then saturate them to the packed integer range and store them.
+ * NaN values are stored as 0.
+ * @param Pointer_Numbers The numbers to round. They don't need to be contiguous, see Stride.
+ * @param Stride How many doubles are between two consecutive numbers (1 for a plain array).
+ * @param Count How many numbers to pack.
+ * @param Width The packed integers size.
+ * @param Pointer_Packed_Integers On output, contain the packed integers. This array must have room for Count values of the chosen width.
+ */
+void PackerRoundAndPack(const double *Pointer_Numbers, unsigned int Stride, unsigned int Count, TPackerWidth Width, void *Pointer_Packed_Integers);
+
+/** Find the narrowest packed integer size that can hold all integers of an array.
+ * @param Pointer_Integers The integers.
+ * @param Count How many integers there are.
+ * @return The narrowest width.
+ */
+TPackerWidth PackerGetNarrowestWidth(const int *Pointer_Integers, unsigned int Count);
+
+/** Get the C type corresponding to a packed integers size.
+ * @param Width The packed integers size.
+ * @return The C type name.
+ */
+const char *PackerGetTypeName(TPackerWidth Width);
+
+#endif
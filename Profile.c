@@ -0,0 +1,81 @@
+/** @file Profile.c
+ * See Profile.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <stdio.h>
+#include "Cache.h"
+#include "Profile.h"
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** Change this value each time the profile settings change, so previous profiles are not used anymore. */
+#define PROFILE_VERSION 1
+
+/** The longest allowed path string. */
+#define PROFILE_MAXIMUM_PATH_LENGTH 4096
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Get the profile file path.
+ * @param Pointer_String_File_Name On output, contain the file path.
+ * @param Size The output string size.
+ * @param Is_Creation_Enabled Set to 1 to create the cache directory if it does not exist.
+ * @return 0 on success,
+ * @return -1 if the cache directory is not usable.
+ */
+static int ProfileGetFileName(char *Pointer_String_File_Name, size_t Size, int Is_Creation_Enabled)
+{
+	char String_Directory[PROFILE_MAXIMUM_PATH_LENGTH - 64];
+	
+	if (CacheGetDirectory(String_Directory, sizeof(String_Directory), Is_Creation_Enabled) != 0) return -1;
+	snprintf(Pointer_String_File_Name, Size, "%s/tuning-profile-v%d.txt", String_Directory, PROFILE_VERSION);
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int ProfileLoad(TProfile *Pointer_Profile)
+{
+	char String_File_Name[PROFILE_MAXIMUM_PATH_LENGTH];
+	FILE *Pointer_File;
+	int Result;
+	
+	// Only the tuner creates the cache directory, a run without profile must not leave anything behind
+	if ((ProfileGetFileName(String_File_Name, sizeof(String_File_Name), 0) != 0) || !CacheIsFileTrusted(String_File_Name)) return -1;
+	Pointer_File = fopen(String_File_Name, "r");
+	if (Pointer_File == NULL) return -1;
+	
+	Result = fscanf(Pointer_File, "online_cpus=%u\nworkers=%u\nworker_minimum_values=%u\nformatter_rows=%u\n", &Pointer_Profile->Online_CPUs_Count, &Pointer_Profile->Workers_Count, &Pointer_Profile->Worker_Minimum_Values_Count, &Pointer_Profile->Formatter_Rows_Count);
+	fclose(Pointer_File);
+	
+	// Do not use a truncated or hand-edited profile with meaningless settings
+	if ((Result != 4) || (Pointer_Profile->Workers_Count == 0) || (Pointer_Profile->Worker_Minimum_Values_Count == 0) || (Pointer_Profile->Formatter_Rows_Count == 0)) return -1;
+	return 0;
+}
+
+int ProfileSave(const TProfile *Pointer_Profile, char *Pointer_String_File_Name, size_t Size)
+{
+	char String_Temporary_File_Name[PROFILE_MAXIMUM_PATH_LENGTH + 16];
+	FILE *Pointer_File;
+	int Result;
+	
+	if (ProfileGetFileName(Pointer_String_File_Name, Size, 1) != 0) return -1;
+	
+	// Write to a temporary file renamed at the end, so a concurrent run never reads a partial profile
+	snprintf(String_Temporary_File_Name, sizeof(String_Temporary_File_Name), "%s.tmp", Pointer_String_File_Name);
+	Pointer_File = fopen(String_Temporary_File_Name, "w");
+	if (Pointer_File == NULL) return -1;
+	
+	fprintf(Pointer_File, "online_cpus=%u\nworkers=%u\nworker_minimum_values=%u\nformatter_rows=%u\n", Pointer_Profile->Online_CPUs_Count, Pointer_Profile->Workers_Count, Pointer_Profile->Worker_Minimum_Values_Count, Pointer_Profile->Formatter_Rows_Count);
+	Result = ferror(Pointer_File);
+	if (fclose(Pointer_File) != 0) Result = -1;
+	if ((Result != 0) || (rename(String_Temporary_File_Name, Pointer_String_File_Name) != 0))
+	{
+		remove(String_Temporary_File_Name);
+		return -1;
+	}
+	return 0;
+}
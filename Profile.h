@@ -0,0 +1,41 @@
+/** @file Profile.h
+ * Store the tuning profile found by the autotuner in the user cache directory, so the next runs use the fastest settings of this machine.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_PROFILE_H
+#define H_PROFILE_H
+
+#include <stddef.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A tuning profile. */
+typedef struct
+{
+	unsigned int Online_CPUs_Count; //!< How many CPUs were online when the profile was tuned, the profile is not used on a different amount of CPUs.
+	unsigned int Workers_Count; //!< How many threads compute the values.
+	unsigned int Worker_Minimum_Values_Count; //!< The smallest amount of values worth a compute thread.
+	unsigned int Formatter_Rows_Count; //!< How many detail table rows a formatter renders to its output buffer at once.
+} TProfile;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Read the tuning profile from the cache directory, the directory is not created if it does not exist. The settings are only checked to be non-zero, the caller must check them against its own limits.
+ * @param Pointer_Profile On output, contain the profile settings.
+ * @return 0 on success,
+ * @return -1 if there is no profile or if it could not be read.
+ */
+int ProfileLoad(TProfile *Pointer_Profile);
+
+/** Write the tuning profile to the cache directory, replacing the previous one.
+ * @param Pointer_Profile The profile settings.
+ * @param Pointer_String_File_Name On output, contain the profile file path.
+ * @param Size The file path string size.
+ * @return 0 on success,
+ * @return -1 if the profile could not be written.
+ */
+int ProfileSave(const TProfile *Pointer_Profile, char *Pointer_String_File_Name, size_t Size);
+
+#endif
@@ -0,0 +1,427 @@
+/** @file ThermistorCalculatorModule.c
+ * CPython extension module computing the thermistor values straight into the caller arrays (NumPy arrays or any other object supporting the buffer protocol), without copying them nor parsing the program text output.
+ * The computations run without the global interpreter lock, so several Python threads can compute at the same time.
+ * @author Adrien RICCIARDI
+ */
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "../Thermistor.h"
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** The default Monte Carlo random generator seed. */
+#define MODULE_DEFAULT_RANDOM_SEED 0x2545F4914F6CDD1DULL
+
+/** The biggest allowed ADC resolution, like the program one. */
+#define MODULE_MAXIMUM_ADC_RESOLUTION 65536
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** A circuit configuration, the defaults are the program ones. */
+typedef struct
+{
+	int Circuit_Variant; //!< The circuit variant (1 or 2).
+	double Thermistor_Beta_Coefficient; //!< Beta coefficient value (kelvin).
+	double Thermistor_Reference_Resistance; //!< Thermistor R25 resistor value (ohms).
+	double Voltage_Divider_Resistor; //!< The bridge resistor value (ohms).
+	double Voltage_Divider_Bridge_Voltage; //!< Vcc voltage (volts).
+} TModuleConfiguration;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Get a C-contiguous array of doubles from an object supporting the buffer protocol.
+ * @param Pointer_Object The object.
+ * @param Pointer_Buffer On output, contain the buffer view. Release it with PyBuffer_Release() when the function succeeded.
+ * @param Is_Writable Set to 1 if the values will be written.
+ * @param Pointer_String_Name The argument name, to tell which one is wrong in the error message.
+ * @return 0 on success,
+ * @return -1 if an exception was raised.
+ */
+static int ModuleGetDoublesBuffer(PyObject *Pointer_Object, Py_buffer *Pointer_Buffer, int Is_Writable, const char *Pointer_String_Name)
+{
+	const char *Pointer_String_Format;
+	
+	if (PyObject_GetBuffer(Pointer_Object, Pointer_Buffer, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (Is_Writable ? PyBUF_WRITABLE : 0)) != 0) return -1;
+	
+	// Native doubles only, the byte order and alignment characters are allowed when they give the native layout
+	Pointer_String_Format = Pointer_Buffer->format;
+	if ((Pointer_String_Format[0] == '@') || (Pointer_String_Format[0] == '=')) Pointer_String_Format++;
+	if ((strcmp(Pointer_String_Format, "d") != 0) || (Pointer_Buffer->itemsize != sizeof(double)))
+	{
+		PyErr_Format(PyExc_TypeError, "%s must be a contiguous array of float64 values", Pointer_String_Name);
+		PyBuffer_Release(Pointer_Buffer);
+		return -1;
+	}
+	return 0;
+}
+
+/** Make sure that a configuration can be computed.
+ * @param Pointer_Configuration The configuration.
+ * @return 0 on success,
+ * @return -1 if an exception was raised.
+ */
+static int ModuleCheckConfiguration(const TModuleConfiguration *Pointer_Configuration)
+{
+	if ((Pointer_Configuration->Circuit_Variant < 1) || (Pointer_Configuration->Circuit_Variant > 2))
+	{
+		PyErr_SetString(PyExc_ValueError, "circuit must be 1 or 2");
+		return -1;
+	}
+	return 0;
+}
+
+/** Make sure that an ADC resolution is supported.
+ * @param ADC_Resolution The resolution.
+ * @return 0 on success,
+ * @return -1 if an exception was raised.
+ */
+static int ModuleCheckADCResolution(Py_ssize_t ADC_Resolution)
+{
+	if ((ADC_Resolution < 2) || (ADC_Resolution > MODULE_MAXIMUM_ADC_RESOLUTION))
+	{
+		PyErr_Format(PyExc_ValueError, "the ADC resolution must be in range [2; %d]", MODULE_MAXIMUM_ADC_RESOLUTION);
+		return -1;
+	}
+	return 0;
+}
+
+/** Compute a whole table, exactly like the program does.
+ * @param Pointer_Configuration The configuration.
+ * @param ADC_Resolution How many values to compute.
+ * @param Pointer_Voltages On output, contain the voltage divider output voltages. Set NULL if they are not needed.
+ * @param Pointer_Resistances On output, contain the thermistor resistances. Set NULL if they are not needed.
+ * @param Pointer_Temperatures On output, contain the thermistor temperatures.
+ */
+static void ModuleComputeTable(const TModuleConfiguration *Pointer_Configuration, unsigned int ADC_Resolution, double *Pointer_Voltages, double *Pointer_Resistances, double *Pointer_Temperatures)
+{
+	double Voltage, Resistance;
+	unsigned int i;
+	
+	for (i = 0; i < ADC_Resolution; i++)
+	{
+		Voltage = ThermistorComputeVoltageDividerOutputVoltage(Pointer_Configuration->Voltage_Divider_Bridge_Voltage, ADC_Resolution, i);
+		Resistance = ThermistorComputeResistance(Pointer_Configuration->Circuit_Variant, Pointer_Configuration->Voltage_Divider_Bridge_Voltage, Voltage, Pointer_Configuration->Voltage_Divider_Resistor);
+		if (Pointer_Voltages != NULL) Pointer_Voltages[i] = Voltage;
+		if (Pointer_Resistances != NULL) Pointer_Resistances[i] = Resistance;
+		Pointer_Temperatures[i] = ThermistorComputeTemperature(Pointer_Configuration->Thermistor_Beta_Coefficient, Pointer_Configuration->Thermistor_Reference_Resistance, Resistance);
+	}
+}
+
+/** Generate a uniformly distributed random number with the xorshift64* generator (the program generators use the same one).
+ * @param Pointer_State The generator state, it must not be zero.
+ * @return A number in range ]0; 1].
+ */
+static inline double ModuleGenerateRandomNumber(uint64_t *Pointer_State)
+{
+	uint64_t State = *Pointer_State;
+	
+	State ^= State >> 12;
+	State ^= State << 25;
+	State ^= State >> 27;
+	*Pointer_State = State;
+	
+	// Keep the 53 most significant bits, which fill a double mantissa
+	return (((State * 0x2545F4914F6CDD1DULL) >> 11) + 1) * (1. / 9007199254740992.);
+}
+
+/** Generate a normally distributed random number with the Marsaglia polar method.
+ * @param Pointer_State The generator state.
+ * @return A number of a normal distribution with zero mean and unit variance.
+ */
+static double ModuleGenerateGaussianNumber(uint64_t *Pointer_State)
+{
+	double X, Y, Radius;
+	
+	do
+	{
+		X = 2. * ModuleGenerateRandomNumber(Pointer_State) - 1.;
+		Y = 2. * ModuleGenerateRandomNumber(Pointer_State) - 1.;
+		Radius = X * X + Y * Y;
+	} while ((Radius >= 1.) || (Radius == 0));
+	return X * sqrt(-2. * log(Radius) / Radius);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Module functions
+//-------------------------------------------------------------------------------------------------
+PyDoc_STRVAR(Module_Table_Documentation,
+	"table(temperatures, voltages=None, resistances=None, *, circuit=1, beta=4300., r25=10000., resistor=10000., vcc=3.3)\n"
+	"--\n"
+	"\n"
+	"Compute the thermistor temperature (Celsius) of each ADC value to the temperatures array, the ADC resolution is the array length.\n"
+	"The voltage divider output voltages (V) and the thermistor resistances (ohm) are also written to the voltages and resistances arrays when they are given.\n"
+	"The values are bit-identical to the program ones (see its -b option). The arrays must be contiguous float64 arrays, like NumPy ones.");
+
+static PyObject *ModuleTable(PyObject *Pointer_Self, PyObject *Pointer_Arguments, PyObject *Pointer_Keywords)
+{
+	static char *Keywords[] = { "temperatures", "voltages", "resistances", "circuit", "beta", "r25", "resistor", "vcc", NULL };
+	TModuleConfiguration Configuration = { 1, 4300., 10000., 10000., 3.3 };
+	PyObject *Pointer_Temperatures_Object, *Pointer_Voltages_Object = Py_None, *Pointer_Resistances_Object = Py_None;
+	Py_buffer Temperatures_Buffer, Voltages_Buffer, Resistances_Buffer;
+	double *Pointer_Voltages = NULL, *Pointer_Resistances = NULL;
+	Py_ssize_t ADC_Resolution;
+	int Is_Voltages_Buffer_Used = 0, Is_Resistances_Buffer_Used = 0;
+	PyObject *Pointer_Result = NULL;
+	
+	(void) Pointer_Self;
+	
+	if (!PyArg_ParseTupleAndKeywords(Pointer_Arguments, Pointer_Keywords, "O|OO$idddd", Keywords, &Pointer_Temperatures_Object, &Pointer_Voltages_Object, &Pointer_Resistances_Object, &Configuration.Circuit_Variant, &Configuration.Thermistor_Beta_Coefficient, &Configuration.Thermistor_Reference_Resistance, &Configuration.Voltage_Divider_Resistor, &Configuration.Voltage_Divider_Bridge_Voltage)) return NULL;
+	if (ModuleCheckConfiguration(&Configuration) != 0) return NULL;
+	
+	if (ModuleGetDoublesBuffer(Pointer_Temperatures_Object, &Temperatures_Buffer, 1, "temperatures") != 0) return NULL;
+	ADC_Resolution = Temperatures_Buffer.len / (Py_ssize_t) sizeof(double);
+	if (ModuleCheckADCResolution(ADC_Resolution) != 0) goto Exit;
+	
+	// The optional arrays must have the same length
+	if (Pointer_Voltages_Object != Py_None)
+	{
+		if (ModuleGetDoublesBuffer(Pointer_Voltages_Object, &Voltages_Buffer, 1, "voltages") != 0) goto Exit;
+		Is_Voltages_Buffer_Used = 1;
+		if (Voltages_Buffer.len != Temperatures_Buffer.len)
+		{
+			PyErr_SetString(PyExc_ValueError, "voltages must have the same length as temperatures");
+			goto Exit;
+		}
+		Pointer_Voltages = Voltages_Buffer.buf;
+	}
+	if (Pointer_Resistances_Object != Py_None)
+	{
+		if (ModuleGetDoublesBuffer(Pointer_Resistances_Object, &Resistances_Buffer, 1, "resistances") != 0) goto Exit;
+		Is_Resistances_Buffer_Used = 1;
+		if (Resistances_Buffer.len != Temperatures_Buffer.len)
+		{
+			PyErr_SetString(PyExc_ValueError, "resistances must have the same length as temperatures");
+			goto Exit;
+		}
+		Pointer_Resistances = Resistances_Buffer.buf;
+	}
+	
+	Py_BEGIN_ALLOW_THREADS
+	ModuleComputeTable(&Configuration, (unsigned int) ADC_Resolution, Pointer_Voltages, Pointer_Resistances, Temperatures_Buffer.buf);
+	Py_END_ALLOW_THREADS
+	
+	Py_INCREF(Py_None);
+	Pointer_Result = Py_None;
+	
+Exit:
+	if (Is_Resistances_Buffer_Used) PyBuffer_Release(&Resistances_Buffer);
+	if (Is_Voltages_Buffer_Used) PyBuffer_Release(&Voltages_Buffer);
+	PyBuffer_Release(&Temperatures_Buffer);
+	return Pointer_Result;
+}
+
+PyDoc_STRVAR(Module_Sweep_Documentation,
+	"sweep(parameter, values, temperatures, *, circuit=1, beta=4300., r25=10000., resistor=10000., vcc=3.3)\n"
+	"--\n"
+	"\n"
+	"Compute one table for each value of a parameter, the other parameters keeping their given value.\n"
+	"The parameter can be \"beta\", \"r25\", \"resistor\" or \"vcc\". The temperatures array holds len(values) tables one after the other (like a NumPy array of shape (len(values), resolution)), so the ADC resolution is its length divided by the values count.\n"
+	"The arrays must be contiguous float64 arrays, like NumPy ones.");
+
+static PyObject *ModuleSweep(PyObject *Pointer_Self, PyObject *Pointer_Arguments, PyObject *Pointer_Keywords)
+{
+	static char *Keywords[] = { "parameter", "values", "temperatures", "circuit", "beta", "r25", "resistor", "vcc", NULL };
+	TModuleConfiguration Configuration = { 1, 4300., 10000., 10000., 3.3 };
+	const char *Pointer_String_Parameter;
+	PyObject *Pointer_Values_Object, *Pointer_Temperatures_Object, *Pointer_Result = NULL;
+	Py_buffer Values_Buffer, Temperatures_Buffer;
+	double *Pointer_Parameter, *Pointer_Values, *Pointer_Temperatures;
+	Py_ssize_t Values_Count, ADC_Resolution, i;
+	
+	(void) Pointer_Self;
+	
+	if (!PyArg_ParseTupleAndKeywords(Pointer_Arguments, Pointer_Keywords, "sOO|$idddd", Keywords, &Pointer_String_Parameter, &Pointer_Values_Object, &Pointer_Temperatures_Object, &Configuration.Circuit_Variant, &Configuration.Thermistor_Beta_Coefficient, &Configuration.Thermistor_Reference_Resistance, &Configuration.Voltage_Divider_Resistor, &Configuration.Voltage_Divider_Bridge_Voltage)) return NULL;
+	if (ModuleCheckConfiguration(&Configuration) != 0) return NULL;
+	
+	// Find the swept configuration field
+	if (strcmp(Pointer_String_Parameter, "beta") == 0) Pointer_Parameter = &Configuration.Thermistor_Beta_Coefficient;
+	else if (strcmp(Pointer_String_Parameter, "r25") == 0) Pointer_Parameter = &Configuration.Thermistor_Reference_Resistance;
+	else if (strcmp(Pointer_String_Parameter, "resistor") == 0) Pointer_Parameter = &Configuration.Voltage_Divider_Resistor;
+	else if (strcmp(Pointer_String_Parameter, "vcc") == 0) Pointer_Parameter = &Configuration.Voltage_Divider_Bridge_Voltage;
+	else
+	{
+		PyErr_SetString(PyExc_ValueError, "parameter must be \"beta\", \"r25\", \"resistor\" or \"vcc\"");
+		return NULL;
+	}
+	
+	if (ModuleGetDoublesBuffer(Pointer_Values_Object, &Values_Buffer, 0, "values") != 0) return NULL;
+	if (ModuleGetDoublesBuffer(Pointer_Temperatures_Object, &Temperatures_Buffer, 1, "temperatures") != 0)
+	{
+		PyBuffer_Release(&Values_Buffer);
+		return NULL;
+	}
+	Values_Count = Values_Buffer.len / (Py_ssize_t) sizeof(double);
+	if ((Values_Count == 0) || (Temperatures_Buffer.len % Values_Buffer.len != 0))
+	{
+		PyErr_SetString(PyExc_ValueError, "values must not be empty and temperatures length must be a multiple of values length");
+		goto Exit;
+	}
+	ADC_Resolution = Temperatures_Buffer.len / Values_Buffer.len;
+	if (ModuleCheckADCResolution(ADC_Resolution) != 0) goto Exit;
+	
+	Pointer_Values = Values_Buffer.buf;
+	Pointer_Temperatures = Temperatures_Buffer.buf;
+	Py_BEGIN_ALLOW_THREADS
+	for (i = 0; i < Values_Count; i++)
+	{
+		*Pointer_Parameter = Pointer_Values[i];
+		ModuleComputeTable(&Configuration, (unsigned int) ADC_Resolution, NULL, NULL, &Pointer_Temperatures[i * ADC_Resolution]);
+	}
+	Py_END_ALLOW_THREADS
+	
+	Py_INCREF(Py_None);
+	Pointer_Result = Py_None;
+	
+Exit:
+	PyBuffer_Release(&Temperatures_Buffer);
+	PyBuffer_Release(&Values_Buffer);
+	return Pointer_Result;
+}
+
+PyDoc_STRVAR(Module_Monte_Carlo_Documentation,
+	"monte_carlo(errors, minimum_temperature, maximum_temperature, *, beta_tolerance=1., r25_tolerance=1., resistor_tolerance=1., resolution=256, circuit=1, beta=4300., r25=10000., resistor=10000., vcc=3.3, seed=None)\n"
+	"--\n"
+	"\n"
+	"Draw len(errors) circuits built with toleranced parts, and write the biggest temperature error (Celsius) of each one to the errors array, when its ADC values are converted with the nominal circuit rounded lookup table.\n"
+	"Only the ADC values whose nominal temperature is in the [minimum_temperature; maximum_temperature] range are considered, like the program -Y option does. The tolerances are in percent and taken as three standard deviations.\n"
+	"The yield for an error limit is then (errors <= limit).mean(), the program -Y option estimates the rare failure probabilities more efficiently.\n"
+	"The same seed always gives the same errors. The errors array must be a contiguous float64 array, like a NumPy one.");
+
+static PyObject *ModuleMonteCarlo(PyObject *Pointer_Self, PyObject *Pointer_Arguments, PyObject *Pointer_Keywords)
+{
+	static char *Keywords[] = { "errors", "minimum_temperature", "maximum_temperature", "beta_tolerance", "r25_tolerance", "resistor_tolerance", "resolution", "circuit", "beta", "r25", "resistor", "vcc", "seed", NULL };
+	TModuleConfiguration Configuration = { 1, 4300., 10000., 10000., 3.3 };
+	PyObject *Pointer_Errors_Object, *Pointer_Seed_Object = Py_None, *Pointer_Result = NULL;
+	Py_buffer Errors_Buffer;
+	double Minimum_Temperature, Maximum_Temperature, Tolerances[3] = { 1., 1., 1. }, Standard_Deviations[3], *Pointer_Logarithmic_Resistances = NULL, *Pointer_Table_Temperatures = NULL, *Pointer_Errors, Inverse_Beta, Logarithmic_Offset, Factors[3], Error, Maximum_Error, Resistance, Temperature;
+	unsigned int ADC_Resolution = 256, ADC_Value, Values_Count = 0, j;
+	unsigned long long Seed = MODULE_DEFAULT_RANDOM_SEED;
+	uint64_t Random_State;
+	Py_ssize_t Samples_Count, i;
+	
+	(void) Pointer_Self;
+	
+	if (!PyArg_ParseTupleAndKeywords(Pointer_Arguments, Pointer_Keywords, "Odd|$dddIiddddO", Keywords, &Pointer_Errors_Object, &Minimum_Temperature, &Maximum_Temperature, &Tolerances[0], &Tolerances[1], &Tolerances[2], &ADC_Resolution, &Configuration.Circuit_Variant, &Configuration.Thermistor_Beta_Coefficient, &Configuration.Thermistor_Reference_Resistance, &Configuration.Voltage_Divider_Resistor, &Configuration.Voltage_Divider_Bridge_Voltage, &Pointer_Seed_Object)) return NULL;
+	if (ModuleCheckConfiguration(&Configuration) != 0) return NULL;
+	if (ModuleCheckADCResolution(ADC_Resolution) != 0) return NULL;
+	if ((Minimum_Temperature >= Maximum_Temperature) || (Minimum_Temperature <= -THERMISTOR_KELVIN_OFFSET))
+	{
+		PyErr_SetString(PyExc_ValueError, "the range minimum temperature must be above absolute zero and lower than the maximum temperature");
+		return NULL;
+	}
+	for (j = 0; j < 3; j++)
+	{
+		if (!(Tolerances[j] >= 0) || (Tolerances[j] >= 100))
+		{
+			PyErr_SetString(PyExc_ValueError, "the tolerances must be in range [0; 100[ percent");
+			return NULL;
+		}
+		Standard_Deviations[j] = Tolerances[j] / 300.; // The tolerance is three standard deviations
+	}
+	if (Pointer_Seed_Object != Py_None)
+	{
+		Seed = PyLong_AsUnsignedLongLongMask(Pointer_Seed_Object);
+		if (PyErr_Occurred()) return NULL;
+		if (Seed == 0) Seed = MODULE_DEFAULT_RANDOM_SEED; // The generator state must not be zero
+	}
+	
+	if (ModuleGetDoublesBuffer(Pointer_Errors_Object, &Errors_Buffer, 1, "errors") != 0) return NULL;
+	Samples_Count = Errors_Buffer.len / (Py_ssize_t) sizeof(double);
+	Pointer_Errors = Errors_Buffer.buf;
+	
+	Pointer_Logarithmic_Resistances = PyMem_Malloc(ADC_Resolution * sizeof(double));
+	Pointer_Table_Temperatures = PyMem_Malloc(ADC_Resolution * sizeof(double));
+	if ((Pointer_Logarithmic_Resistances == NULL) || (Pointer_Table_Temperatures == NULL))
+	{
+		PyErr_NoMemory();
+		goto Exit;
+	}
+	
+	// Keep the operating range ADC values of the nominal rounded table, the lowest and highest ADC values do not correspond to a finite resistance
+	for (ADC_Value = 1; ADC_Value < ADC_Resolution - 1; ADC_Value++)
+	{
+		Resistance = ThermistorComputeResistance(Configuration.Circuit_Variant, Configuration.Voltage_Divider_Bridge_Voltage, ThermistorComputeVoltageDividerOutputVoltage(Configuration.Voltage_Divider_Bridge_Voltage, ADC_Resolution, ADC_Value), Configuration.Voltage_Divider_Resistor);
+		Temperature = ThermistorComputeTemperature(Configuration.Thermistor_Beta_Coefficient, Configuration.Thermistor_Reference_Resistance, Resistance);
+		if ((Temperature < Minimum_Temperature) || (Temperature > Maximum_Temperature)) continue;
+		
+		Pointer_Logarithmic_Resistances[Values_Count] = log(Resistance / Configuration.Thermistor_Reference_Resistance);
+		Pointer_Table_Temperatures[Values_Count] = (double) lrint(Temperature);
+		Values_Count++;
+	}
+	if (Values_Count == 0)
+	{
+		PyErr_SetString(PyExc_ValueError, "no ADC value corresponds to the temperature range");
+		goto Exit;
+	}
+	
+	Py_BEGIN_ALLOW_THREADS
+	Random_State = Seed;
+	for (i = 0; i < Samples_Count; i++)
+	{
+		// Draw the Beta, R25 and voltage divider resistor deviations, a part with a negative value can't work
+		for (j = 0; j < 3; j++) Factors[j] = 1. + Standard_Deviations[j] * ModuleGenerateGaussianNumber(&Random_State);
+		if ((Factors[0] <= 0) || (Factors[1] <= 0) || (Factors[2] <= 0))
+		{
+			Pointer_Errors[i] = HUGE_VAL;
+			continue;
+		}
+		
+		// The ADC reference is the voltage divider supply, so the resistors deviations only offset the resistance logarithm
+		Inverse_Beta = 1. / (Configuration.Thermistor_Beta_Coefficient * Factors[0]);
+		Logarithmic_Offset = log(Factors[2] / Factors[1]);
+		Maximum_Error = 0;
+		for (j = 0; j < Values_Count; j++)
+		{
+			Error = fabs(1. / ((Pointer_Logarithmic_Resistances[j] + Logarithmic_Offset) * Inverse_Beta + 1. / (THERMISTOR_KELVIN_OFFSET + THERMISTOR_REFERENCE_TEMPERATURE)) - THERMISTOR_KELVIN_OFFSET - Pointer_Table_Temperatures[j]);
+			if (Error > Maximum_Error) Maximum_Error = Error;
+		}
+		Pointer_Errors[i] = Maximum_Error;
+	}
+	Py_END_ALLOW_THREADS
+	
+	Py_INCREF(Py_None);
+	Pointer_Result = Py_None;
+	
+Exit:
+	PyMem_Free(Pointer_Table_Temperatures);
+	PyMem_Free(Pointer_Logarithmic_Resistances);
+	PyBuffer_Release(&Errors_Buffer);
+	return Pointer_Result;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Module definition
+//-------------------------------------------------------------------------------------------------
+/** All module functions. */
+static PyMethodDef Module_Methods[] =
+{
+	{ "table", (PyCFunction) (void (*)(void)) ModuleTable, METH_VARARGS | METH_KEYWORDS, Module_Table_Documentation },
+	{ "sweep", (PyCFunction) (void (*)(void)) ModuleSweep, METH_VARARGS | METH_KEYWORDS, Module_Sweep_Documentation },
+	{ "monte_carlo", (PyCFunction) (void (*)(void)) ModuleMonteCarlo, METH_VARARGS | METH_KEYWORDS, Module_Monte_Carlo_Documentation },
+	{ NULL, NULL, 0, NULL }
+};
+
+/** The module description. */
+static struct PyModuleDef Module_Definition =
+{
+	PyModuleDef_HEAD_INIT,
+	"thermistor_calculator",
+	"Compute thermistor values into NumPy arrays (or any writable buffer of float64 values) at native speed, with the thermistor calculator model.",
+	-1,
+	Module_Methods,
+	NULL,
+	NULL,
+	NULL,
+	NULL
+};
+
+PyMODINIT_FUNC PyInit_thermistor_calculator(void)
+{
+	return PyModule_Create(&Module_Definition);
+}
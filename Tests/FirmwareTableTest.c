@@ -0,0 +1,109 @@
+/** @file FirmwareTableTest.c
+ * Make sure that the table generated on the target by Firmware/ThermistorTable.c is within one Celsius degree of the program table.
+ * @author Adrien RICCIARDI
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "../Firmware/ThermistorTable.h"
+#include "ProgramTable.h"
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** The lowest temperature the firmware reports, for the ADC values that do not correspond to a positive Kelvin temperature. */
+#define FIRMWARE_TABLE_TEST_MINIMUM_TEMPERATURE -273
+
+/** The highest temperature a firmware table entry can hold. */
+#define FIRMWARE_TABLE_TEST_MAXIMUM_TEMPERATURE 32767
+
+//-------------------------------------------------------------------------------------------------
+// Private variables
+//-------------------------------------------------------------------------------------------------
+/** The configurations to test, the firmware does not need the Vcc voltage but the program does. */
+static const TProgramTableConfiguration Firmware_Table_Test_Configurations[] =
+{
+	{ 1, 4300., 10000., 10000., 3.3, 256 },
+	{ 2, 3988., 10000., 10000., 3.3, 1024 },
+	{ 1, 3950., 100000., 47000., 5., 4096 },
+	{ 2, 3435., 10000., 4700., 3.3, 65536 },
+	{ 1, 3380., 10000., 1000., 3.3, 4096 },
+	{ 2, 4600., 470000., 1000000., 5., 16384 },
+	{ 1, 2000., 1000., 1000000., 3.3, 65536 }
+};
+
+/** The program table. */
+static int Firmware_Table_Test_Program_Table[THERMISTOR_TABLE_MAXIMUM_ADC_RESOLUTION];
+
+/** The firmware table. */
+static int16_t Firmware_Table_Test_Firmware_Table[THERMISTOR_TABLE_MAXIMUM_ADC_RESOLUTION];
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Compare the firmware table to the program one, and display the result.
+ * @param Pointer_String_Program_Path The thermistor calculator program path.
+ * @param Pointer_Configuration The configuration to generate the tables with.
+ * @return 0 if all firmware values are within one Celsius degree of the program ones,
+ * @return -1 if a value differs more or if a table could not be generated.
+ */
+static int FirmwareTableTestCompare(const char *Pointer_String_Program_Path, const TProgramTableConfiguration *Pointer_Configuration)
+{
+	unsigned int i;
+	int Expected_Temperature, Difference, Maximum_Difference = 0;
+	
+	ProgramTableDisplayConfiguration(Pointer_Configuration);
+	printf(" : ");
+	
+	if (ProgramTableRead(Pointer_String_Program_Path, Pointer_Configuration, Firmware_Table_Test_Program_Table) != 0)
+	{
+		printf("FAILED, could not read the program table.\n");
+		return -1;
+	}
+	if (ThermistorTableGenerate((uint8_t) Pointer_Configuration->Circuit_Variant, (uint16_t) Pointer_Configuration->Thermistor_Beta_Coefficient, (uint32_t) Pointer_Configuration->Thermistor_Reference_Resistance, (uint32_t) Pointer_Configuration->Voltage_Divider_Resistor, Pointer_Configuration->ADC_Resolution, Firmware_Table_Test_Firmware_Table) != 0)
+	{
+		printf("FAILED, the firmware refused the configuration.\n");
+		return -1;
+	}
+	
+	for (i = 0; i < Pointer_Configuration->ADC_Resolution; i++)
+	{
+		// The firmware reports the absolute zero for the temperatures below it, and saturates the ones that do not fit in 16 bits
+		Expected_Temperature = Firmware_Table_Test_Program_Table[i];
+		if (Expected_Temperature < FIRMWARE_TABLE_TEST_MINIMUM_TEMPERATURE) Expected_Temperature = FIRMWARE_TABLE_TEST_MINIMUM_TEMPERATURE;
+		else if (Expected_Temperature > FIRMWARE_TABLE_TEST_MAXIMUM_TEMPERATURE) Expected_Temperature = FIRMWARE_TABLE_TEST_MAXIMUM_TEMPERATURE;
+		
+		Difference = abs(Firmware_Table_Test_Firmware_Table[i] - Expected_Temperature);
+		if (Difference > 1)
+		{
+			printf("FAILED, ADC value %u gives %d Celsius instead of %d.\n", i, Firmware_Table_Test_Firmware_Table[i], Firmware_Table_Test_Program_Table[i]);
+			return -1;
+		}
+		if (Difference > Maximum_Difference) Maximum_Difference = Difference;
+	}
+	
+	printf("OK (biggest difference : %d Celsius).\n", Maximum_Difference);
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Entry point
+//-------------------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+	unsigned int i;
+	int Result = 0;
+	
+	if (argc != 2)
+	{
+		printf("Usage : %s thermistor_calculator_program_path\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	
+	for (i = 0; i < sizeof(Firmware_Table_Test_Configurations) / sizeof(Firmware_Table_Test_Configurations[0]); i++)
+	{
+		if (FirmwareTableTestCompare(argv[1], &Firmware_Table_Test_Configurations[i]) != 0) Result = -1;
+	}
+	
+	if (Result != 0) return EXIT_FAILURE;
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,86 @@
+/** @file HeaderTableTest.cpp
+ * Make sure that the ThermistorCalculator.hpp lookup tables, computed at compile time or at run time, are bit-identical to the program ones.
+ * @author Adrien RICCIARDI
+ */
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include "../ThermistorCalculator.hpp"
+#include "ProgramTable.h"
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Compare a header table to the program one, and display the result.
+ * @param Pointer_String_Program_Path The thermistor calculator program path.
+ * @param Configuration The configuration the table was computed with.
+ * @param Header_Table The header table.
+ * @param Pointer_String_Description Tell how the header table was computed.
+ * @return 0 if the tables are identical,
+ * @return -1 if they differ or if the program table could not be read.
+ */
+template <std::size_t ADC_Resolution>
+static int HeaderTableTestCompare(const char *Pointer_String_Program_Path, const TProgramTableConfiguration &Configuration, const std::array<int, ADC_Resolution> &Header_Table, const char *Pointer_String_Description)
+{
+	static std::array<int, ADC_Resolution> Program_Table;
+	unsigned int i;
+	
+	ProgramTableDisplayConfiguration(&Configuration);
+	std::printf(" (%s) : ", Pointer_String_Description);
+	
+	if (ProgramTableRead(Pointer_String_Program_Path, &Configuration, Program_Table.data()) != 0)
+	{
+		std::printf("FAILED, could not read the program table.\n");
+		return -1;
+	}
+	for (i = 0; i < ADC_Resolution; i++)
+	{
+		if (Header_Table[i] != Program_Table[i])
+		{
+			std::printf("FAILED, ADC value %u is %d instead of %d.\n", i, Header_Table[i], Program_Table[i]);
+			return -1;
+		}
+	}
+	std::printf("OK.\n");
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Entry point
+//-------------------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+	// The constexpr variables force the compile-time evaluation
+	static constexpr TProgramTableConfiguration Configuration_1 = { 1, 4300., 10000., 10000., 3.3, 256 };
+	static constexpr auto Table_1 = ThermistorCalculator::GenerateLookupTable<256>(Configuration_1.Circuit_Variant, Configuration_1.Thermistor_Beta_Coefficient, Configuration_1.Thermistor_Reference_Resistance, Configuration_1.Voltage_Divider_Resistor, Configuration_1.Voltage_Divider_Bridge_Voltage);
+	static constexpr TProgramTableConfiguration Configuration_2 = { 2, 3988., 10000., 10000., 3.3, 1024 };
+	static constexpr auto Table_2 = ThermistorCalculator::GenerateLookupTable<1024>(Configuration_2.Circuit_Variant, Configuration_2.Thermistor_Beta_Coefficient, Configuration_2.Thermistor_Reference_Resistance, Configuration_2.Voltage_Divider_Resistor, Configuration_2.Voltage_Divider_Bridge_Voltage);
+	static constexpr TProgramTableConfiguration Configuration_3 = { 1, 3950., 100000., 47000., 5., 4096 };
+	static constexpr auto Table_3 = ThermistorCalculator::GenerateLookupTable<4096>(Configuration_3.Circuit_Variant, Configuration_3.Thermistor_Beta_Coefficient, Configuration_3.Thermistor_Reference_Resistance, Configuration_3.Voltage_Divider_Resistor, Configuration_3.Voltage_Divider_Bridge_Voltage);
+	static constexpr TProgramTableConfiguration Configuration_4 = { 2, 3988., 10000., 10000., 3.3, 256 };
+	static constexpr TProgramTableConfiguration Configuration_5 = { 2, 3435., 10000., 4700., 3.3, 65536 };
+	static std::array<int, 65536> Table_5;
+	volatile double Beta_Coefficient = Configuration_5.Thermistor_Beta_Coefficient; // Hide the value from the compiler to get a run-time computation
+	int Result = 0;
+	
+	if (argc != 2)
+	{
+		std::printf("Usage : %s thermistor_calculator_program_path\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	
+	if (HeaderTableTestCompare(argv[1], Configuration_1, Table_1, "compile time") != 0) Result = -1;
+	if (HeaderTableTestCompare(argv[1], Configuration_2, Table_2, "compile time") != 0) Result = -1;
+	if (HeaderTableTestCompare(argv[1], Configuration_3, Table_3, "compile time") != 0) Result = -1;
+#if __cplusplus >= 202002L
+	if (HeaderTableTestCompare(argv[1], Configuration_4, ThermistorCalculator::Lookup_Table<256, 2, 3988., 10000., 10000., 3.3>, "variable template") != 0) Result = -1;
+#else
+	(void) Configuration_4;
+#endif
+	Table_5 = ThermistorCalculator::GenerateLookupTable<65536>(Configuration_5.Circuit_Variant, Beta_Coefficient, Configuration_5.Thermistor_Reference_Resistance, Configuration_5.Voltage_Divider_Resistor, Configuration_5.Voltage_Divider_Bridge_Voltage);
+	if (HeaderTableTestCompare(argv[1], Configuration_5, Table_5, "run time") != 0) Result = -1;
+	
+	if (Result != 0) return EXIT_FAILURE;
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,90 @@
+"""Make sure that the JSON and NDJSON outputs numbers round-trip to the program values, and that their tables are the displayed ones, saturated entries included.
+@author Adrien RICCIARDI
+"""
+import json
+import math
+import struct
+import subprocess
+import sys
+
+# Each test is (description, program arguments), the custom expressions give non-finite and out of range temperatures that must be saturated
+Tests = [
+	("Circuit 1, ADC resolution 256", ["-c", "1", "-a", "256"]),
+	("Circuit 2, ADC resolution 4096, type T thermocouple", ["-c", "2", "-B", "3950", "-R", "100000", "-r", "47000", "-a", "4096", "-k", "T"]),
+	("Out of range temperatures, type K thermocouple", ["-a", "1024", "-e", "code * 1e12 - 5e14", "-k", "K"]),
+	("Non-finite temperatures", ["-a", "1024", "-e", "log(code - 512)"]),
+	("ADC resolution 65536 computed by chunks", ["-a", "65536", "-M", "5M", "-k", "K"]),
+]
+
+def RunProgram(Program_Path, Arguments):
+	return subprocess.run([Program_Path] + Arguments, capture_output=True, check=True).stdout
+
+def ReadBinaryValues(Program_Path, Arguments, ADC_Resolution):
+	"""Get the exact voltages, resistances and temperatures with the -b option."""
+	Output = RunProgram(Program_Path, Arguments + ["-b", "-"])
+	return struct.unpack("=%dd" % (3 * ADC_Resolution), Output[-24 * ADC_Resolution:])
+
+def ReadTextTables(Program_Path, Arguments):
+	"""Get the displayed detail table rows, lookup table and cold-junction compensation table."""
+	Rows = []
+	Tables = []
+	for Line in RunProgram(Program_Path, Arguments).decode().splitlines():
+		Fields = Line.split()
+		if Line.startswith("ADC lookup table") or Line.startswith("Type "):
+			Tables.append([])
+		elif Tables and Fields:
+			Tables[-1] += [int(Field) for Field in Line.replace(",", " ").split()]
+		elif (len(Fields) == 4) and Fields[0].isdigit():
+			Rows.append([int(Fields[0])] + [float(Field) for Field in Fields[1:]])
+	return Rows, Tables[0], Tables[1] if len(Tables) > 1 else None
+
+def IsSameNumber(JSON_Number, Value):
+	"""The JSON numbers must parse back to the exact double values, the non-finite values are written as null."""
+	if not math.isfinite(Value): return JSON_Number is None
+	return (JSON_Number is not None) and (float(JSON_Number) == Value)
+
+def IsSameAsText(Number, Text_Number):
+	"""The text table displays 6 decimals."""
+	if Number is None: return not math.isfinite(Text_Number)
+	return abs(Number - Text_Number) <= 5e-7 * max(1., abs(Number))
+
+def CheckRows(Rows, Binary_Values, Text_Rows):
+	if len(Rows) != len(Text_Rows): return False
+	for i, Row in enumerate(Rows):
+		if Row[0] != i: return False
+		for j in range(3):
+			if not IsSameNumber(Row[j + 1], Binary_Values[3 * i + j]): return False
+			if not IsSameAsText(Row[j + 1], Text_Rows[i][j + 1]): return False
+	return True
+
+def TestJSON(Program_Path, Arguments, Binary_Values, Text_Rows, Text_Lookup_Table, Text_Compensation_Table):
+	Document = json.loads(RunProgram(Program_Path, Arguments + ["-J", "json"]))
+	if not CheckRows(Document["rows"], Binary_Values, Text_Rows): return False
+	if Document["lookup_table"] != Text_Lookup_Table: return False
+	return Document.get("cold_junction_compensation_table") == Text_Compensation_Table
+
+def TestNDJSON(Program_Path, Arguments, Binary_Values, Text_Rows, Text_Lookup_Table, Text_Compensation_Table):
+	Lines = [json.loads(Line) for Line in RunProgram(Program_Path, Arguments + ["-J", "ndjson"]).splitlines()]
+	if "parameters" not in Lines[0]: return False
+	Objects = Lines[1:]
+	Rows = [[Object["adc_value"], Object["thermistor_voltage"], Object["thermistor_resistance"], Object["thermistor_temperature"]] for Object in Objects]
+	if not CheckRows(Rows, Binary_Values, Text_Rows): return False
+	if [Object["lookup_table_temperature"] for Object in Objects] != Text_Lookup_Table: return False
+	if Text_Compensation_Table is None: return all("cold_junction_compensation" not in Object for Object in Objects)
+	return [Object.get("cold_junction_compensation") for Object in Objects] == Text_Compensation_Table
+
+if len(sys.argv) != 2:
+	print("Usage : %s thermistor_calculator_program_path" % sys.argv[0])
+	sys.exit(1)
+
+Is_Passed = True
+for Description, Arguments in Tests:
+	ADC_Resolution = int(Arguments[Arguments.index("-a") + 1])
+	Binary_Values = ReadBinaryValues(sys.argv[1], Arguments, ADC_Resolution)
+	Text_Rows, Text_Lookup_Table, Text_Compensation_Table = ReadTextTables(sys.argv[1], Arguments)
+	for Format, Test in (("JSON", TestJSON), ("NDJSON", TestNDJSON)):
+		Result = Test(sys.argv[1], Arguments, Binary_Values, Text_Rows, Text_Lookup_Table, Text_Compensation_Table)
+		print("%s (%s) : %s." % (Description, Format, "OK" if Result else "FAILED"))
+		if not Result: Is_Passed = False
+
+if not Is_Passed: sys.exit(1)
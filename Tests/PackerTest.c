@@ -0,0 +1,167 @@
+/** @file PackerTest.c
+ * Make sure that the Packer.c SSE4.1 kernel packs exactly the same integers as the portable kernel, for ties, non-finite numbers and the saturation bounds, with all rounding modes.
+ * @author Adrien RICCIARDI
+ */
+#include <fenv.h>
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Include the module source to reach its private kernels
+#include "../Packer.c"
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** The longest array to pack, it is not a multiple of the SIMD kernel numbers per iteration so the scalar tail is also tested. */
+#define PACKER_TEST_MAXIMUM_NUMBERS_COUNT 1021
+
+/** The biggest stride to test. */
+#define PACKER_TEST_MAXIMUM_STRIDE 3
+
+/** How many guard bytes follow the packed integers, to detect the writes past the array end. */
+#define PACKER_TEST_GUARD_BYTES_COUNT 32
+
+/** The guard bytes value. */
+#define PACKER_TEST_GUARD_BYTE 0xA5
+
+//-------------------------------------------------------------------------------------------------
+// Private variables
+//-------------------------------------------------------------------------------------------------
+/** The numbers that are the most likely to be packed differently : ties, integers and their neighbors around each width bounds, non-finite numbers and signed zeros. */
+static const double Packer_Test_Special_Numbers[] =
+{
+	0., -0., 0.5, -0.5, 1.5, -1.5, 2.5, -2.5, 0.49999999999999994, -0.49999999999999994, DBL_MIN, -DBL_MIN, DBL_TRUE_MIN, -DBL_TRUE_MIN,
+	126.5, 127., 127.5, 128., 128.5, -127.5, -128., -128.5, -129., -129.5,
+	32766.5, 32767., 32767.5, 32768., 32768.5, -32767.5, -32768., -32768.5, -32769., -32769.5,
+	2147483646.5, 2147483647., 2147483647.5, 2147483648., 2147483648.5, -2147483647.5, -2147483648., -2147483648.5, -2147483649., -2147483649.5,
+	4503599627370495.5, 4503599627370496., 1e300, -1e300, DBL_MAX, -DBL_MAX, INFINITY, -INFINITY, NAN, -NAN
+};
+
+/** The rounding modes to pack with. */
+static const int Packer_Test_Rounding_Modes[] = { FE_TONEAREST, FE_UPWARD, FE_DOWNWARD, FE_TOWARDZERO };
+
+/** The rounding modes names, in the same order. */
+static const char *Packer_Test_Rounding_Mode_Names[] = { "to nearest", "upward", "downward", "toward zero" };
+
+/** The numbers to pack, with room for the biggest stride. */
+static double Packer_Test_Numbers[PACKER_TEST_MAXIMUM_NUMBERS_COUNT * PACKER_TEST_MAXIMUM_STRIDE];
+
+/** The portable kernel packed integers. */
+static unsigned char Packer_Test_Scalar_Integers[PACKER_TEST_MAXIMUM_NUMBERS_COUNT * sizeof(int) + PACKER_TEST_GUARD_BYTES_COUNT];
+
+/** The SSE4.1 kernel packed integers. */
+static unsigned char Packer_Test_SIMD_Integers[PACKER_TEST_MAXIMUM_NUMBERS_COUNT * sizeof(int) + PACKER_TEST_GUARD_BYTES_COUNT];
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Fill the numbers array with all special numbers at every position of a SIMD kernel iteration, then with random numbers spanning all widths ranges.
+ * @param Seed The random numbers seed.
+ */
+static void PackerTestGenerateNumbers(unsigned int Seed)
+{
+	unsigned int i, Special_Numbers_Count = sizeof(Packer_Test_Special_Numbers) / sizeof(Packer_Test_Special_Numbers[0]);
+	double Scale;
+	
+	srand(Seed);
+	for (i = 0; i < sizeof(Packer_Test_Numbers) / sizeof(Packer_Test_Numbers[0]); i++)
+	{
+		// Shift the special numbers by one position on each pass so each of them goes through every lane
+		if (i < 9 * Special_Numbers_Count) Packer_Test_Numbers[i] = Packer_Test_Special_Numbers[(i + i / Special_Numbers_Count) % Special_Numbers_Count];
+		else
+		{
+			// Use ties half of the time, and all magnitudes up to above the 32-bit range
+			Scale = ldexp(1., rand() % 34);
+			Packer_Test_Numbers[i] = floor(((double) rand() / RAND_MAX - 0.5) * Scale);
+			if (rand() % 2) Packer_Test_Numbers[i] += 0.5;
+			else Packer_Test_Numbers[i] += (double) rand() / RAND_MAX;
+		}
+	}
+}
+
+/** Pack the numbers with both kernels and compare the integers, then display the result.
+ * @param Rounding_Mode_Index The rounding mode to pack with, as an index in the rounding modes array.
+ * @param Width The packed integers size.
+ * @param Stride How many doubles are between two consecutive numbers.
+ * @return 0 if all integers are the same and no kernel wrote past the array end,
+ * @return -1 if the kernels differ.
+ */
+static int PackerTestCompare(unsigned int Rounding_Mode_Index, TPackerWidth Width, unsigned int Stride)
+{
+	unsigned int Count, i;
+	size_t Size;
+	
+	printf("Rounding %s, %s, stride %u : ", Packer_Test_Rounding_Mode_Names[Rounding_Mode_Index], PackerGetTypeName(Width), Stride);
+	
+	// Pack every count to test all tail sizes
+	for (Count = 0; Count <= PACKER_TEST_MAXIMUM_NUMBERS_COUNT; Count++)
+	{
+		memset(Packer_Test_Scalar_Integers, PACKER_TEST_GUARD_BYTE, sizeof(Packer_Test_Scalar_Integers));
+		memset(Packer_Test_SIMD_Integers, PACKER_TEST_GUARD_BYTE, sizeof(Packer_Test_SIMD_Integers));
+		
+		fesetround(Packer_Test_Rounding_Modes[Rounding_Mode_Index]);
+		PackerRoundAndPackScalar(Packer_Test_Numbers, Stride, Count, Width, Packer_Test_Scalar_Integers);
+		PackerRoundAndPackSSE41(Packer_Test_Numbers, Stride, Count, Width, Packer_Test_SIMD_Integers);
+		fesetround(FE_TONEAREST);
+		
+		Size = (size_t) Count * Width;
+		if (memcmp(Packer_Test_Scalar_Integers, Packer_Test_SIMD_Integers, Size) != 0)
+		{
+			for (i = 0; memcmp(Packer_Test_Scalar_Integers + (size_t) i * Width, Packer_Test_SIMD_Integers + (size_t) i * Width, Width) == 0; i++);
+			printf("FAILED, number %.17g (index %u of %u) is packed differently.\n", Packer_Test_Numbers[i * Stride], i, Count);
+			return -1;
+		}
+		for (i = 0; i < PACKER_TEST_GUARD_BYTES_COUNT; i++)
+		{
+			if ((Packer_Test_Scalar_Integers[Size + i] != PACKER_TEST_GUARD_BYTE) || (Packer_Test_SIMD_Integers[Size + i] != PACKER_TEST_GUARD_BYTE))
+			{
+				printf("FAILED, %u numbers are packed past the array end.\n", Count);
+				return -1;
+			}
+		}
+	}
+	
+	printf("OK.\n");
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Entry point
+//-------------------------------------------------------------------------------------------------
+int main(void)
+{
+	unsigned int i, Stride;
+	int Result = 0;
+	TPackerWidth Width;
+	
+	#if PACKER_IS_SIMD_KERNEL_AVAILABLE
+		if (!__builtin_cpu_supports("sse4.1"))
+		{
+			printf("The processor does not support SSE4.1, there is nothing to compare.\n");
+			return EXIT_SUCCESS;
+		}
+		
+		PackerTestGenerateNumbers(1);
+		for (i = 0; i < sizeof(Packer_Test_Rounding_Modes) / sizeof(Packer_Test_Rounding_Modes[0]); i++)
+		{
+			for (Width = PACKER_WIDTH_8_BITS; Width <= PACKER_WIDTH_32_BITS; Width *= 2)
+			{
+				for (Stride = 1; Stride <= PACKER_TEST_MAXIMUM_STRIDE; Stride++)
+				{
+					if (PackerTestCompare(i, Width, Stride) != 0) Result = -1;
+				}
+			}
+		}
+	#else
+		(void) i;
+		(void) Stride;
+		(void) Width;
+		printf("There is no SIMD kernel on this processor architecture, there is nothing to compare.\n");
+	#endif
+	
+	if (Result != 0) return EXIT_FAILURE;
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,61 @@
+/** @file ProgramTable.c
+ * See ProgramTable.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <stdio.h>
+#include <string.h>
+#include "ProgramTable.h"
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** The longest allowed command or output line. */
+#define PROGRAM_TABLE_MAXIMUM_STRING_LENGTH 4096
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int ProgramTableRead(const char *Pointer_String_Program_Path, const TProgramTableConfiguration *Pointer_Configuration, int *Pointer_Table)
+{
+	char String_Command[PROGRAM_TABLE_MAXIMUM_STRING_LENGTH], String_Line[PROGRAM_TABLE_MAXIMUM_STRING_LENGTH];
+	FILE *Pointer_Pipe;
+	unsigned int i;
+	int Is_Table_Found = 0, Result = 0;
+	
+	// Give the exact parameters values to the program
+	snprintf(String_Command, sizeof(String_Command), "'%s' -c %d -B %.17g -R %.17g -r %.17g -v %.17g -a %u", Pointer_String_Program_Path, Pointer_Configuration->Circuit_Variant, Pointer_Configuration->Thermistor_Beta_Coefficient, Pointer_Configuration->Thermistor_Reference_Resistance, Pointer_Configuration->Voltage_Divider_Resistor, Pointer_Configuration->Voltage_Divider_Bridge_Voltage, Pointer_Configuration->ADC_Resolution);
+	Pointer_Pipe = popen(String_Command, "r");
+	if (Pointer_Pipe == NULL) return -1;
+	
+	// The lookup table is displayed after the detail table
+	while (fgets(String_Line, sizeof(String_Line), Pointer_Pipe) != NULL)
+	{
+		if (strcmp(String_Line, "ADC lookup table :\n") == 0)
+		{
+			Is_Table_Found = 1;
+			break;
+		}
+	}
+	if (!Is_Table_Found) Result = -1;
+	else
+	{
+		for (i = 0; i < Pointer_Configuration->ADC_Resolution; i++)
+		{
+			if (fscanf(Pointer_Pipe, "%d,", &Pointer_Table[i]) != 1)
+			{
+				Result = -1;
+				break;
+			}
+		}
+	}
+	
+	// Read the whole output, so the program is not killed by a broken pipe
+	while (fgets(String_Line, sizeof(String_Line), Pointer_Pipe) != NULL);
+	if (pclose(Pointer_Pipe) != 0) Result = -1;
+	return Result;
+}
+
+void ProgramTableDisplayConfiguration(const TProgramTableConfiguration *Pointer_Configuration)
+{
+	printf("-c %d -B %g -R %g -r %g -v %g -a %u", Pointer_Configuration->Circuit_Variant, Pointer_Configuration->Thermistor_Beta_Coefficient, Pointer_Configuration->Thermistor_Reference_Resistance, Pointer_Configuration->Voltage_Divider_Resistor, Pointer_Configuration->Voltage_Divider_Bridge_Voltage, Pointer_Configuration->ADC_Resolution);
+}
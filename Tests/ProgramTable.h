@@ -0,0 +1,40 @@
+/** @file ProgramTable.h
+ * Run the thermistor calculator program and read its "ADC lookup table" output, so the tests can compare other table generators to it.
+ * This code is valid C and C++, so both kinds of tests can use it.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_PROGRAM_TABLE_H
+#define H_PROGRAM_TABLE_H
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A circuit configuration, with the same meaning as the program options. */
+typedef struct
+{
+	int Circuit_Variant; //!< The circuit variant (1 or 2).
+	double Thermistor_Beta_Coefficient; //!< Beta coefficient value (kelvin).
+	double Thermistor_Reference_Resistance; //!< Thermistor R25 resistor value (ohms).
+	double Voltage_Divider_Resistor; //!< The bridge resistor value (ohms).
+	double Voltage_Divider_Bridge_Voltage; //!< Vcc voltage (volts).
+	unsigned int ADC_Resolution; //!< How many entries the table has.
+} TProgramTableConfiguration;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Run the program with a configuration and read the lookup table it displays.
+ * @param Pointer_String_Program_Path The thermistor calculator program path.
+ * @param Pointer_Configuration The configuration.
+ * @param Pointer_Table On output, contain the table. It must have room for the configuration ADC resolution values.
+ * @return 0 on success,
+ * @return -1 if the program could not be run or if its output could not be parsed.
+ */
+int ProgramTableRead(const char *Pointer_String_Program_Path, const TProgramTableConfiguration *Pointer_Configuration, int *Pointer_Table);
+
+/** Display a configuration as the program options on the standard output (without new line character).
+ * @param Pointer_Configuration The configuration.
+ */
+void ProgramTableDisplayConfiguration(const TProgramTableConfiguration *Pointer_Configuration);
+
+#endif
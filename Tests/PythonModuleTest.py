@@ -0,0 +1,101 @@
+"""Make sure that the thermistor_calculator Python module values are bit-identical to the program ones, and that its sweep and Monte Carlo modes work.
+@author Adrien RICCIARDI
+"""
+import array
+import struct
+import subprocess
+import sys
+import threading
+
+import thermistor_calculator
+
+# Each configuration is (circuit variant, beta, R25, voltage divider resistor, Vcc, ADC resolution)
+Configurations = [
+	(1, 4300., 10000., 10000., 3.3, 256),
+	(2, 3988., 10000., 10000., 3.3, 1024),
+	(1, 3950., 100000., 47000., 5., 4096),
+	(2, 3435., 10000., 4700., 3.3, 65536),
+]
+
+def ReadProgramValues(Program_Path, Configuration):
+	"""Get the voltages, resistances and temperatures computed by the program -b option."""
+	Circuit_Variant, Beta, R25, Resistor, Vcc, ADC_Resolution = Configuration
+	Arguments = [Program_Path, "-c", str(Circuit_Variant), "-B", repr(Beta), "-R", repr(R25), "-r", repr(Resistor), "-v", repr(Vcc), "-a", str(ADC_Resolution), "-b", "-"]
+	Output = subprocess.run(Arguments, capture_output=True, check=True).stdout
+	Values = struct.unpack("=%dd" % (3 * ADC_Resolution), Output[-24 * ADC_Resolution:])
+	return Values[0::3], Values[1::3], Values[2::3]
+
+def AreIdentical(First_Values, Second_Values):
+	"""Compare the values bit to bit, so NaN values are identical too."""
+	return struct.pack("=%dd" % len(First_Values), *First_Values) == struct.pack("=%dd" % len(Second_Values), *Second_Values)
+
+def TestTable(Program_Path, Configuration):
+	Circuit_Variant, Beta, R25, Resistor, Vcc, ADC_Resolution = Configuration
+	Voltages = array.array("d", bytes(8 * ADC_Resolution))
+	Resistances = array.array("d", bytes(8 * ADC_Resolution))
+	Temperatures = array.array("d", bytes(8 * ADC_Resolution))
+	thermistor_calculator.table(Temperatures, Voltages, Resistances, circuit=Circuit_Variant, beta=Beta, r25=R25, resistor=Resistor, vcc=Vcc)
+
+	Program_Voltages, Program_Resistances, Program_Temperatures = ReadProgramValues(Program_Path, Configuration)
+	return AreIdentical(Voltages, Program_Voltages) and AreIdentical(Resistances, Program_Resistances) and AreIdentical(Temperatures, Program_Temperatures)
+
+def TestSweep(Program_Path):
+	Betas = array.array("d", [3435., 3950., 3988., 4300.])
+	Temperatures = array.array("d", bytes(8 * 1024 * len(Betas)))
+	thermistor_calculator.sweep("beta", Betas, Temperatures, circuit=2, r25=10000., resistor=4700., vcc=5.)
+
+	for i, Beta in enumerate(Betas):
+		_, _, Program_Temperatures = ReadProgramValues(Program_Path, (2, Beta, 10000., 4700., 5., 1024))
+		if not AreIdentical(Temperatures[i * 1024:(i + 1) * 1024], Program_Temperatures): return False
+	return True
+
+def TestMonteCarlo():
+	# The same seed must give the same errors, even when several threads compute at the same time (the computations do not hold the GIL)
+	Errors = [array.array("d", bytes(8 * 20000)) for i in range(4)]
+	Threads = [threading.Thread(target=thermistor_calculator.monte_carlo, args=(Errors[i], 0., 50.), kwargs={"beta_tolerance": 1., "r25_tolerance": 5., "resistor_tolerance": 5., "seed": 1234}) for i in range(4)]
+	for Thread in Threads: Thread.start()
+	for Thread in Threads: Thread.join()
+	if any(Errors[i] != Errors[0] for i in range(1, 4)): return False
+
+	# The errors are strictly positive with toleranced parts
+	if min(Errors[0]) <= 0: return False
+
+	# Perfect parts only give the table rounding error
+	Exact_Errors = array.array("d", bytes(8 * 100))
+	thermistor_calculator.monte_carlo(Exact_Errors, 0., 50., beta_tolerance=0., r25_tolerance=0., resistor_tolerance=0.)
+	return max(Exact_Errors) <= 0.5
+
+def TestErrors():
+	# Wrong arrays and parameters must raise exceptions instead of corrupting memory
+	Tests = [
+		lambda: thermistor_calculator.table(array.array("f", bytes(4 * 256))),
+		lambda: thermistor_calculator.table(bytes(8 * 256)),
+		lambda: thermistor_calculator.table(array.array("d", bytes(8 * 256)), array.array("d", bytes(8 * 128))),
+		lambda: thermistor_calculator.table(array.array("d", bytes(8 * 256)), circuit=3),
+		lambda: thermistor_calculator.sweep("gain", array.array("d", [1.]), array.array("d", bytes(8 * 256))),
+		lambda: thermistor_calculator.sweep("beta", array.array("d", [1., 2., 3.]), array.array("d", bytes(8 * 256))),
+		lambda: thermistor_calculator.monte_carlo(array.array("d", bytes(8 * 10)), 50., 0.),
+		lambda: thermistor_calculator.monte_carlo(array.array("d", bytes(8 * 10)), 1000., 2000.),
+	]
+	for Test in Tests:
+		try:
+			Test()
+			return False
+		except (TypeError, ValueError, BufferError):
+			pass
+	return True
+
+if len(sys.argv) != 2:
+	print("Usage : %s thermistor_calculator_program_path" % sys.argv[0])
+	sys.exit(1)
+
+Results = []
+for Configuration in Configurations:
+	Results.append(("Circuit %d, beta %g, R25 %g, resistor %g, Vcc %g, ADC resolution %d (table)" % Configuration, TestTable(sys.argv[1], Configuration)))
+Results.append(("Beta sweep", TestSweep(sys.argv[1])))
+Results.append(("Monte Carlo", TestMonteCarlo()))
+Results.append(("Wrong arguments", TestErrors()))
+
+for Description, Is_Passed in Results:
+	print("%s : %s." % (Description, "OK" if Is_Passed else "FAILED"))
+if not all(Is_Passed for _, Is_Passed in Results): sys.exit(1)
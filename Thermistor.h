@@ -0,0 +1,66 @@
+/** @file Thermistor.h
+ * The thermistor and voltage divider model shared by the program and the Python module, so both compute the exact same values.
+ * The functions are defined here so the compilers can inline them in the computation loops.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_THERMISTOR_H
+#define H_THERMISTOR_H
+
+#include <math.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** Kelvin temperature corresponding to 0 Celsius degree. */
+#define THERMISTOR_KELVIN_OFFSET 273.15
+/** Thermistor reference temperature (Celsius), this is the temperature the R25 resistance is given at. */
+#define THERMISTOR_REFERENCE_TEMPERATURE 25.
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Compute the voltage divider output voltage corresponding to an ADC value.
+ * @param Voltage_Divider_Bridge_Voltage Vcc voltage in volts.
+ * @param ADC_Resolution The ADC resolution (corresponding to the amount of ADC steps). For instance, set 256 for a 8-bit ADC.
+ * @param ADC_Value The ADC value (in range [0; ADC_resolution-1]).
+ * @return The corresponding voltage in volts.
+ */
+static inline double ThermistorComputeVoltageDividerOutputVoltage(double Voltage_Divider_Bridge_Voltage, unsigned int ADC_Resolution, unsigned int ADC_Value)
+{
+	return Voltage_Divider_Bridge_Voltage * ADC_Value / (ADC_Resolution - 1); // Subtract 1 to resolution because the maximum reachable ADC value is resolution-1
+}
+
+/** Compute the thermistor resistance corresponding to a specific voltage divider output voltage.
+ * @param Circuit_Variant The selected circuit variant (must be 1 or 2).
+ * @param Voltage_Divider_Bridge_Voltage Vcc voltage in volts.
+ * @param Voltage_Divider_Output_Voltage The voltage divider output voltage to get corresponding thermistor resistance (volts).
+ * @param Voltage_Divider_Resistor The bridge resistor value in ohms.
+ * @return The corresponding thermistor resistance (ohms).
+ */
+static inline double ThermistorComputeResistance(int Circuit_Variant, double Voltage_Divider_Bridge_Voltage, double Voltage_Divider_Output_Voltage, double Voltage_Divider_Resistor)
+{
+	double Result;
+	
+	// Compute voltage divider second resistance value
+	if (Circuit_Variant == 1) Result = Voltage_Divider_Output_Voltage * Voltage_Divider_Resistor / (Voltage_Divider_Bridge_Voltage - Voltage_Divider_Output_Voltage);
+	// Compute voltage divider first resistance value
+	else Result = (Voltage_Divider_Bridge_Voltage * Voltage_Divider_Resistor / Voltage_Divider_Output_Voltage) - Voltage_Divider_Resistor;
+	
+	return Result;
+}
+
+/** Determine the thermistor Celsius temperature for a given thermistor resistance.
+ * @param Thermistor_Beta_Coefficient Beta coefficient value.
+ * @param Thermistor_Reference_Resistance Thermistor R25 resistor value (ohms).
+ * @param Thermistor_Resistance The resistance to get temperature from (ohms).
+ * @return The corresponding temperature (Celsius).
+ */
+static inline double ThermistorComputeTemperature(double Thermistor_Beta_Coefficient, double Thermistor_Reference_Resistance, double Thermistor_Resistance)
+{
+	double Kelvin_Result;
+	
+	Kelvin_Result = 1. / ((log(Thermistor_Resistance / Thermistor_Reference_Resistance) / Thermistor_Beta_Coefficient) + (1. / (THERMISTOR_KELVIN_OFFSET + THERMISTOR_REFERENCE_TEMPERATURE)));
+	return Kelvin_Result - THERMISTOR_KELVIN_OFFSET;
+}
+
+#endif
@@ -0,0 +1,166 @@
+/** @file ThermistorCalculator.hpp
+ * Header-only C++ companion of the thermistor calculator, generating the ADC lookup tables at compile time.
+ * The functions mirror the program ones and produce the same integer tables as the program "ADC lookup table" output.
+ * Include this file from C++17 code to use the constexpr functions, C++20 is needed for the Lookup_Table variable template (it uses floating template parameters).
+ * @author Adrien RICCIARDI
+ */
+#ifndef HPP_THERMISTOR_CALCULATOR_HPP
+#define HPP_THERMISTOR_CALCULATOR_HPP
+
+#include <array>
+#include <limits>
+
+namespace ThermistorCalculator
+{
+	//-------------------------------------------------------------------------------------------------
+	// Constants
+	//-------------------------------------------------------------------------------------------------
+	/** Kelvin temperature corresponding to 0 Celsius degree. */
+	constexpr double KELVIN_OFFSET = 273.15;
+	/** Thermistor reference temperature (Celsius), this is the temperature the R25 resistance is given at. */
+	constexpr double THERMISTOR_REFERENCE_TEMPERATURE = 25.;
+	
+	//-------------------------------------------------------------------------------------------------
+	// Functions
+	//-------------------------------------------------------------------------------------------------
+	/** Compute the natural logarithm at compile time (std::log() is not constexpr).
+	 * The value is split into a power of 2 and a mantissa in range [sqrt(2)/2; sqrt(2)[, whose logarithm is computed with the fast-converging 2 * atanh((x - 1) / (x + 1)) series.
+	 * @param Value The value to compute logarithm of.
+	 * @return The natural logarithm, -infinity for 0 and +infinity for +infinity (like std::log()).
+	 */
+	constexpr double Log(double Value)
+	{
+		constexpr double Logarithm_Of_2 = 0.693147180559945309417232121458176568;
+		constexpr double Square_Root_Of_2 = 1.41421356237309504880168872420969808;
+		int Exponent = 0;
+		double Ratio = 0, Squared_Ratio = 0, Term = 0, Sum = 0, Previous_Sum = -1;
+		
+		if (Value != Value) return Value; // NaN
+		if (Value < 0) return std::numeric_limits<double>::quiet_NaN();
+		if (Value == 0) return -std::numeric_limits<double>::infinity();
+		if (Value == std::numeric_limits<double>::infinity()) return Value;
+		
+		// Scaling by powers of 2 is exact
+		while (Value >= Square_Root_Of_2)
+		{
+			Value /= 2.;
+			Exponent++;
+		}
+		while (Value < Square_Root_Of_2 / 2.)
+		{
+			Value *= 2.;
+			Exponent--;
+		}
+		
+		Ratio = (Value - 1.) / (Value + 1.);
+		Squared_Ratio = Ratio * Ratio;
+		Term = Ratio;
+		for (int i = 1; Sum != Previous_Sum; i += 2)
+		{
+			Previous_Sum = Sum;
+			Sum += Term / i;
+			Term *= Squared_Ratio;
+		}
+		
+		return 2. * Sum + Exponent * Logarithm_Of_2;
+	}
+	
+	/** Round to the nearest integer, halfway values being rounded to the nearest even integer (like lrint() with the default rounding mode).
+	 * @param Value The value to round, it must fit in an int.
+	 * @return The rounded value.
+	 */
+	constexpr int RoundToNearestInteger(double Value)
+	{
+		int Truncated_Value = static_cast<int>(Value);
+		double Remainder = Value - Truncated_Value;
+		
+		if (Remainder > 0.5) return Truncated_Value + 1;
+		if (Remainder < -0.5) return Truncated_Value - 1;
+		if (Remainder == 0.5) return (Truncated_Value % 2 == 0) ? Truncated_Value : Truncated_Value + 1;
+		if (Remainder == -0.5) return (Truncated_Value % 2 == 0) ? Truncated_Value : Truncated_Value - 1;
+		return Truncated_Value;
+	}
+	
+	/** Divide two numbers, giving the IEEE 754 result when dividing by zero (dividing by zero is not allowed in constant expressions).
+	 * @param Dividend The dividend.
+	 * @param Divisor The divisor.
+	 * @return The quotient.
+	 */
+	constexpr double Divide(double Dividend, double Divisor)
+	{
+		if (Divisor == 0)
+		{
+			if (Dividend == 0) return std::numeric_limits<double>::quiet_NaN();
+			return (Dividend > 0) ? std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity();
+		}
+		return Dividend / Divisor;
+	}
+	
+	/** Compute the voltage divider output voltage corresponding to an ADC value.
+	 * @param Voltage_Divider_Bridge_Voltage Vcc voltage in volts.
+	 * @param ADC_Resolution The ADC resolution (corresponding to the amount of ADC steps). For instance, set 256 for a 8-bit ADC.
+	 * @param ADC_Value The ADC value (in range [0; ADC_resolution-1]).
+	 * @return The corresponding voltage in volts.
+	 */
+	constexpr double ComputeVoltageDividerOutputVoltage(double Voltage_Divider_Bridge_Voltage, unsigned int ADC_Resolution, unsigned int ADC_Value)
+	{
+		return Voltage_Divider_Bridge_Voltage * ADC_Value / (ADC_Resolution - 1);
+	}
+	
+	/** Compute the thermistor resistance corresponding to a specific voltage divider output voltage.
+	 * @param Circuit_Variant The selected circuit variant (must be 1 or 2).
+	 * @param Voltage_Divider_Bridge_Voltage Vcc voltage in volts.
+	 * @param Voltage_Divider_Output_Voltage The voltage divider output voltage to get corresponding thermistor resistance (volts).
+	 * @param Voltage_Divider_Resistor The bridge resistor value in ohms.
+	 * @return The corresponding thermistor resistance (ohms).
+	 */
+	constexpr double ComputeThermistorResistance(int Circuit_Variant, double Voltage_Divider_Bridge_Voltage, double Voltage_Divider_Output_Voltage, double Voltage_Divider_Resistor)
+	{
+		if (Circuit_Variant == 1) return Divide(Voltage_Divider_Output_Voltage * Voltage_Divider_Resistor, Voltage_Divider_Bridge_Voltage - Voltage_Divider_Output_Voltage);
+		return Divide(Voltage_Divider_Bridge_Voltage * Voltage_Divider_Resistor, Voltage_Divider_Output_Voltage) - Voltage_Divider_Resistor;
+	}
+	
+	/** Determine the thermistor Celsius temperature for a given thermistor resistance.
+	 * @param Thermistor_Beta_Coefficient Beta coefficient value.
+	 * @param Thermistor_Reference_Resistance Thermistor R25 resistor value (ohms).
+	 * @param Thermistor_Resistance The resistance to get temperature from (ohms).
+	 * @return The corresponding temperature (Celsius).
+	 */
+	constexpr double ComputeThermistorTemperature(double Thermistor_Beta_Coefficient, double Thermistor_Reference_Resistance, double Thermistor_Resistance)
+	{
+		double Kelvin_Result = Divide(1., (Log(Thermistor_Resistance / Thermistor_Reference_Resistance) / Thermistor_Beta_Coefficient) + (1. / (KELVIN_OFFSET + THERMISTOR_REFERENCE_TEMPERATURE)));
+		return Kelvin_Result - KELVIN_OFFSET;
+	}
+	
+	/** Compute the ADC lookup table (the same table as the program "ADC lookup table" output).
+	 * @param Circuit_Variant The selected circuit variant (must be 1 or 2).
+	 * @param Thermistor_Beta_Coefficient Beta coefficient value.
+	 * @param Thermistor_Reference_Resistance Thermistor R25 resistor value (ohms).
+	 * @param Voltage_Divider_Resistor The bridge resistor value in ohms.
+	 * @param Voltage_Divider_Bridge_Voltage Vcc voltage in volts.
+	 * @return The rounded temperature corresponding to each ADC value (Celsius).
+	 */
+	template <unsigned int ADC_Resolution>
+	constexpr std::array<int, ADC_Resolution> GenerateLookupTable(int Circuit_Variant, double Thermistor_Beta_Coefficient, double Thermistor_Reference_Resistance, double Voltage_Divider_Resistor, double Voltage_Divider_Bridge_Voltage)
+	{
+		static_assert(ADC_Resolution >= 2, "The ADC resolution must be at least 2.");
+		std::array<int, ADC_Resolution> Table{};
+		double Voltage = 0, Resistance = 0;
+		
+		for (unsigned int i = 0; i < ADC_Resolution; i++)
+		{
+			Voltage = ComputeVoltageDividerOutputVoltage(Voltage_Divider_Bridge_Voltage, ADC_Resolution, i);
+			Resistance = ComputeThermistorResistance(Circuit_Variant, Voltage_Divider_Bridge_Voltage, Voltage, Voltage_Divider_Resistor);
+			Table[i] = RoundToNearestInteger(ComputeThermistorTemperature(Thermistor_Beta_Coefficient, Thermistor_Reference_Resistance, Resistance));
+		}
+		return Table;
+	}
+	
+#if __cplusplus >= 202002L
+	/** The ADC lookup table of a configuration, computed at compile time. For instance, ThermistorCalculator::Lookup_Table<256, 2, 3988., 10000., 10000., 3.3> matches "thermistor-calculator -c 2 -B 3988 -R 10000 -r 10000 -v 3.3 -a 256" output. */
+	template <unsigned int ADC_Resolution, int Circuit_Variant, double Thermistor_Beta_Coefficient, double Thermistor_Reference_Resistance, double Voltage_Divider_Resistor, double Voltage_Divider_Bridge_Voltage>
+	inline constexpr std::array<int, ADC_Resolution> Lookup_Table = GenerateLookupTable<ADC_Resolution>(Circuit_Variant, Thermistor_Beta_Coefficient, Thermistor_Reference_Resistance, Voltage_Divider_Resistor, Voltage_Divider_Bridge_Voltage);
+#endif
+}
+
+#endif
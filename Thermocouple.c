@@ -0,0 +1,137 @@
+/** @file Thermocouple.c
+ * See Thermocouple.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <math.h>
+#include "Thermocouple.h"
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** The biggest amount of coefficients of a NIST polynomial. */
+#define THERMOCOUPLE_MAXIMUM_COEFFICIENTS_COUNT 15
+
+/** How many temperatures are converted at the same time, this allows the compiler to vectorize the Horner evaluation loops. */
+#define THERMOCOUPLE_BLOCK_SIZE 64
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** A NIST polynomial valid over a temperature range. */
+typedef struct
+{
+	int Coefficients_Count; //!< How many coefficients are used.
+	double Coefficients[THERMOCOUPLE_MAXIMUM_COEFFICIENTS_COUNT]; //!< The polynomial coefficients, starting from the constant one (millivolts / Celsius^n).
+} TThermocouplePolynomial;
+
+/** The NIST ITS-90 model of a thermocouple type. */
+typedef struct
+{
+	char Letter; //!< The type letter.
+	double Minimum_Temperature; //!< The lowest temperature the model is valid for (Celsius).
+	double Maximum_Temperature; //!< The highest temperature the model is valid for (Celsius).
+	TThermocouplePolynomial Negative_Polynomial; //!< The polynomial to use for temperatures lower than 0 Celsius degree.
+	TThermocouplePolynomial Positive_Polynomial; //!< The polynomial to use for temperatures greater or equal to 0 Celsius degree.
+	double Exponential_Coefficients[3]; //!< The a0 * exp(a1 * (t - a2)^2) term added to the positive range voltage (set all coefficients to 0 when unused).
+} TThermocoupleModel;
+
+//-------------------------------------------------------------------------------------------------
+// Private variables
+//-------------------------------------------------------------------------------------------------
+/** All thermocouple models, in the same order than the TThermocoupleType enumeration. */
+static const TThermocoupleModel Thermocouple_Models[THERMOCOUPLE_TYPES_COUNT] =
+{
+	// Type K
+	{
+		'K', -270., 1372.,
+		{ 11, { 0., 0.394501280250E-01, 0.236223735980E-04, -0.328589067840E-06, -0.499048287770E-08, -0.675090591730E-10, -0.574103274280E-12, -0.310888728940E-14, -0.104516093650E-16, -0.198892668780E-19, -0.163226974860E-22 } },
+		{ 10, { -0.176004136860E-01, 0.389212049750E-01, 0.185587700320E-04, -0.994575928740E-07, 0.318409457190E-09, -0.560728448890E-12, 0.560750590590E-15, -0.320207200030E-18, 0.971511471520E-22, -0.121047212750E-25 } },
+		{ 0.118597600000E+00, -0.118343200000E-03, 0.126968600000E+03 }
+	},
+	// Type T
+	{
+		'T', -270., 400.,
+		{ 15, { 0., 0.387481063640E-01, 0.441944343470E-04, 0.118443231050E-06, 0.200329735540E-07, 0.901380195590E-09, 0.226511565930E-10, 0.360711542050E-12, 0.384939398830E-14, 0.282135219250E-16, 0.142515947790E-18, 0.487686622860E-21, 0.107955392700E-23, 0.139450270620E-26, 0.797951539270E-30 } },
+		{ 9, { 0., 0.387481063640E-01, 0.332922278800E-04, 0.206182434040E-06, -0.218822568460E-08, 0.109968809280E-10, -0.308157587720E-13, 0.454791352900E-16, -0.275129016730E-19 } },
+		{ 0., 0., 0. }
+	}
+};
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int ThermocoupleGetTypeFromLetter(char Letter, TThermocoupleType *Pointer_Type)
+{
+	int i;
+	
+	// Allow lowercase letters
+	if ((Letter >= 'a') && (Letter <= 'z')) Letter -= 'a' - 'A';
+	
+	for (i = 0; i < THERMOCOUPLE_TYPES_COUNT; i++)
+	{
+		if (Thermocouple_Models[i].Letter == Letter)
+		{
+			*Pointer_Type = (TThermocoupleType) i;
+			return 0;
+		}
+	}
+	return -1;
+}
+
+char ThermocoupleGetTypeLetter(TThermocoupleType Type)
+{
+	return Thermocouple_Models[Type].Letter;
+}
+
+void ThermocoupleComputeVoltages(TThermocoupleType Type, const double *Pointer_Temperatures, double *Pointer_Voltages, unsigned int Count)
+{
+	const TThermocoupleModel *Pointer_Model = &Thermocouple_Models[Type];
+	double Clamped_Temperatures[THERMOCOUPLE_BLOCK_SIZE], Negative_Voltages[THERMOCOUPLE_BLOCK_SIZE], Positive_Voltages[THERMOCOUPLE_BLOCK_SIZE], Temperature, Difference;
+	unsigned int Block_Size, i;
+	int j;
+	
+	while (Count > 0)
+	{
+		Block_Size = Count < THERMOCOUPLE_BLOCK_SIZE ? Count : THERMOCOUPLE_BLOCK_SIZE;
+		
+		// Keep the temperatures in the model range
+		for (i = 0; i < Block_Size; i++)
+		{
+			Temperature = Pointer_Temperatures[i];
+			if (!(Temperature >= Pointer_Model->Minimum_Temperature)) Temperature = Pointer_Model->Minimum_Temperature; // Also catch NaN values
+			else if (Temperature > Pointer_Model->Maximum_Temperature) Temperature = Pointer_Model->Maximum_Temperature;
+			Clamped_Temperatures[i] = Temperature;
+		}
+		
+		// Evaluate both polynomials on the whole block with the Horner scheme, the coefficient loop is the outer one so the inner loop can be vectorized
+		for (i = 0; i < Block_Size; i++)
+		{
+			Negative_Voltages[i] = Pointer_Model->Negative_Polynomial.Coefficients[Pointer_Model->Negative_Polynomial.Coefficients_Count - 1];
+			Positive_Voltages[i] = Pointer_Model->Positive_Polynomial.Coefficients[Pointer_Model->Positive_Polynomial.Coefficients_Count - 1];
+		}
+		for (j = Pointer_Model->Negative_Polynomial.Coefficients_Count - 2; j >= 0; j--)
+		{
+			for (i = 0; i < Block_Size; i++) Negative_Voltages[i] = Negative_Voltages[i] * Clamped_Temperatures[i] + Pointer_Model->Negative_Polynomial.Coefficients[j];
+		}
+		for (j = Pointer_Model->Positive_Polynomial.Coefficients_Count - 2; j >= 0; j--)
+		{
+			for (i = 0; i < Block_Size; i++) Positive_Voltages[i] = Positive_Voltages[i] * Clamped_Temperatures[i] + Pointer_Model->Positive_Polynomial.Coefficients[j];
+		}
+		
+		// Select the right range result and add the exponential term if any
+		for (i = 0; i < Block_Size; i++)
+		{
+			if (Clamped_Temperatures[i] < 0) Pointer_Voltages[i] = Negative_Voltages[i];
+			else
+			{
+				Difference = Clamped_Temperatures[i] - Pointer_Model->Exponential_Coefficients[2];
+				Pointer_Voltages[i] = Positive_Voltages[i];
+				if (Pointer_Model->Exponential_Coefficients[0] != 0) Pointer_Voltages[i] += Pointer_Model->Exponential_Coefficients[0] * exp(Pointer_Model->Exponential_Coefficients[1] * Difference * Difference);
+			}
+		}
+		
+		Pointer_Temperatures += Block_Size;
+		Pointer_Voltages += Block_Size;
+		Count -= Block_Size;
+	}
+}
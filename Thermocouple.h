@@ -0,0 +1,45 @@
+/** @file Thermocouple.h
+ * Convert thermocouple junction temperatures to thermoelectric voltages using the NIST ITS-90 reference polynomials.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_THERMOCOUPLE_H
+#define H_THERMOCOUPLE_H
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** All supported thermocouple types. */
+typedef enum
+{
+	THERMOCOUPLE_TYPE_K, //!< Nickel-Chromium / Nickel-Aluminium.
+	THERMOCOUPLE_TYPE_T, //!< Copper / Copper-Nickel.
+	THERMOCOUPLE_TYPES_COUNT
+} TThermocoupleType;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Find the thermocouple type corresponding to the type letter.
+ * @param Letter The thermocouple type letter, like 'K' (lowercase letters are allowed).
+ * @param Pointer_Type On output, contain the corresponding type.
+ * @return 0 if the type was found,
+ * @return -1 if the thermocouple type is not supported.
+ */
+int ThermocoupleGetTypeFromLetter(char Letter, TThermocoupleType *Pointer_Type);
+
+/** Get the letter of a thermocouple type.
+ * @param Type The thermocouple type.
+ * @return The uppercase type letter.
+ */
+char ThermocoupleGetTypeLetter(TThermocoupleType Type);
+
+/** Compute the thermoelectric voltages corresponding to many junction temperatures (the reference junction being at 0 Celsius degree).
+ * Temperatures outside of the thermocouple type NIST range are clamped to the range limits.
+ * @param Type The thermocouple type.
+ * @param Pointer_Temperatures The junction temperatures (Celsius).
+ * @param Pointer_Voltages On output, contain the thermoelectric voltages (millivolts). This array must have room for Count values.
+ * @param Count How many temperatures to convert.
+ */
+void ThermocoupleComputeVoltages(TThermocoupleType Type, const double *Pointer_Temperatures, double *Pointer_Voltages, unsigned int Count);
+
+#endif
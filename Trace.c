@@ -0,0 +1,231 @@
+/** @file Trace.c
+ * See Trace.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "Arena.h"
+#include "Trace.h"
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** The biggest amount of ring buffers, the threads started when all are in use are not traced. */
+#define TRACE_MAXIMUM_RINGS_COUNT 512
+/** How many spans a ring buffer holds (it must be a power of two). */
+#define TRACE_RING_SPANS_COUNT 8192
+/** The longest thread name, including the terminating character. */
+#define TRACE_MAXIMUM_NAME_LENGTH 64
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** A recorded span. */
+typedef struct
+{
+	unsigned long long Start_Time; //!< The span start time (nanoseconds from the trace initialization).
+	unsigned long long End_Time; //!< The span end time (nanoseconds from the trace initialization).
+	TTraceSpan Span; //!< What the thread was doing.
+} TTraceRecord;
+
+/** The spans of a thread, or of consecutive threads of the same name. */
+typedef struct
+{
+	char String_Name[TRACE_MAXIMUM_NAME_LENGTH]; //!< The name displayed in the trace viewer.
+	char String_Group_Name[TRACE_MAXIMUM_NAME_LENGTH]; //!< The name given by the threads, without the number.
+	int Is_In_Use; //!< Set to 1 while a running thread records to this ring buffer.
+	unsigned long long Records_Count; //!< How many spans were recorded, only the last TRACE_RING_SPANS_COUNT ones are kept.
+	TTraceRecord Records[TRACE_RING_SPANS_COUNT]; //!< The ring buffer.
+} TTraceRing;
+
+//-------------------------------------------------------------------------------------------------
+// Private variables
+//-------------------------------------------------------------------------------------------------
+/** The names displayed for each span kind. */
+static const char *Trace_Pointer_Strings_Span_Names[TRACE_SPANS_COUNT] = {"compute", "format", "write", "wait"};
+
+/** Set to 1 when the trace is recording. */
+static int Trace_Is_Enabled = 0;
+/** The time origin of all spans. */
+static struct timespec Trace_Start_Time;
+
+/** The ring buffers are allocated from this arena when the threads get a name. */
+static TArena Trace_Arena;
+/** All allocated ring buffers. */
+static TTraceRing *Trace_Pointer_Rings[TRACE_MAXIMUM_RINGS_COUNT];
+/** How many ring buffers are allocated. */
+static unsigned int Trace_Rings_Count = 0;
+/** How many threads could not get a ring buffer. */
+static unsigned int Trace_Untraced_Threads_Count = 0;
+/** Protect the ring buffers allocation. */
+static pthread_mutex_t Trace_Mutex = PTHREAD_MUTEX_INITIALIZER;
+/** Give the thread ring buffer back when the thread exits. */
+static pthread_key_t Trace_Thread_Key;
+
+/** The calling thread ring buffer, NULL when the thread spans are not recorded. */
+static __thread TTraceRing *Trace_Pointer_Thread_Ring = NULL;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Called when a named thread exits, so its ring buffer can be used by the next thread of the same name.
+ * @param Pointer_Ring_Parameter The thread ring buffer.
+ */
+static void TraceReleaseRing(void *Pointer_Ring_Parameter)
+{
+	TTraceRing *Pointer_Ring = Pointer_Ring_Parameter;
+	
+	pthread_mutex_lock(&Trace_Mutex);
+	Pointer_Ring->Is_In_Use = 0;
+	pthread_mutex_unlock(&Trace_Mutex);
+}
+
+/** Allocate a ring buffer, the caller must hold the mutex.
+ * @param Pointer_String_Group_Name The name of the threads that will use this ring buffer.
+ * @return The ring buffer,
+ * @return NULL if all ring buffers are allocated.
+ */
+static TTraceRing *TraceAllocateRing(const char *Pointer_String_Group_Name)
+{
+	TTraceRing *Pointer_Ring;
+	unsigned int i, Group_Rings_Count = 0;
+	
+	if (Trace_Rings_Count >= TRACE_MAXIMUM_RINGS_COUNT) return NULL;
+	Pointer_Ring = ArenaAllocate(&Trace_Arena, sizeof(TTraceRing));
+	if (Pointer_Ring == NULL) return NULL;
+	
+	// Number the rings of the same name, so they are distinct rows in the trace viewer
+	for (i = 0; i < Trace_Rings_Count; i++)
+	{
+		if (strcmp(Trace_Pointer_Rings[i]->String_Group_Name, Pointer_String_Group_Name) == 0) Group_Rings_Count++;
+	}
+	snprintf(Pointer_Ring->String_Group_Name, sizeof(Pointer_Ring->String_Group_Name), "%s", Pointer_String_Group_Name);
+	snprintf(Pointer_Ring->String_Name, sizeof(Pointer_Ring->String_Name), "%s %u", Pointer_String_Group_Name, Group_Rings_Count + 1);
+	Pointer_Ring->Is_In_Use = 1;
+	Pointer_Ring->Records_Count = 0;
+	
+	Trace_Pointer_Rings[Trace_Rings_Count] = Pointer_Ring;
+	Trace_Rings_Count++;
+	return Pointer_Ring;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int TraceInitialize(void)
+{
+	// The ring buffers pages are touched only when the threads record spans
+	if (ArenaCreate(&Trace_Arena, (size_t) TRACE_MAXIMUM_RINGS_COUNT * (sizeof(TTraceRing) + 64)) != 0) return -1;
+	if (pthread_key_create(&Trace_Thread_Key, TraceReleaseRing) != 0)
+	{
+		ArenaDestroy(&Trace_Arena);
+		return -1;
+	}
+	
+	clock_gettime(CLOCK_MONOTONIC, &Trace_Start_Time);
+	Trace_Is_Enabled = 1;
+	
+	// The main thread is never released, so do not number it
+	pthread_mutex_lock(&Trace_Mutex);
+	Trace_Pointer_Thread_Ring = TraceAllocateRing("Main");
+	strcpy(Trace_Pointer_Thread_Ring->String_Name, "Main");
+	pthread_mutex_unlock(&Trace_Mutex);
+	return 0;
+}
+
+void TraceNameThread(const char *Pointer_String_Name)
+{
+	TTraceRing *Pointer_Ring = NULL;
+	unsigned int i;
+	
+	if (!Trace_Is_Enabled || (Trace_Pointer_Thread_Ring != NULL)) return;
+	
+	// Reuse the ring buffer of an exited thread of the same name, or get a new one
+	pthread_mutex_lock(&Trace_Mutex);
+	for (i = 0; i < Trace_Rings_Count; i++)
+	{
+		if (!Trace_Pointer_Rings[i]->Is_In_Use && (strcmp(Trace_Pointer_Rings[i]->String_Group_Name, Pointer_String_Name) == 0))
+		{
+			Pointer_Ring = Trace_Pointer_Rings[i];
+			Pointer_Ring->Is_In_Use = 1;
+			break;
+		}
+	}
+	if (Pointer_Ring == NULL)
+	{
+		Pointer_Ring = TraceAllocateRing(Pointer_String_Name);
+		if (Pointer_Ring == NULL) Trace_Untraced_Threads_Count++;
+	}
+	pthread_mutex_unlock(&Trace_Mutex);
+	
+	if (Pointer_Ring == NULL) return;
+	pthread_setspecific(Trace_Thread_Key, Pointer_Ring);
+	Trace_Pointer_Thread_Ring = Pointer_Ring;
+}
+
+unsigned long long TraceGetTime(void)
+{
+	struct timespec Time;
+	
+	if (!Trace_Is_Enabled) return 0;
+	clock_gettime(CLOCK_MONOTONIC, &Time);
+	return (unsigned long long) (Time.tv_sec - Trace_Start_Time.tv_sec) * 1000000000ULL + (unsigned long long) (Time.tv_nsec - Trace_Start_Time.tv_nsec);
+}
+
+void TraceRecordSpan(TTraceSpan Span, unsigned long long Start_Time)
+{
+	TTraceRing *Pointer_Ring = Trace_Pointer_Thread_Ring;
+	TTraceRecord *Pointer_Record;
+	
+	if (Pointer_Ring == NULL) return;
+	
+	Pointer_Record = &Pointer_Ring->Records[Pointer_Ring->Records_Count & (TRACE_RING_SPANS_COUNT - 1)];
+	Pointer_Record->Start_Time = Start_Time;
+	Pointer_Record->End_Time = TraceGetTime();
+	Pointer_Record->Span = Span;
+	Pointer_Ring->Records_Count++;
+}
+
+int TraceWrite(const char *Pointer_String_File_Name)
+{
+	FILE *Pointer_File;
+	unsigned int i;
+	unsigned long long j, First_Record_Index, Dropped_Records_Count = 0;
+	TTraceRecord *Pointer_Record;
+	int Result;
+	
+	Pointer_File = fopen(Pointer_String_File_Name, "w");
+	if (Pointer_File == NULL) return -1;
+	
+	fprintf(Pointer_File, "{\"traceEvents\":[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"thermistor-calculator\"}}");
+	
+	// Each ring buffer is a trace row, use its index as the thread identifier
+	pthread_mutex_lock(&Trace_Mutex);
+	for (i = 0; i < Trace_Rings_Count; i++)
+	{
+		fprintf(Pointer_File, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}", i, Trace_Pointer_Rings[i]->String_Name);
+		fprintf(Pointer_File, ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"sort_index\":%u}}", i, i);
+		
+		// Only the last spans are left in a full ring buffer
+		First_Record_Index = 0;
+		if (Trace_Pointer_Rings[i]->Records_Count > TRACE_RING_SPANS_COUNT)
+		{
+			First_Record_Index = Trace_Pointer_Rings[i]->Records_Count - TRACE_RING_SPANS_COUNT;
+			Dropped_Records_Count += First_Record_Index;
+		}
+		for (j = First_Record_Index; j < Trace_Pointer_Rings[i]->Records_Count; j++)
+		{
+			Pointer_Record = &Trace_Pointer_Rings[i]->Records[j & (TRACE_RING_SPANS_COUNT - 1)];
+			// The trace event times are in microseconds
+			fprintf(Pointer_File, ",\n{\"name\":\"%s\",\"cat\":\"pipeline\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", Trace_Pointer_Strings_Span_Names[Pointer_Record->Span], i, Pointer_Record->Start_Time / 1e3, (Pointer_Record->End_Time - Pointer_Record->Start_Time) / 1e3);
+		}
+	}
+	fprintf(Pointer_File, "\n],\n\"displayTimeUnit\":\"ms\",\n\"otherData\":{\"dropped_spans\":%llu,\"untraced_threads\":%u}}\n", Dropped_Records_Count, Trace_Untraced_Threads_Count);
+	pthread_mutex_unlock(&Trace_Mutex);
+	
+	Result = ferror(Pointer_File) ? -1 : 0;
+	if (fclose(Pointer_File) != 0) Result = -1;
+	return Result;
+}
@@ -0,0 +1,55 @@
+/** @file Trace.h
+ * Record what each thread is doing (computing, formatting, writing or waiting) to per-thread ring buffers, and export the spans in the Chrome trace event format.
+ * The recording functions do nothing until the trace is initialized, so they can stay in the hot paths.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_TRACE_H
+#define H_TRACE_H
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** What a thread is doing during a span. */
+typedef enum
+{
+	TRACE_SPAN_COMPUTE, //!< Computing values.
+	TRACE_SPAN_FORMAT, //!< Converting values to text.
+	TRACE_SPAN_WRITE, //!< Writing data to a file or to the standard output.
+	TRACE_SPAN_WAIT, //!< Waiting for other threads, for free buffers or for the input.
+	TRACE_SPANS_COUNT
+} TTraceSpan;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Allocate the ring buffers and start recording. The calling thread spans are recorded under the "Main" name.
+ * @return 0 on success,
+ * @return -1 if the memory could not be allocated.
+ */
+int TraceInitialize(void);
+
+/** Record the calling thread spans under a name. The threads of the same name are numbered, and a thread that exited leaves its ring buffer to the next thread of the same name, so the pools created again and again keep the same trace rows.
+ * Nothing is done if the trace is not initialized or if the calling thread has already a name.
+ * @param Pointer_String_Name The thread name.
+ */
+void TraceNameThread(const char *Pointer_String_Name);
+
+/** Get the current time to start a span.
+ * @return The time in nanoseconds from the trace initialization, or 0 if the trace is not initialized.
+ */
+unsigned long long TraceGetTime(void);
+
+/** Record a span of the calling thread, ending now. Nothing is done if the calling thread has no name. When a thread ring buffer is full, the oldest spans are overwritten.
+ * @param Span What the thread was doing.
+ * @param Start_Time The span start time, returned by TraceGetTime().
+ */
+void TraceRecordSpan(TTraceSpan Span, unsigned long long Start_Time);
+
+/** Write all recorded spans to a Chrome trace event JSON file, it can be opened with chrome://tracing or Perfetto. Call this function when all named threads have exited, except the main one.
+ * @param Pointer_String_File_Name The file to create.
+ * @return 0 on success,
+ * @return -1 if the file could not be written.
+ */
+int TraceWrite(const char *Pointer_String_File_Name);
+
+#endif